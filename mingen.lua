@@ -144,6 +144,37 @@ end
 
 projects_to_generate = {vkb}
 
+-- Microbenchmarks of engine systems, built from the sources they exercise.
+-- bench_scalar forces the portable math fallback, to compare against SIMD.
+local bench_variants = {
+	{name = 'bench', defines = {}},
+	{name = 'bench_scalar', defines = {'-D"VKB_MATH_SCALAR"'}},
+}
+for _, variant in ipairs(bench_variants) do
+	local bench = mg.project({
+		name = variant.name,
+		type = mg.project_type.executable,
+		sources = {
+			'src/bench/**.cc',
+			'src/vkb/log.cc',
+			'src/vkb/core/**.cc',
+			'src/vkb/math/**.cc',
+			'src/vkb/mesh/**.cc',
+			'src/vkb/scene/**.cc',
+		},
+		includes = {'src/'},
+		external_includes = ext_include_dirs,
+		compile_options = merge('-g', '-std=c++20', '-Wall', '-Wextra', '-Werror', '-nostdinc++', platform_define, variant.defines, platform_compile_options),
+		link_options = merge(platform_link_options, '-g'),
+		dependencies = merge(mincore.project),
+		release = {
+			compile_options = {'-O2'}
+		}
+	})
+	remove_platform_sources(bench)
+	table.insert(projects_to_generate, bench)
+end
+
 if (mg.platform() ~= 'mac') then
 	slang = require('deps/slang')
 	local slangrc = mg.project({
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <vkb/core/time.hh>
+#include <vkb/math/random.hh>
+
+#include <stdint.h>
+
+namespace vkb::bench
+{
+	// Best time in milliseconds of `runs` calls to `fn`, after a warm up call
+	template <typename F>
+	double measure(uint32_t runs, F&& fn)
+	{
+		fn();
+
+		double best {0.0};
+		for (uint32_t i {0}; i < runs; ++i)
+		{
+			time::stamp start = time::now();
+			fn();
+			double elapsed = time::elapsed_ms(start, time::now());
+			if (i == 0 || elapsed < best)
+				best = elapsed;
+		}
+
+		return best;
+	}
+
+	// Generator of the data a benchmark runs on, seeded the same for every run
+	inline math::rng data_rng()
+	{
+		return math::rng {42};
+	}
+
+	// Keeps the compiler from discarding a result
+	template <typename T>
+	void keep(T const& value)
+	{
+		asm volatile("" : : "r,m"(value) : "memory");
+	}
+
+	void cull();
+	void scene_store();
+	// Index reordering passes of the asset pipeline, on procedural spheres
+	void mesh_optimize();
+	// Writes the results as JSON to `json_path` when not null
+	void math(char const* json_path);
+}
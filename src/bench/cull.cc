@@ -0,0 +1,111 @@
+#include "bench.hh"
+
+#include <vkb/math/mat4.hh>
+#include <vkb/math/trig.hh>
+#include <vkb/scene/cull.hh>
+
+#include <vector.hh>
+
+#include <stdio.h>
+
+namespace vkb::bench
+{
+	namespace
+	{
+		// Reference array of structures loop, one object at a time
+		struct sphere
+		{
+			float x, y, z, radius;
+		};
+
+		uint32_t cull_aos(scene::frustum const& f, mc::vector<sphere> const& spheres,
+		                  uint32_t* visible)
+		{
+			uint32_t cnt {0};
+			for (uint32_t i {0}; i < spheres.size(); ++i)
+			{
+				sphere const& s = spheres[i];
+				bool          in {true};
+				for (uint32_t p {0}; p < 6 && in; ++p)
+				{
+					float const* pl = f.planes[p];
+					in = pl[0] * s.x + pl[1] * s.y + pl[2] * s.z + pl[3] >= -s.radius;
+				}
+				if (in)
+					visible[cnt++] = i;
+			}
+
+			return cnt;
+		}
+	}
+
+	void cull()
+	{
+		constexpr uint32_t counts[] {10'000, 100'000, 1'000'000};
+		constexpr uint32_t runs {20};
+
+		math::rng rng = data_rng();
+
+		// Camera at the origin looking down +y over a cube of objects around it
+		mat4 proj = mat4::persp_proj(0.1f, 400.f, 16.f / 9.f, rad(70.f));
+		scene::frustum const f = scene::extract_frustum(proj);
+
+		printf("%-10s %10s %12s %12s %12s\n", "cull", "objects", "visible", "ms",
+		       "ns/object");
+
+		for (uint32_t count : counts)
+		{
+			mc::vector<sphere> aos;
+			mc::vector<float>  x, y, z, radius, ex, ey, ez;
+			aos.reserve(count);
+			for (uint32_t i {0}; i < count; ++i)
+			{
+				sphere s {rng.next_float(-500.f, 500.f), rng.next_float(-500.f, 500.f),
+				          rng.next_float(-500.f, 500.f), rng.next_float(0.5f, 4.f)};
+				aos.emplace_back(s);
+				x.emplace_back(s.x);
+				y.emplace_back(s.y);
+				z.emplace_back(s.z);
+				radius.emplace_back(s.radius);
+				ex.emplace_back(s.radius);
+				ey.emplace_back(s.radius * 0.5f);
+				ez.emplace_back(s.radius * 2.f);
+			}
+
+			scene::sphere_soa spheres {x.data(), y.data(), z.data(), radius.data()};
+			scene::aabb_soa   aabbs {x.data(),  y.data(),  z.data(),
+			                         ex.data(), ey.data(), ez.data()};
+
+			mc::vector<uint32_t> visible;
+			visible.resize(count);
+			uint32_t visible_cnt {0};
+
+			auto report = [count, &visible_cnt](char const* name, double ms)
+			{
+				printf("%-10s %10u %12u %12.3f %12.3f\n", name, count, visible_cnt, ms,
+				       ms * 1'000'000.0 / count);
+			};
+
+			auto run_aos = [&]()
+			{
+				visible_cnt = cull_aos(f, aos, visible.data());
+			};
+			auto run_spheres = [&]()
+			{
+				scene::cull_spheres(f, spheres, count, visible);
+				visible_cnt = visible.size();
+			};
+			auto run_aabbs = [&]()
+			{
+				scene::cull_aabbs(f, aabbs, count, visible);
+				visible_cnt = visible.size();
+			};
+
+			report("aos", measure(runs, run_aos));
+			report("spheres", measure(runs, run_spheres));
+			report("aabbs", measure(runs, run_aabbs));
+
+			keep(visible_cnt);
+		}
+	}
+}
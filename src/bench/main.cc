@@ -0,0 +1,38 @@
+#include "bench.hh"
+
+#include <vkb/core/jobs.hh>
+
+#include <string.h>
+
+// Usage: bench [cull|scene|mesh|math] [--json <path>]
+// Runs every suite when none is given, --json writes the math results
+int main(int argc, char** argv)
+{
+	char const* suite {nullptr};
+	char const* json_path {nullptr};
+	for (int i {1}; i < argc; ++i)
+	{
+		if (!strcmp(argv[i], "--json") && i + 1 < argc)
+			json_path = argv[++i];
+		else
+			suite = argv[i];
+	}
+
+	auto selected = [suite](char const* name)
+	{
+		return !suite || !strcmp(suite, name);
+	};
+
+	vkb::jobs::scheduler scheduler;
+
+	if (selected("cull"))
+		vkb::bench::cull();
+	if (selected("scene"))
+		vkb::bench::scene_store();
+	if (selected("mesh"))
+		vkb::bench::mesh_optimize();
+	if (selected("math"))
+		vkb::bench::math(json_path);
+
+	return 0;
+}
@@ -0,0 +1,390 @@
+#include "bench.hh"
+
+#include <vkb/math/batch.hh>
+#include <vkb/math/mat4.hh>
+#include <vkb/math/quat.hh>
+#include <vkb/math/random.hh>
+#include <vkb/math/trig.hh>
+#include <vkb/math/vec4.hh>
+#include <vkb/math/xform.hh>
+
+#include <vector.hh>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+namespace vkb::bench
+{
+	namespace
+	{
+		// Elements per pass, small enough for the working set to stay in cache so that
+		// arithmetic is measured rather than memory bandwidth
+		constexpr uint32_t count {4096};
+		constexpr uint32_t passes {64};
+		constexpr uint32_t runs {10};
+
+		struct result
+		{
+			char const* name;
+			double      ns_per_op;
+		};
+
+		char const* backend()
+		{
+#if defined(VKB_SIMD_SSE) && defined(__FMA__)
+			return "sse+fma";
+#elif defined(VKB_SIMD_SSE)
+			return "sse";
+#elif defined(VKB_SIMD_NEON)
+			return "neon";
+#else
+			return "scalar";
+#endif
+		}
+
+		// Times `passes` calls to `fn`, each doing `count` operations
+		template <typename F>
+		void run(char const* name, F&& fn, mc::vector<result>& results)
+		{
+			auto pass = [&fn]()
+			{
+				for (uint32_t p {0}; p < passes; ++p)
+					fn();
+			};
+
+			double ms = measure(runs, pass);
+			double ns = ms * 1'000'000.0 / (count * passes);
+
+			printf("%-20s %10s %12.3f %12.1f\n", name, backend(), ns, 1'000.0 / ns);
+			results.emplace_back(result {name, ns});
+		}
+
+		bool write_json(char const* path, mc::vector<result> const& results)
+		{
+			FILE* file = fopen(path, "w");
+			if (!file)
+			{
+				fprintf(stderr, "Failed to open %s\n", path);
+				return false;
+			}
+
+			fprintf(file, "{\n\t\"backend\": \"%s\",\n\t\"results\": [\n", backend());
+			for (uint32_t i {0}; i < results.size(); ++i)
+			{
+				result const& res = results[i];
+				fprintf(file,
+				        "\t\t{\"name\": \"%s\", \"ns_per_op\": %.4f, \"mops\": %.2f}%s\n",
+				        res.name, res.ns_per_op, 1'000.0 / res.ns_per_op,
+				        i + 1 < results.size() ? "," : "");
+			}
+			fprintf(file, "\t]\n}\n");
+			fclose(file);
+
+			return true;
+		}
+	}
+
+	void math(char const* json_path)
+	{
+		math::rng rng = data_rng();
+
+		mc::vector<vec4>  vecs;
+		mc::vector<vec4>  vecs_b;
+		mc::vector<mat4>  mats;
+		mc::vector<quat>  quats;
+		mc::vector<xform> xforms;
+		mc::vector<float> soa[10];
+		vecs.reserve(count);
+		vecs_b.reserve(count);
+		mats.reserve(count);
+		quats.reserve(count);
+		xforms.reserve(count);
+		for (uint32_t i {0}; i < count; ++i)
+		{
+			vec4 v {rng.next_float(-10.f, 10.f), rng.next_float(-10.f, 10.f),
+			        rng.next_float(-10.f, 10.f), 1.f};
+			vec4 axis = vec4 {rng.next_float(-1.f, 1.f), rng.next_float(-1.f, 1.f),
+			                  rng.next_float(-1.f, 1.f), 0.f}
+			                .norm3();
+			quat q = quat::angle_axis(axis, rng.next_float(0.f, 2.f * pi));
+
+			vecs.emplace_back(v);
+			vecs_b.emplace_back(axis);
+			quats.emplace_back(q);
+			mats.emplace_back(mat4::scale({2.f, 2.f, 2.f, 1.f}) * mat4(q) *
+			                  mat4::translate(v));
+
+			xform& t = xforms.emplace_back();
+			t.rot = q;
+			t.pos()[0] = v.x;
+			t.pos()[1] = v.y;
+			t.pos()[2] = v.z;
+			t.scale() = rng.next_float(0.5f, 2.f);
+
+			// Position, rotation and scale as structures of arrays
+			float const comps[10] {v.x, v.y, v.z, q.w, q.x, q.y, q.z, 1.f, 1.f, 1.f};
+			for (uint32_t c {0}; c < 10; ++c)
+				soa[c].emplace_back(comps[c]);
+		}
+
+		mc::vector<vec4>  vec_out;
+		mc::vector<mat4>  mat_out;
+		mc::vector<quat>  quat_out;
+		mc::vector<xform> xform_out;
+		mc::vector<float> soa_out[6];
+		vec_out.resize(count);
+		mat_out.resize(count);
+		quat_out.resize(count);
+		xform_out.resize(count);
+		for (mc::vector<float>& out : soa_out)
+			out.resize(count);
+
+		mat4 const view_proj = mat4::translate({0.f, 0.f, -5.f, 1.f}) *
+		                       mat4::persp_proj(0.1f, 100.f, 16.f / 9.f, rad(70.f));
+
+		mc::vector<result> results;
+
+		printf("%-20s %10s %12s %12s\n", "math", "backend", "ns/op", "Mop/s");
+
+		run(
+			"vec4_add",
+			[&]()
+			{
+				for (uint32_t i {0}; i < count; ++i)
+					vec_out[i] = vecs[i] + vecs_b[i];
+				keep(vec_out.data());
+			},
+			results);
+		run(
+			"vec4_mul",
+			[&]()
+			{
+				for (uint32_t i {0}; i < count; ++i)
+					vec_out[i] = vecs[i] * vecs_b[i];
+				keep(vec_out.data());
+			},
+			results);
+		run(
+			"vec4_dot3",
+			[&]()
+			{
+				for (uint32_t i {0}; i < count; ++i)
+					vec_out[i].x = vecs[i].dot3(vecs_b[i]);
+				keep(vec_out.data());
+			},
+			results);
+		run(
+			"vec4_cross3",
+			[&]()
+			{
+				for (uint32_t i {0}; i < count; ++i)
+					vec_out[i] = vecs[i].cross3(vecs_b[i]);
+				keep(vec_out.data());
+			},
+			results);
+		run(
+			"vec4_norm3",
+			[&]()
+			{
+				for (uint32_t i {0}; i < count; ++i)
+					vec_out[i] = vecs[i].norm3();
+				keep(vec_out.data());
+			},
+			results);
+		run(
+			"vec4_mul_mat4",
+			[&]()
+			{
+				for (uint32_t i {0}; i < count; ++i)
+					vec_out[i] = vecs[i] * view_proj;
+				keep(vec_out.data());
+			},
+			results);
+		run(
+			"mat4_mul",
+			[&]()
+			{
+				for (uint32_t i {0}; i < count; ++i)
+					mat_out[i] = mats[i] * view_proj;
+				keep(mat_out.data());
+			},
+			results);
+		run(
+			"mat4_transpose",
+			[&]()
+			{
+				for (uint32_t i {0}; i < count; ++i)
+					mat_out[i] = mats[i].transpose();
+				keep(mat_out.data());
+			},
+			results);
+		run(
+			"mat4_persp_proj",
+			[&]()
+			{
+				for (uint32_t i {0}; i < count; ++i)
+					mat_out[i] = mat4::persp_proj(0.1f, 100.f, 1.f + vecs_b[i].x, 1.2f);
+				keep(mat_out.data());
+			},
+			results);
+		run(
+			"quat_mul",
+			[&]()
+			{
+				for (uint32_t i {0}; i < count; ++i)
+					quat_out[i] = quats[i] * quats[count - 1 - i];
+				keep(quat_out.data());
+			},
+			results);
+		run(
+			"quat_rotate",
+			[&]()
+			{
+				for (uint32_t i {0}; i < count; ++i)
+					vec_out[i] = quats[i].rotate(vecs[i]);
+				keep(vec_out.data());
+			},
+			results);
+		run(
+			"quat_to_mat4",
+			[&]()
+			{
+				for (uint32_t i {0}; i < count; ++i)
+					mat_out[i] = quats[i];
+				keep(mat_out.data());
+			},
+			results);
+		run(
+			"quat_slerp",
+			[&]()
+			{
+				for (uint32_t i {0}; i < count; ++i)
+					quat_out[i] = quat::slerp(quats[i], quats[count - 1 - i], .3f);
+				keep(quat_out.data());
+			},
+			results);
+		run(
+			"xform_mul",
+			[&]()
+			{
+				for (uint32_t i {0}; i < count; ++i)
+					xform_out[i] = xforms[i] * xforms[count - 1 - i];
+				keep(xform_out.data());
+			},
+			results);
+		run(
+			"xform_apply",
+			[&]()
+			{
+				for (uint32_t i {0}; i < count; ++i)
+					vec_out[i] = xforms[i].apply(vecs[i]);
+				keep(vec_out.data());
+			},
+			results);
+		run(
+			"xform_to_mat4",
+			[&]()
+			{
+				for (uint32_t i {0}; i < count; ++i)
+					mat_out[i] = xforms[i];
+				keep(mat_out.data());
+			},
+			results);
+
+		// Batch kernels, to compare with the element-wise loops above
+		math::vec3_soa const points {soa[0].data(), soa[1].data(), soa[2].data()};
+		math::vec3_soa const extents {soa[7].data(), soa[8].data(), soa[9].data()};
+		math::vec3_soa_out   points_out {soa_out[0].data(), soa_out[1].data(),
+		                                 soa_out[2].data()};
+		math::vec3_soa_out   extents_out {soa_out[3].data(), soa_out[4].data(),
+		                                  soa_out[5].data()};
+
+		run(
+			"batch_points",
+			[&]()
+			{
+				math::transform_points(view_proj, points, points_out, count);
+				keep(soa_out[0].data());
+			},
+			results);
+		run(
+			"batch_aabbs",
+			[&]()
+			{
+				math::transform_aabbs(view_proj, points, extents, points_out, extents_out,
+				                      count);
+				keep(soa_out[0].data());
+			},
+			results);
+		run(
+			"batch_compose_trs",
+			[&]()
+			{
+				math::compose_trs(points, {soa[3].data(), soa[4].data(), soa[5].data(),
+				                           soa[6].data()},
+				                  extents, mat_out.data(), count);
+				keep(mat_out.data());
+			},
+			results);
+		run(
+			"batch_mat4_mul",
+			[&]()
+			{
+				math::multiply(mats.data(), view_proj, mat_out.data(), count);
+				keep(mat_out.data());
+			},
+			results);
+
+		// Random generation, against the libc generator it replaces
+		math::rng    gen {42};
+		math::rng_x4 gen_x4 {42};
+
+		run(
+			"libc_rand_float",
+			[&]()
+			{
+				for (uint32_t i {0}; i < count; ++i)
+					soa_out[0][i] = ::rand() / static_cast<float>(RAND_MAX);
+				keep(soa_out[0].data());
+			},
+			results);
+		run(
+			"rng_float",
+			[&]()
+			{
+				for (uint32_t i {0}; i < count; ++i)
+					soa_out[0][i] = gen.next_float();
+				keep(soa_out[0].data());
+			},
+			results);
+		run(
+			"rng_x4_float",
+			[&]()
+			{
+				gen_x4.fill_floats(soa_out[0].data(), count, 0.f, 1.f);
+				keep(soa_out[0].data());
+			},
+			results);
+		run(
+			"rng_sphere",
+			[&]()
+			{
+				for (uint32_t i {0}; i < count; ++i)
+					vec_out[i] = gen.sphere_point();
+				keep(vec_out.data());
+			},
+			results);
+		run(
+			"rng_x4_sphere",
+			[&]()
+			{
+				gen_x4.fill_sphere_points(soa_out[0].data(), soa_out[1].data(),
+				                          soa_out[2].data(), count);
+				keep(soa_out[0].data());
+			},
+			results);
+
+		if (json_path && write_json(json_path, results))
+			printf("Wrote %s\n", json_path);
+	}
+}
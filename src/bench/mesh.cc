@@ -0,0 +1,100 @@
+#include "bench.hh"
+
+#include <vkb/math/random.hh>
+#include <vkb/mesh/optimize.hh>
+#include <vkb/mesh/sphere.hh>
+
+#include <vector.hh>
+
+#include <stdio.h>
+
+namespace vkb::bench
+{
+	namespace
+	{
+		struct input
+		{
+			char const*       name;
+			mesh::sphere_mesh mesh;
+		};
+
+		// Triangles in random order, as meshes exported without optimization
+		void shuffle_triangles(mc::vector<uint16_t>& idcs)
+		{
+			math::rng rng = data_rng();
+			for (uint32_t i = idcs.size() / 3; i > 1; --i)
+			{
+				uint32_t j = rng.next_below(i);
+				for (uint32_t k {0}; k < 3; ++k)
+				{
+					uint16_t tmp = idcs[(i - 1) * 3 + k];
+					idcs[(i - 1) * 3 + k] = idcs[j * 3 + k];
+					idcs[j * 3 + k] = tmp;
+				}
+			}
+		}
+	}
+
+	void mesh_optimize()
+	{
+		constexpr uint32_t runs {10};
+
+		input inputs[] {
+			{"ico4", mesh::icosphere(4)},
+			{"ico6", mesh::icosphere(6)},
+			{"ico6 shuf", mesh::icosphere(6)},
+			{"uv 64x128", mesh::uv_sphere(64, 128)},
+			{"uv shuf", mesh::uv_sphere(64, 128)},
+		};
+		shuffle_triangles(inputs[2].mesh.idcs);
+		shuffle_triangles(inputs[4].mesh.idcs);
+
+		printf("%-10s %10s %-10s %8s %8s %12s\n", "mesh", "triangles", "pass", "acmr",
+		       "atvr", "ms");
+
+		for (input& in : inputs)
+		{
+			mesh::sphere_mesh const& m = in.mesh;
+			uint32_t const           vert_count = m.verts.size();
+
+			mc::vector<uint16_t> cache_idcs;
+			mc::vector<uint16_t> overdraw_idcs;
+			mc::vector<uint16_t> fetch_idcs;
+			mc::vector<uint32_t> remap;
+			uint32_t             kept {0};
+
+			auto run_cache = [&]()
+			{
+				mesh::optimize_vertex_cache(m.idcs, vert_count, cache_idcs);
+			};
+			auto run_overdraw = [&]()
+			{
+				mesh::optimize_overdraw(&m.verts[0].x, sizeof(mesh::sphere_vert),
+				                        vert_count, cache_idcs, overdraw_idcs);
+			};
+			auto run_fetch = [&]()
+			{
+				kept = mesh::optimize_vertex_fetch(overdraw_idcs, vert_count, fetch_idcs,
+				                                   remap);
+			};
+
+			auto report = [&](char const* pass, mc::vector<uint16_t> const& idcs,
+			                  uint32_t verts, double ms)
+			{
+				mesh::cache_stats stats = mesh::analyze_vertex_cache(idcs, verts);
+				printf("%-10s %10u %-10s %8.3f %8.3f %12.3f\n", in.name, idcs.size() / 3,
+				       pass, stats.acmr, stats.atvr, ms);
+			};
+
+			report("input", m.idcs, vert_count, 0.0);
+			double ms = measure(runs, run_cache);
+			report("cache", cache_idcs, vert_count, ms);
+			ms = measure(runs, run_overdraw);
+			report("overdraw", overdraw_idcs, vert_count, ms);
+			ms = measure(runs, run_fetch);
+			report("fetch", fetch_idcs, kept, ms);
+
+			keep(kept);
+		}
+	}
+}
@@ -0,0 +1,125 @@
+#include "bench.hh"
+
+#include <vkb/math/mat4.hh>
+#include <vkb/math/trig.hh>
+#include <vkb/scene/store.hh>
+
+#include <vector.hh>
+
+#include <math.h>
+#include <stdio.h>
+
+namespace vkb::bench
+{
+	namespace
+	{
+		// Layout of the former vk::object, everything of an object in one struct
+		struct aos_object
+		{
+			vec4   pos {0.f, 0.f, 0.f, 1.f};
+			vec4   scale {1.f, 1.f, 1.f, 1.f};
+			mat4   trs;
+			vec4   rot_axis {0.f, 0.f, 1.f, 1.f};
+			double rot {0.0};
+			float  rot_speed {1.0f};
+			void*  desc_sets[3] {nullptr};
+			void*  model {nullptr};
+			void*  tex {nullptr};
+			float  radius {1.f};
+		};
+	}
+
+	void scene_store()
+	{
+		constexpr uint32_t counts[] {10'000, 100'000, 1'000'000};
+		constexpr uint32_t runs {10};
+		constexpr double   dt {1.0 / 60.0};
+
+		math::rng rng = data_rng();
+
+		mat4 proj = mat4::persp_proj(0.1f, 400.f, 16.f / 9.f, rad(70.f));
+		scene::frustum const f = scene::extract_frustum(proj);
+
+		printf("%-10s %10s %12s %12s\n", "scene", "objects", "ms", "ns/object");
+
+		for (uint32_t count : counts)
+		{
+			mc::vector<aos_object> aos;
+			scene::store           soa;
+			scene::store           static_soa;
+			aos.reserve(count);
+			for (uint32_t i {0}; i < count; ++i)
+			{
+				scene::object_desc desc {};
+				desc.pos = {rng.next_float(-500.f, 500.f), rng.next_float(-500.f, 500.f),
+				            rng.next_float(-500.f, 500.f), 1.f};
+				float rot_speed = rng.next_float(0.f, 2.f);
+				desc.rot_speed = rot_speed;
+				desc.radius = rng.next_float(0.5f, 4.f);
+				soa.create(desc);
+
+				desc.rot_speed = 0.f;
+				static_soa.create(desc);
+
+				aos_object& obj = aos.emplace_back();
+				obj.pos = desc.pos;
+				obj.rot_speed = rot_speed;
+				obj.radius = desc.radius;
+			}
+
+			mc::vector<uint32_t> visible;
+			visible.resize(count);
+
+			// Update then cull, each pass walking every object
+			auto run_aos = [&]()
+			{
+				for (aos_object& obj : aos)
+				{
+					obj.rot = fmod(obj.rot + (dt * obj.rot_speed), pi * 2.0);
+					obj.trs = mat4::scale(obj.scale) *
+					          mat4::rotate(obj.rot_axis, obj.rot) *
+					          mat4::translate(obj.pos);
+				}
+
+				uint32_t cnt {0};
+				for (uint32_t i {0}; i < aos.size(); ++i)
+				{
+					aos_object const& obj = aos[i];
+					bool              in {true};
+					for (uint32_t p {0}; p < 6 && in; ++p)
+					{
+						float const* pl = f.planes[p];
+						in = pl[0] * obj.pos.x + pl[1] * obj.pos.y + pl[2] * obj.pos.z +
+						         pl[3] >=
+						     -obj.radius;
+					}
+					if (in)
+						visible[cnt++] = i;
+				}
+				keep(cnt);
+			};
+			auto run_soa = [&]()
+			{
+				soa.update(dt);
+				soa.cull(f, visible);
+				keep(visible.size());
+			};
+			auto run_static = [&]()
+			{
+				static_soa.update(dt);
+				static_soa.cull(f, visible);
+				keep(visible.size());
+			};
+
+			double ms = measure(runs, run_aos);
+			printf("%-10s %10u %12.3f %12.3f\n", "aos", count, ms,
+			       ms * 1'000'000.0 / count);
+			ms = measure(runs, run_soa);
+			printf("%-10s %10u %12.3f %12.3f\n", "store", count, ms,
+			       ms * 1'000'000.0 / count);
+			ms = measure(runs, run_static);
+			printf("%-10s %10u %12.3f %12.3f\n", "static", count, ms,
+			       ms * 1'000'000.0 / count);
+		}
+	}
+}
@@ -0,0 +1,169 @@
+#include "async.hh"
+
+#include "../log.hh"
+
+#include <stdint.h>
+#include <stdio.h>
+
+namespace vkb::async
+{
+	namespace
+	{
+		loop main_thread_loop;
+		loop render_thread_loop;
+	}
+
+	namespace detail
+	{
+		void promise_base::unhandled_exception()
+		{
+			log::error("Unhandled exception in async task");
+		}
+	}
+
+	void loop::enqueue(detail::waiter* w)
+	{
+		w->next = __atomic_load_n(&incoming_, __ATOMIC_RELAXED);
+		while (!__atomic_compare_exchange_n(&incoming_, &w->next, w, true,
+		                                    __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+			;
+	}
+
+	void loop::poll()
+	{
+		detail::waiter* w = __atomic_exchange_n(&incoming_, nullptr, __ATOMIC_ACQUIRE);
+
+		// Back to registration order
+		detail::waiter* ordered {nullptr};
+		while (w)
+		{
+			detail::waiter* next = w->next;
+			w->next = ordered;
+			ordered = w;
+			w = next;
+		}
+
+		*pending_tail_ = ordered;
+		while (*pending_tail_)
+			pending_tail_ = &(*pending_tail_)->next;
+
+		// Resumed coroutines register their next waiters in incoming, checked by the
+		// next poll
+		detail::waiter** link = &pending_;
+		while (*link)
+		{
+			w = *link;
+			if (w->ready && !w->ready(w->data))
+			{
+				link = &w->next;
+				continue;
+			}
+
+			*link = w->next;
+			if (pending_tail_ == &w->next)
+				pending_tail_ = link;
+			// Frees w along with the coroutine frame when it completes
+			w->coro.resume();
+		}
+	}
+
+	loop& main_loop()
+	{
+		return main_thread_loop;
+	}
+
+	loop& render_loop()
+	{
+		return render_thread_loop;
+	}
+
+	void poll()
+	{
+		main_thread_loop.poll();
+	}
+
+	bool resume_on_worker::await_ready() const
+	{
+		return !jobs::scheduler::exists() || !jobs::scheduler::get().worker_count() ||
+		       jobs::scheduler::get().on_worker();
+	}
+
+	void resume_on_worker::await_suspend(std::coroutine_handle<> coro)
+	{
+		job_.fn = [](void* data)
+		{
+			std::coroutine_handle<>::from_address(data).resume();
+		};
+		job_.data = coro.address();
+		job_.cnt = nullptr;
+		jobs::scheduler::get().run(&job_, 1);
+	}
+
+	resume_on::resume_on(loop& l)
+	: loop_ {l}
+	{}
+
+	void resume_on::await_suspend(std::coroutine_handle<> coro)
+	{
+		waiter_.coro = coro;
+		loop_.enqueue(&waiter_);
+	}
+
+	resume_on_main::resume_on_main()
+	: resume_on {main_thread_loop}
+	{}
+
+	resume_on_render::resume_on_render()
+	: resume_on {render_thread_loop}
+	{}
+
+	until::until(bool (*ready)(void* data), void* data, loop& l)
+	: loop_ {l}
+	{
+		waiter_.ready = ready;
+		waiter_.data = data;
+	}
+
+	bool until::await_ready() const
+	{
+		return waiter_.ready(waiter_.data);
+	}
+
+	void until::await_suspend(std::coroutine_handle<> coro)
+	{
+		waiter_.coro = coro;
+		loop_.enqueue(&waiter_);
+	}
+
+	task<mc::vector<uint8_t>> read_file(mc::string path)
+	{
+		co_await resume_on_worker();
+
+		mc::vector<uint8_t> data;
+
+		FILE* file = fopen(path.data(), "rb");
+		if (!file)
+		{
+			log::error("Failed to open %s", path.data());
+			co_return data;
+		}
+
+		fseek(file, 0, SEEK_END);
+		long const size = ftell(file);
+		fseek(file, 0, SEEK_SET);
+
+		if (size > 0)
+		{
+			data.resize(size);
+			if (fread(data.data(), 1, size, file) != static_cast<size_t>(size))
+			{
+				log::error("Failed to read %s", path.data());
+				data.clear();
+			}
+		}
+
+		fclose(file);
+
+		co_return data;
+	}
+}
@@ -0,0 +1,276 @@
+#pragma once
+
+#include "coroutine.hh"
+#include "jobs.hh"
+
+#include <string.hh>
+#include <vector.hh>
+
+#include <stdint.h>
+
+namespace vkb::async
+{
+	namespace detail
+	{
+		// Coroutine suspended until ready returns true, checked by poll
+		struct waiter
+		{
+			waiter*                 next {nullptr};
+			std::coroutine_handle<> coro;
+			bool (*ready)(void* data) {nullptr};
+			void* data {nullptr};
+		};
+
+		struct promise_base
+		{
+			struct final_awaiter
+			{
+				bool await_ready() const noexcept
+				{
+					return false;
+				}
+
+				template <typename P>
+				std::coroutine_handle<> await_suspend(std::coroutine_handle<P> h) noexcept
+				{
+					promise_base& promise = h.promise();
+					if (promise.detached)
+					{
+						h.destroy();
+						return std::noop_coroutine();
+					}
+
+					return promise.continuation ? promise.continuation
+					                            : std::noop_coroutine();
+				}
+
+				void await_resume() const noexcept {}
+			};
+
+			// Tasks only start once awaited or started
+			std::suspend_always initial_suspend() const noexcept
+			{
+				return {};
+			}
+
+			final_awaiter final_suspend() const noexcept
+			{
+				return {};
+			}
+
+			void unhandled_exception();
+
+			std::coroutine_handle<> continuation;
+			// Frame destroys itself on completion, nothing awaits it
+			bool detached {false};
+		};
+
+		template <typename T>
+		struct result
+		{
+			void return_value(T val)
+			{
+				value = static_cast<T&&>(val);
+			}
+
+			T take()
+			{
+				return static_cast<T&&>(value);
+			}
+
+			T value {};
+		};
+
+		template <>
+		struct result<void>
+		{
+			void return_void() {}
+			void take() {}
+		};
+	}
+
+	// Lazily started coroutine. Awaiting a task runs it until its first suspension,
+	// then resumes the awaiting coroutine on the thread the task completed on, with
+	// its result. Long loading chains are then written linearly, hopping between
+	// threads with the awaitables below instead of blocking them.
+	template <typename T = void>
+	class task
+	{
+	public:
+		struct promise_type
+		: detail::promise_base
+		, detail::result<T>
+		{
+			task get_return_object()
+			{
+				return task {std::coroutine_handle<promise_type>::from_promise(*this)};
+			}
+		};
+
+		task(task const&) = delete;
+		task(task&& other)
+		: coro_ {other.coro_}
+		{
+			other.coro_ = nullptr;
+		}
+
+		~task()
+		{
+			if (coro_)
+				coro_.destroy();
+		}
+
+		task& operator=(task const&) = delete;
+		task& operator=(task&& other)
+		{
+			if (this != &other)
+			{
+				if (coro_)
+					coro_.destroy();
+				coro_ = other.coro_;
+				other.coro_ = nullptr;
+			}
+			return *this;
+		}
+
+		bool done() const
+		{
+			return !coro_ || coro_.done();
+		}
+
+		bool await_ready() const
+		{
+			return false;
+		}
+
+		std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting)
+		{
+			coro_.promise().continuation = awaiting;
+			return coro_;
+		}
+
+		T await_resume()
+		{
+			return coro_.promise().take();
+		}
+
+	private:
+		template <typename U>
+		friend void start(task<U>&& t);
+
+		explicit task(std::coroutine_handle<promise_type> coro)
+		: coro_ {coro}
+		{}
+
+		std::coroutine_handle<promise_type> coro_;
+	};
+
+	// Runs the task on the calling thread until its first suspension, without anything
+	// awaiting it. Its frame is freed once it completes, along with its result.
+	template <typename T>
+	void start(task<T>&& t)
+	{
+		std::coroutine_handle<typename task<T>::promise_type> coro = t.coro_;
+		t.coro_ = nullptr;
+
+		coro.promise().detached = true;
+		coro.resume();
+	}
+
+	// Coroutines waiting to be resumed by the thread which polls the loop. Waiters are
+	// registered from any thread.
+	class loop
+	{
+	public:
+		loop() = default;
+		loop(loop const&) = delete;
+		loop(loop&&) = delete;
+
+		loop& operator=(loop const&) = delete;
+		loop& operator=(loop&&) = delete;
+
+		void enqueue(detail::waiter* w);
+		// Resumes the waiters which are ready. Always called from the same thread.
+		void poll();
+
+	private:
+		// Waiters registered since the last poll, most recent first
+		detail::waiter* incoming_ {nullptr};
+		// Waiters checked by poll, only touched by the polling thread
+		detail::waiter*  pending_ {nullptr};
+		detail::waiter** pending_tail_ {&pending_};
+	};
+
+	// Polled by the main thread once per frame
+	loop& main_loop();
+	// Polled by the render thread at the start of each frame, where GPU work is
+	// recorded (see frame_pipeline)
+	loop& render_loop();
+
+	// Resumes coroutines waiting on the main thread
+	void poll();
+
+	// Resumes the awaiting coroutine on a worker thread, inline when already on one
+	// or without workers
+	class resume_on_worker
+	{
+	public:
+		bool await_ready() const;
+		void await_suspend(std::coroutine_handle<> coro);
+		void await_resume() const {}
+
+	private:
+		jobs::job job_;
+	};
+
+	// Resumes the awaiting coroutine on the thread polling `l`, during its next poll
+	class resume_on
+	{
+	public:
+		resume_on(loop& l);
+
+		bool await_ready() const
+		{
+			return false;
+		}
+		void await_suspend(std::coroutine_handle<> coro);
+		void await_resume() const {}
+
+	private:
+		loop&          loop_;
+		detail::waiter waiter_;
+	};
+
+	class resume_on_main : public resume_on
+	{
+	public:
+		resume_on_main();
+	};
+
+	class resume_on_render : public resume_on
+	{
+	public:
+		resume_on_render();
+	};
+
+	// Suspends the awaiting coroutine until ready(data) returns true, checked by the
+	// thread polling `l`, which then resumes it. Used to wait on completions which can
+	// only be queried (fences, timeline semaphores).
+	class until
+	{
+	public:
+		until(bool (*ready)(void* data), void* data, loop& l = main_loop());
+
+		bool await_ready() const;
+		void await_suspend(std::coroutine_handle<> coro);
+		void await_resume() const {}
+
+	private:
+		loop&          loop_;
+		detail::waiter waiter_;
+	};
+
+	// Reads a whole file on a worker, empty on failure. The caller resumes on that
+	// worker.
+	task<mc::vector<uint8_t>> read_file(mc::string path);
+}
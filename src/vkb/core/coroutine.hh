@@ -0,0 +1,126 @@
+#pragma once
+
+// Subset of <coroutine>, which isn't available without the C++ standard library.
+// The compiler looks these names up in std when transforming a coroutine.
+namespace std
+{
+	template <typename R, typename... Args>
+	struct coroutine_traits
+	{
+		using promise_type = typename R::promise_type;
+	};
+
+	template <typename P = void>
+	struct coroutine_handle;
+
+	template <>
+	struct coroutine_handle<void>
+	{
+		constexpr coroutine_handle() = default;
+		constexpr coroutine_handle(decltype(nullptr)) {}
+
+		static coroutine_handle from_address(void* addr)
+		{
+			coroutine_handle h;
+			h.frame_ = addr;
+			return h;
+		}
+
+		void* address() const
+		{
+			return frame_;
+		}
+
+		explicit operator bool() const
+		{
+			return frame_;
+		}
+
+		bool done() const
+		{
+			return __builtin_coro_done(frame_);
+		}
+
+		void operator()() const
+		{
+			resume();
+		}
+
+		void resume() const
+		{
+			__builtin_coro_resume(frame_);
+		}
+
+		void destroy() const
+		{
+			__builtin_coro_destroy(frame_);
+		}
+
+	protected:
+		void* frame_ {nullptr};
+	};
+
+	template <typename P>
+	struct coroutine_handle : coroutine_handle<>
+	{
+		constexpr coroutine_handle() = default;
+		constexpr coroutine_handle(decltype(nullptr)) {}
+
+		static coroutine_handle from_address(void* addr)
+		{
+			coroutine_handle h;
+			h.frame_ = addr;
+			return h;
+		}
+
+		static coroutine_handle from_promise(P& promise)
+		{
+			coroutine_handle h;
+			h.frame_ = __builtin_coro_promise(&promise, alignof(P), true);
+			return h;
+		}
+
+		P& promise() const
+		{
+			return *static_cast<P*>(__builtin_coro_promise(frame_, alignof(P), false));
+		}
+	};
+
+	struct suspend_always
+	{
+		constexpr bool await_ready() const noexcept
+		{
+			return false;
+		}
+		constexpr void await_suspend(coroutine_handle<>) const noexcept {}
+		constexpr void await_resume() const noexcept {}
+	};
+
+	struct suspend_never
+	{
+		constexpr bool await_ready() const noexcept
+		{
+			return true;
+		}
+		constexpr void await_suspend(coroutine_handle<>) const noexcept {}
+		constexpr void await_resume() const noexcept {}
+	};
+
+	// Handle whose resumption does nothing, target of symmetric transfers which have
+	// nothing to resume
+	inline coroutine_handle<> noop_coroutine()
+	{
+#if __has_builtin(__builtin_coro_noop)
+		return coroutine_handle<>::from_address(__builtin_coro_noop());
+#else
+		// Frames start with their resume and destroy functions
+		struct noop_frame
+		{
+			void (*resume)(noop_frame*);
+			void (*destroy)(noop_frame*);
+		};
+		static noop_frame frame {[](noop_frame*) {}, [](noop_frame*) {}};
+		return coroutine_handle<>::from_address(&frame);
+#endif
+	}
+}
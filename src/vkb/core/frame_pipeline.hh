@@ -0,0 +1,101 @@
+#pragma once
+
+#include "spsc_queue.hh"
+#include "thread.hh"
+
+#include <stdint.h>
+
+namespace vkb
+{
+	// Renders frame N on a dedicated thread while the calling thread simulates frame
+	// N + 1. Frames are double buffered snapshots of everything rendering reads:
+	// the simulation fills one while the render thread consumes the other, and their
+	// indices go back and forth through two SPSC queues.
+	// While the pipeline runs, GPU work may only be recorded from the render callback,
+	// including by the coroutines of async::render_loop, which it polls. Graphics
+	// instances check it (see vk::instance::set_owner_thread).
+	template <typename T>
+	class frame_pipeline
+	{
+	public:
+		using render_fn = void (*)(T const& frame, void* user);
+
+		frame_pipeline(render_fn fn, void* user)
+		: fn_ {fn}
+		, user_ {user}
+		{
+			free_.push(0);
+			free_.push(1);
+			thread_ = thread::start(render_main, this);
+		}
+
+		frame_pipeline(frame_pipeline const&) = delete;
+		frame_pipeline(frame_pipeline&&) = delete;
+
+		// Renders submitted frames before returning
+		~frame_pipeline()
+		{
+			__atomic_store_n(&stop_, true, __ATOMIC_RELEASE);
+			ready_sem_.signal();
+			thread::join(thread_);
+		}
+
+		frame_pipeline& operator=(frame_pipeline const&) = delete;
+		frame_pipeline& operator=(frame_pipeline&&) = delete;
+
+		// Frame to fill, waits while the render thread still uses both
+		T& begin_frame()
+		{
+			while (!free_.pop(current_))
+				free_sem_.wait();
+
+			return frames_[current_];
+		}
+
+		// Hands the frame returned by begin_frame over to the render thread
+		void submit()
+		{
+			ready_.push(current_);
+			ready_sem_.signal();
+		}
+
+	private:
+		static void render_main(void* arg)
+		{
+			frame_pipeline& pipe = *static_cast<frame_pipeline*>(arg);
+
+			while (true)
+			{
+				pipe.ready_sem_.wait();
+
+				uint32_t idx;
+				if (!pipe.ready_.pop(idx))
+				{
+					if (__atomic_load_n(&pipe.stop_, __ATOMIC_ACQUIRE))
+						break;
+					continue;
+				}
+
+				pipe.fn_(pipe.frames_[idx], pipe.user_);
+
+				pipe.free_.push(idx);
+				pipe.free_sem_.signal();
+			}
+		}
+
+		render_fn fn_;
+		void*     user_;
+
+		T        frames_[2];
+		uint32_t current_ {0};
+
+		// Simulation to render, and back once rendered
+		spsc_queue<uint32_t, 2> ready_;
+		spsc_queue<uint32_t, 2> free_;
+		thread::semaphore       ready_sem_;
+		thread::semaphore       free_sem_;
+
+		thread::native thread_;
+		bool           stop_ {false};
+	};
+}
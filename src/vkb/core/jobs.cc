@@ -0,0 +1,292 @@
+#include "jobs.hh"
+
+#include "../log.hh"
+
+#include <stdint.h>
+
+namespace vkb::jobs
+{
+	namespace
+	{
+		// Index of the deque owned by the current thread
+		thread_local uint32_t local_idx {UINT32_MAX};
+	}
+
+	// Chase-Lev deque over a fixed ring ("Correct and Efficient Work-Stealing for
+	// Weak Memory Models", Lê et al. 2013). Only the owner pushes and pops, at the
+	// bottom; any thread steals from the top.
+	class work_deque
+	{
+	public:
+		constexpr static int64_t capacity {4096};
+
+		bool push(job* j)
+		{
+			int64_t b = __atomic_load_n(&bottom_, __ATOMIC_RELAXED);
+			int64_t t = __atomic_load_n(&top_, __ATOMIC_ACQUIRE);
+			if (b - t >= capacity)
+				return false;
+
+			__atomic_store_n(&slots_[b & (capacity - 1)], j, __ATOMIC_RELAXED);
+			__atomic_thread_fence(__ATOMIC_RELEASE);
+			__atomic_store_n(&bottom_, b + 1, __ATOMIC_RELAXED);
+
+			return true;
+		}
+
+		job* pop()
+		{
+			int64_t b = __atomic_load_n(&bottom_, __ATOMIC_RELAXED) - 1;
+			__atomic_store_n(&bottom_, b, __ATOMIC_RELAXED);
+			__atomic_thread_fence(__ATOMIC_SEQ_CST);
+			int64_t t = __atomic_load_n(&top_, __ATOMIC_RELAXED);
+
+			if (t > b)
+			{
+				__atomic_store_n(&bottom_, b + 1, __ATOMIC_RELAXED);
+				return nullptr;
+			}
+
+			job* j = __atomic_load_n(&slots_[b & (capacity - 1)], __ATOMIC_RELAXED);
+			if (t == b)
+			{
+				// Last job, race against thieves for it
+				if (!__atomic_compare_exchange_n(&top_, &t, t + 1, false,
+				                                 __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+					j = nullptr;
+				__atomic_store_n(&bottom_, b + 1, __ATOMIC_RELAXED);
+			}
+
+			return j;
+		}
+
+		job* steal()
+		{
+			int64_t t = __atomic_load_n(&top_, __ATOMIC_ACQUIRE);
+			__atomic_thread_fence(__ATOMIC_SEQ_CST);
+			int64_t b = __atomic_load_n(&bottom_, __ATOMIC_ACQUIRE);
+			if (t >= b)
+				return nullptr;
+
+			job* j = __atomic_load_n(&slots_[t & (capacity - 1)], __ATOMIC_RELAXED);
+			if (!__atomic_compare_exchange_n(&top_, &t, t + 1, false, __ATOMIC_SEQ_CST,
+			                                 __ATOMIC_RELAXED))
+				return nullptr;
+
+			return j;
+		}
+
+	private:
+		// Owner and thieves write different ends, keep them on separate cache lines
+		alignas(64) int64_t top_ {0};
+		alignas(64) int64_t bottom_ {0};
+		alignas(64) job* slots_[capacity] {nullptr};
+	};
+
+	scheduler* scheduler::scheduler_ {nullptr};
+
+	scheduler& scheduler::get()
+	{
+		return *scheduler_;
+	}
+
+	bool scheduler::exists()
+	{
+		return scheduler_;
+	}
+
+	scheduler::scheduler(uint32_t worker_cnt)
+	{
+		log::assert(!scheduler_, "Only one job scheduler can exist");
+		scheduler_ = this;
+
+		if (worker_cnt == UINT32_MAX)
+			worker_cnt = thread::core_count() - 1;
+		if (worker_cnt > max_workers)
+			worker_cnt = max_workers;
+		worker_cnt_ = worker_cnt;
+
+		// Deque 0 belongs to the creating thread
+		deques_ = new work_deque[worker_cnt_ + 1];
+		local_idx = 0;
+
+		threads_ = new thread::native[worker_cnt_];
+		for (uint32_t i {0}; i < worker_cnt_; ++i)
+		{
+			threads_[i] = thread::start(worker_main,
+			                            reinterpret_cast<void*>(uintptr_t {i + 1}));
+		}
+
+		log::info("Job scheduler started with %u workers", worker_cnt_);
+	}
+
+	scheduler::~scheduler()
+	{
+		__atomic_store_n(&running_, false, __ATOMIC_SEQ_CST);
+		wake_.signal(worker_cnt_);
+
+		for (uint32_t i {0}; i < worker_cnt_; ++i)
+			thread::join(threads_[i]);
+
+		delete[] threads_;
+		delete[] deques_;
+
+		local_idx = UINT32_MAX;
+		scheduler_ = nullptr;
+	}
+
+	uint32_t scheduler::worker_count() const
+	{
+		return worker_cnt_;
+	}
+
+	bool scheduler::on_worker() const
+	{
+		return local_idx != UINT32_MAX && local_idx != 0;
+	}
+
+	void scheduler::run(job* jobs, uint32_t cnt)
+	{
+		uint32_t const idx = local_idx;
+
+		for (uint32_t i {0}; i < cnt; ++i)
+		{
+			job* j = &jobs[i];
+			if (j->cnt)
+				__atomic_add_fetch(&j->cnt->value, 1, __ATOMIC_RELAXED);
+
+			bool queued = idx != UINT32_MAX ? deques_[idx].push(j) : inject(j);
+			// Queues are full, the caller runs the job itself
+			if (!queued)
+				execute(j);
+		}
+
+		// Pairs with the fence of sleeping workers, so that either they see the new
+		// jobs or this sees them asleep
+		__atomic_thread_fence(__ATOMIC_SEQ_CST);
+		uint32_t sleeping = __atomic_load_n(&sleeping_, __ATOMIC_RELAXED);
+		if (sleeping)
+			wake_.signal(sleeping < cnt ? sleeping : cnt);
+	}
+
+	void scheduler::wait(counter& cnt)
+	{
+		uint32_t const idx = local_idx;
+
+		while (__atomic_load_n(&cnt.value, __ATOMIC_ACQUIRE) != 0)
+		{
+			if (job* j = fetch(idx))
+				execute(j);
+			else
+				thread::pause();
+		}
+	}
+
+	void scheduler::worker_main(void* arg)
+	{
+		scheduler&     sched = *scheduler_;
+		uint32_t const idx = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(arg));
+		local_idx = idx;
+
+		uint32_t idle {0};
+		while (__atomic_load_n(&sched.running_, __ATOMIC_ACQUIRE))
+		{
+			if (job* j = sched.fetch(idx))
+			{
+				sched.execute(j);
+				idle = 0;
+				continue;
+			}
+
+			if (++idle < idle_spins)
+			{
+				thread::pause();
+				continue;
+			}
+
+			__atomic_add_fetch(&sched.sleeping_, 1, __ATOMIC_SEQ_CST);
+			__atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+			// A job may have been pushed before the push side could see this asleep
+			job* j = sched.fetch(idx);
+			if (!j)
+				sched.wake_.wait();
+
+			__atomic_sub_fetch(&sched.sleeping_, 1, __ATOMIC_SEQ_CST);
+			if (j)
+				sched.execute(j);
+			idle = 0;
+		}
+
+		local_idx = UINT32_MAX;
+	}
+
+	job* scheduler::fetch(uint32_t idx)
+	{
+		if (idx != UINT32_MAX)
+		{
+			if (job* j = deques_[idx].pop())
+				return j;
+		}
+
+		if (__atomic_load_n(&injected_cnt_, __ATOMIC_RELAXED))
+		{
+			while (__atomic_exchange_n(&injected_lock_, true, __ATOMIC_ACQUIRE))
+				thread::pause();
+
+			job* j {nullptr};
+			if (injected_cnt_)
+			{
+				j = injected_[injected_head_];
+				injected_head_ = (injected_head_ + 1) % injected_capacity;
+				__atomic_store_n(&injected_cnt_, injected_cnt_ - 1, __ATOMIC_RELAXED);
+			}
+
+			__atomic_store_n(&injected_lock_, false, __ATOMIC_RELEASE);
+			if (j)
+				return j;
+		}
+
+		// Start after the own deque so that thieves spread over victims
+		uint32_t const deque_cnt = worker_cnt_ + 1;
+		uint32_t const start = idx != UINT32_MAX ? idx + 1 : 0;
+		for (uint32_t i {0}; i < deque_cnt; ++i)
+		{
+			uint32_t victim = (start + i) % deque_cnt;
+			if (victim == idx)
+				continue;
+
+			if (job* j = deques_[victim].steal())
+				return j;
+		}
+
+		return nullptr;
+	}
+
+	void scheduler::execute(job* j)
+	{
+		// The job may be freed by its function, e.g. when it resumes a coroutine
+		counter* cnt = j->cnt;
+		j->fn(j->data);
+		if (cnt)
+			__atomic_sub_fetch(&cnt->value, 1, __ATOMIC_RELEASE);
+	}
+
+	bool scheduler::inject(job* j)
+	{
+		while (__atomic_exchange_n(&injected_lock_, true, __ATOMIC_ACQUIRE))
+			thread::pause();
+
+		bool queued {false};
+		if (injected_cnt_ < injected_capacity)
+		{
+			injected_[(injected_head_ + injected_cnt_) % injected_capacity] = j;
+			__atomic_store_n(&injected_cnt_, injected_cnt_ + 1, __ATOMIC_RELAXED);
+			queued = true;
+		}
+
+		__atomic_store_n(&injected_lock_, false, __ATOMIC_RELEASE);
+
+		return queued;
+	}
+}
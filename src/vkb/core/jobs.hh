@@ -0,0 +1,129 @@
+#pragma once
+
+#include "thread.hh"
+
+#include <vector.hh>
+
+#include <stdint.h>
+
+namespace vkb::jobs
+{
+	// Number of pending jobs of a group, reaches 0 once they all ran
+	struct counter
+	{
+		uint32_t value {0};
+	};
+
+	// Jobs are referenced, not copied: they must outlive their execution, which
+	// waiting on their counter guarantees
+	struct job
+	{
+		void (*fn)(void* data) {nullptr};
+		void*    data {nullptr};
+		counter* cnt {nullptr};
+	};
+
+	class work_deque;
+
+	// Work stealing scheduler. Each worker thread, and the thread creating the
+	// scheduler, owns a deque it pushes and pops jobs at the bottom of, while idle
+	// threads steal from the top of the others'. Waiting on a counter runs jobs
+	// instead of blocking.
+	class scheduler
+	{
+	public:
+		static scheduler& get();
+		static bool       exists();
+
+		// Defaults to one worker per core besides the calling thread
+		scheduler(uint32_t worker_cnt = UINT32_MAX);
+		scheduler(scheduler const&) = delete;
+		scheduler(scheduler&&) = delete;
+		~scheduler();
+
+		scheduler& operator=(scheduler const&) = delete;
+		scheduler& operator=(scheduler&&) = delete;
+
+		uint32_t worker_count() const;
+		// Whether the calling thread is one of the workers
+		bool     on_worker() const;
+
+		void run(job* jobs, uint32_t cnt);
+		void wait(counter& cnt);
+
+	private:
+		constexpr static uint32_t max_workers {63};
+		constexpr static uint32_t injected_capacity {1024};
+		constexpr static uint32_t idle_spins {2048};
+
+		static void worker_main(void* arg);
+
+		job* fetch(uint32_t idx);
+		void execute(job* j);
+		bool inject(job* j);
+
+		static scheduler* scheduler_;
+
+		uint32_t        worker_cnt_ {0};
+		work_deque*     deques_ {nullptr};
+		thread::native* threads_ {nullptr};
+
+		thread::semaphore wake_;
+		uint32_t          sleeping_ {0};
+		bool              running_ {true};
+
+		// Jobs pushed by threads the scheduler doesn't own, guarded by a spin lock
+		job*     injected_[injected_capacity] {nullptr};
+		uint32_t injected_head_ {0};
+		uint32_t injected_cnt_ {0};
+		bool     injected_lock_ {false};
+	};
+
+	// Calls fn(range_begin, range_end) over [begin, end) split in ranges of `grain`
+	// items, spread over the workers, and returns once all of them ran
+	template <typename F>
+	void parallel_for(uint32_t begin, uint32_t end, uint32_t grain, F const& fn)
+	{
+		if (begin >= end)
+			return;
+		if (grain == 0)
+			grain = 1;
+
+		uint32_t const range_cnt = (end - begin + grain - 1) / grain;
+		if (range_cnt == 1 || !scheduler::exists() || !scheduler::get().worker_count())
+		{
+			fn(begin, end);
+			return;
+		}
+
+		struct range
+		{
+			F const* fn;
+			uint32_t begin;
+			uint32_t end;
+		};
+
+		mc::vector<range> ranges;
+		mc::vector<job>   batch;
+		counter           cnt;
+		ranges.reserve(range_cnt);
+		batch.reserve(range_cnt);
+
+		for (uint32_t b {begin}; b < end; b += grain)
+			ranges.emplace_back(range {&fn, b, end - b < grain ? end : b + grain});
+
+		for (range& r : ranges)
+		{
+			auto call = [](void* data)
+			{
+				range* r = static_cast<range*>(data);
+				(*r->fn)(r->begin, r->end);
+			};
+			batch.emplace_back(job {call, &r, &cnt});
+		}
+
+		scheduler& sched = scheduler::get();
+		sched.run(batch.data(), batch.size());
+		sched.wait(cnt);
+	}
+}
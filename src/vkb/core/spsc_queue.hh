@@ -0,0 +1,53 @@
+#pragma once
+
+#include <stdint.h>
+
+namespace vkb
+{
+	// Bounded lock-free queue between exactly one producer thread and one consumer
+	// thread
+	template <typename T, uint32_t N>
+	class spsc_queue
+	{
+		static_assert(N > 0 && (N & (N - 1)) == 0, "Capacity must be a power of 2");
+
+	public:
+		// False when full
+		bool push(T const& val)
+		{
+			uint32_t tail = __atomic_load_n(&tail_, __ATOMIC_RELAXED);
+			if (tail - __atomic_load_n(&head_, __ATOMIC_ACQUIRE) == N)
+				return false;
+
+			items_[tail & (N - 1)] = val;
+			__atomic_store_n(&tail_, tail + 1, __ATOMIC_RELEASE);
+
+			return true;
+		}
+
+		// False when empty
+		bool pop(T& val)
+		{
+			uint32_t head = __atomic_load_n(&head_, __ATOMIC_RELAXED);
+			if (__atomic_load_n(&tail_, __ATOMIC_ACQUIRE) == head)
+				return false;
+
+			val = items_[head & (N - 1)];
+			__atomic_store_n(&head_, head + 1, __ATOMIC_RELEASE);
+
+			return true;
+		}
+
+		bool empty() const
+		{
+			return __atomic_load_n(&tail_, __ATOMIC_ACQUIRE) ==
+			       __atomic_load_n(&head_, __ATOMIC_ACQUIRE);
+		}
+
+	private:
+		// Each side writes its own index, keep them on separate cache lines
+		alignas(64) uint32_t head_ {0};
+		alignas(64) uint32_t tail_ {0};
+		alignas(64) T items_[N];
+	};
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <stdint.h>
+
+#if defined(VKB_LINUX) || defined(VKB_MAC)
+#include <pthread.h>
+#endif
+#ifdef VKB_LINUX
+#include <semaphore.h>
+#endif
+
+namespace vkb
+{
+	namespace thread
+	{
+#ifdef VKB_WINDOWS
+		using native = void*;
+		using native_semaphore = void*;
+#elif defined(VKB_LINUX)
+		using native = pthread_t;
+		using native_semaphore = sem_t;
+#elif defined(VKB_MAC)
+		using native = pthread_t;
+		// dispatch_semaphore_t, unnamed POSIX semaphores are not supported on mac
+		using native_semaphore = void*;
+#endif
+
+		using entry = void (*)(void* arg);
+
+		native start(entry fn, void* arg);
+		void   join(native t);
+
+		// Unique among running threads
+		uint64_t current_id();
+		// Number of logical cores
+		uint32_t core_count();
+		// Gives the rest of the time slice to another thread
+		void     yield();
+
+		// Hint for spin loops
+		inline void pause()
+		{
+#if defined(__x86_64__) || defined(__i386__)
+			__builtin_ia32_pause();
+#elif defined(__aarch64__)
+			asm volatile("yield");
+#endif
+		}
+
+		class semaphore
+		{
+		public:
+			semaphore(uint32_t initial = 0);
+			semaphore(semaphore const&) = delete;
+			semaphore(semaphore&&) = delete;
+			~semaphore();
+
+			semaphore& operator=(semaphore const&) = delete;
+			semaphore& operator=(semaphore&&) = delete;
+
+			void signal(uint32_t cnt = 1);
+			void wait();
+
+		private:
+			native_semaphore sem_;
+		};
+	}
+}
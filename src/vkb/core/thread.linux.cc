@@ -0,0 +1,80 @@
+#include "thread.hh"
+
+#include "../log.hh"
+
+#include <sched.h>
+#include <unistd.h>
+
+namespace vkb::thread
+{
+	namespace
+	{
+		struct start_info
+		{
+			entry fn;
+			void* arg;
+		};
+
+		void* run(void* data)
+		{
+			start_info info = *static_cast<start_info*>(data);
+			delete static_cast<start_info*>(data);
+			info.fn(info.arg);
+
+			return nullptr;
+		}
+	}
+
+	native start(entry fn, void* arg)
+	{
+		native t;
+		int    res = pthread_create(&t, nullptr, run, new start_info {fn, arg});
+		log::assert(res == 0, "Failed to create thread (%d)", res);
+
+		return t;
+	}
+
+	void join(native t)
+	{
+		pthread_join(t, nullptr);
+	}
+
+	uint64_t current_id()
+	{
+		return static_cast<uint64_t>(pthread_self());
+	}
+
+	uint32_t core_count()
+	{
+		long cnt = sysconf(_SC_NPROCESSORS_ONLN);
+		return cnt > 0 ? static_cast<uint32_t>(cnt) : 1;
+	}
+
+	void yield()
+	{
+		sched_yield();
+	}
+
+	semaphore::semaphore(uint32_t initial)
+	{
+		sem_init(&sem_, 0, initial);
+	}
+
+	semaphore::~semaphore()
+	{
+		sem_destroy(&sem_);
+	}
+
+	void semaphore::signal(uint32_t cnt)
+	{
+		for (uint32_t i {0}; i < cnt; ++i)
+			sem_post(&sem_);
+	}
+
+	void semaphore::wait()
+	{
+		// Retry when interrupted by a signal
+		while (sem_wait(&sem_) != 0)
+			;
+	}
+}
@@ -0,0 +1,82 @@
+#include "thread.hh"
+
+#include "../log.hh"
+
+#include <dispatch/dispatch.h>
+#include <sched.h>
+#include <unistd.h>
+
+namespace vkb::thread
+{
+	namespace
+	{
+		struct start_info
+		{
+			entry fn;
+			void* arg;
+		};
+
+		void* run(void* data)
+		{
+			start_info info = *static_cast<start_info*>(data);
+			delete static_cast<start_info*>(data);
+			info.fn(info.arg);
+
+			return nullptr;
+		}
+	}
+
+	native start(entry fn, void* arg)
+	{
+		native t;
+		int    res = pthread_create(&t, nullptr, run, new start_info {fn, arg});
+		log::assert(res == 0, "Failed to create thread (%d)", res);
+
+		return t;
+	}
+
+	void join(native t)
+	{
+		pthread_join(t, nullptr);
+	}
+
+	uint64_t current_id()
+	{
+		uint64_t id {0};
+		pthread_threadid_np(nullptr, &id);
+		return id;
+	}
+
+	uint32_t core_count()
+	{
+		long cnt = sysconf(_SC_NPROCESSORS_ONLN);
+		return cnt > 0 ? static_cast<uint32_t>(cnt) : 1;
+	}
+
+	void yield()
+	{
+		sched_yield();
+	}
+
+	semaphore::semaphore(uint32_t initial)
+	: sem_ {dispatch_semaphore_create(initial)}
+	{
+	}
+
+	semaphore::~semaphore()
+	{
+		dispatch_release(static_cast<dispatch_semaphore_t>(sem_));
+	}
+
+	void semaphore::signal(uint32_t cnt)
+	{
+		for (uint32_t i {0}; i < cnt; ++i)
+			dispatch_semaphore_signal(static_cast<dispatch_semaphore_t>(sem_));
+	}
+
+	void semaphore::wait()
+	{
+		dispatch_semaphore_wait(static_cast<dispatch_semaphore_t>(sem_),
+		                        DISPATCH_TIME_FOREVER);
+	}
+}
@@ -0,0 +1,80 @@
+#include "thread.hh"
+
+#include "../log.hh"
+
+#include <win32/misc.h>
+#include <win32/sysinfo.h>
+#include <win32/threads.h>
+
+namespace vkb::thread
+{
+	namespace
+	{
+		struct start_info
+		{
+			entry fn;
+			void* arg;
+		};
+
+		DWORD WINAPI run(void* data)
+		{
+			start_info info = *static_cast<start_info*>(data);
+			delete static_cast<start_info*>(data);
+			info.fn(info.arg);
+
+			return 0;
+		}
+	}
+
+	native start(entry fn, void* arg)
+	{
+		native t = CreateThread(nullptr, 0, run, new start_info {fn, arg}, 0, nullptr);
+		log::assert(t, "Failed to create thread (%lu)", GetLastError());
+
+		return t;
+	}
+
+	void join(native t)
+	{
+		WaitForSingleObject(t, INFINITE);
+		CloseHandle(t);
+	}
+
+	uint64_t current_id()
+	{
+		return GetCurrentThreadId();
+	}
+
+	uint32_t core_count()
+	{
+		SYSTEM_INFO info;
+		GetSystemInfo(&info);
+
+		return info.dwNumberOfProcessors;
+	}
+
+	void yield()
+	{
+		SwitchToThread();
+	}
+
+	semaphore::semaphore(uint32_t initial)
+	: sem_ {CreateSemaphoreA(nullptr, initial, 0x7fffffff, nullptr)}
+	{
+	}
+
+	semaphore::~semaphore()
+	{
+		CloseHandle(sem_);
+	}
+
+	void semaphore::signal(uint32_t cnt)
+	{
+		ReleaseSemaphore(sem_, cnt, nullptr);
+	}
+
+	void semaphore::wait()
+	{
+		WaitForSingleObject(sem_, INFINITE);
+	}
+}
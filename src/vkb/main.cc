@@ -1,5 +1,8 @@
 #include "cam/free.hh"
 #include "cam/orbital.hh"
+#include "core/async.hh"
+#include "core/frame_pipeline.hh"
+#include "core/jobs.hh"
 #include "core/time.hh"
 #include "input/input_system.hh"
 #include "vkb/mtl/texture.hh"
@@ -24,13 +27,14 @@
 #include "win/window.hh"
 
 #include "log.hh"
-#include "math/math.hh"
+#include "math/random.hh"
 #include "math/trig.hh"
 #include "math/vec2.hh"
 
 #include <math.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
 #ifdef USE_SUPERLUMINAL
 #include <Superluminal/PerformanceAPI.h>
@@ -48,7 +52,9 @@ int main(int argc, char** argv)
 	using namespace vkb::mtl;
 #endif
 
-	math::init_random();
+	math::seed(static_cast<uint64_t>(::time(nullptr)));
+
+	jobs::scheduler scheduler;
 
 	display      disp;
 	input_system is;
@@ -121,13 +127,25 @@ int main(int argc, char** argv)
 		20, 22, 21, 22, 23, 21, // right face
 	};
 
-	model   cube {verts, sizeof(verts), idcs, sizeof(idcs)};
+	model cube {verts, sizeof(verts), idcs, sizeof(idcs)};
+#ifndef VKB_MAC
+	// Read and decoded on workers, then uploaded by the render thread, which sets
+	// tex_loaded once the upload completed
+	texture tex;
+	bool    tex_loaded {false};
+	auto    load = [](context& ctx, texture& tex, bool& loaded) -> async::task<>
+	{
+		loaded = co_await ctx.load_texture(tex, mc::string("res/textures/tex.png"));
+	};
+	async::start(load(ctx, tex, tex_loaded));
+#else
 	texture tex {"res/textures/tex.png"};
+	bool    tex_loaded {true};
+#endif
 
 	// ctx.set_proj(0.1f, 1000.f, 70.f);
 
-	// mc::vector<vk::object> objs;
-	// objs.reserve(100);
+	// scene::store objs;
 
 	// srand(0);
 
@@ -158,7 +176,69 @@ int main(int argc, char** argv)
 	// modules.emplace_back(mat4::scale({.5f, .5f, .5f, 1.f}) *
 	//                      mat4::translate({2.f, 0.f, 0.f, 1.f}));
 
-	uint32_t cur_img = 0;
+	// Everything the render thread reads from the simulation for a frame. The window
+	// belongs to the main thread, which handles its events.
+	struct frame
+	{
+		mat4     view;
+		mat4     rot;
+		uint32_t w;
+		uint32_t h;
+	};
+
+	// Owned by the render thread once the pipeline runs, along with the surface
+	struct renderer
+	{
+		context&     ctx;
+		triangle&    triangle_mat;
+		coordinates& coords;
+		model&       cube;
+		texture&     tex;
+		bool const&  tex_loaded;
+		mat4         coords_proj;
+		vec2         translate;
+		uint32_t     cur_img {0};
+	} rdr {ctx, triangle_mat, coords, cube, tex, tex_loaded, coords_proj, translate};
+
+	auto render = [](frame const& f, void* user)
+	{
+		renderer& r = *static_cast<renderer*>(user);
+
+#ifndef VKB_MAC
+		// Takes GPU work over from the main thread, before resuming uploads
+		instance::get().set_owner_thread();
+#endif
+		async::render_loop().poll();
+
+		if (r.ctx.prepare_draw(f.w, f.h))
+		{
+			r.coords_proj = mat4::ortho_proj(-50.f, 50.f, 0, f.w, f.h, 0);
+			r.translate = {(75.f * 2 / f.w), ((f.h - 75.f) * 2 / f.h)};
+		}
+		r.triangle_mat.prepare_draw(r.cur_img, f.view, r.ctx.get_proj());
+		r.coords.prepare_draw(r.cur_img, f.rot, r.coords_proj, r.translate);
+		if (r.tex_loaded)
+			r.triangle_mat.draw(r.cube, r.tex, r.cur_img, r.ctx.current_render_command());
+		r.coords.draw(r.cur_img, r.ctx.current_render_command());
+		r.ctx.present();
+		r.cur_img = (r.cur_img + 1) % 2;
+	};
+
+#ifndef VKB_MAC
+	// Destroyed right after the pipeline, gives GPU work back to the main thread which
+	// destroys the resources
+	struct owner_reset
+	{
+		~owner_reset()
+		{
+			instance::get().set_owner_thread();
+		}
+	} reset_owner;
+#endif
+
+	// Declared last to stop the render thread before the resources it uses go away
+	frame_pipeline<frame> pipeline(render, &rdr);
+
 	while (running)
 	{
 #ifdef USE_SUPERLUMINAL
@@ -170,20 +250,14 @@ int main(int argc, char** argv)
 
 		is.clear_transitions();
 		disp.update();
+		async::poll();
 		cam.update(dt);
 
-		// for (uint32_t i {0}; i < objs.size(); i++)
-		// 	objs[i].update(dt);
+		// objs.update(dt);
 
 		if (!main_window.closed() && !main_window.minimized())
 		{
 			// 	ui_ctx.update(dt);
-			if (ctx.prepare_draw())
-			{
-				auto [w, h] = surface.get_size();
-				coords_proj = mat4::ortho_proj(-50.f, 50.f, 0, w, h, 0);
-				translate = {(75.f * 2 / w), ((h - 75.f) * 2 / h)};
-			}
 			// 	sky.prepare_draw(ctx.current_command_buffer(), ctx.current_img_idx(), cam,
 			// 	                 ctx.get_proj());
 			// 	mod.prepare_draw(ctx.current_command_buffer(), ctx.current_img_idx(), cam,
@@ -193,12 +267,15 @@ int main(int argc, char** argv)
 			// 	sky.draw(ctx.current_command_buffer(), ctx.current_img_idx());
 			// 	mod.draw(ctx.current_command_buffer(), ctx.current_img_idx(), model,
 			// modules); 	; 	ui_ctx.draw();
-			triangle_mat.prepare_draw(cur_img, cam.view_mat(), ctx.get_proj());
-			coords.prepare_draw(cur_img, cam, coords_proj, translate);
-			triangle_mat.draw(cube, tex, cur_img, ctx.current_render_command());
-			coords.draw(cur_img, ctx.current_render_command());
-			ctx.present();
-			cur_img = (cur_img + 1) % 2;
+
+			// Rendering of this frame overlaps the simulation of the next one
+			frame& f = pipeline.begin_frame();
+			f.view = cam.view_mat();
+			f.rot = cam.rot_mat();
+			auto [win_w, win_h] = main_window.physical_size();
+			f.w = win_w;
+			f.h = win_h;
+			pipeline.submit();
 		}
 
 		if (main_window.closed())
@@ -0,0 +1,253 @@
+#include "batch.hh"
+
+#include "mat4.hh"
+#include "simd.hh"
+
+#include <math.h>
+
+namespace vkb::math
+{
+	namespace
+	{
+		constexpr uint32_t width {4};
+
+		struct m3x4
+		{
+			float m[4][3];
+		};
+
+		m3x4 affine(mat4 const& mat)
+		{
+			m3x4 res;
+			for (uint32_t i {0}; i < 4; ++i)
+			{
+				for (uint32_t j {0}; j < 3; ++j)
+					res.m[i][j] = mat[i][j];
+			}
+
+			return res;
+		}
+
+		// Rows 0 to 2 of the rotation of a unit quaternion, as in quat::operator mat4
+		void quat_rows(float w, float x, float y, float z, float rows[3][3])
+		{
+			rows[0][0] = 1 - 2 * y * y - 2 * z * z;
+			rows[0][1] = 2 * x * y - 2 * w * z;
+			rows[0][2] = 2 * x * z + 2 * w * y;
+			rows[1][0] = 2 * x * y + 2 * w * z;
+			rows[1][1] = 1 - 2 * x * x - 2 * z * z;
+			rows[1][2] = 2 * y * z - 2 * w * x;
+			rows[2][0] = 2 * x * z - 2 * w * y;
+			rows[2][1] = 2 * y * z + 2 * w * x;
+			rows[2][2] = 1 - 2 * x * x - 2 * y * y;
+		}
+	}
+
+	void transform_points(mat4 const& m, vec3_soa points, vec3_soa_out out,
+	                      uint32_t count)
+	{
+		m3x4 const a = affine(m);
+
+		simd::f32x4 rows[4][3];
+		for (uint32_t r {0}; r < 4; ++r)
+		{
+			for (uint32_t c {0}; c < 3; ++c)
+				rows[r][c] = simd::splat(a.m[r][c]);
+		}
+
+		float* const dst[3] {out.x, out.y, out.z};
+
+		uint32_t i {0};
+		for (; i + width <= count; i += width)
+		{
+			simd::f32x4 const x = simd::load(points.x + i);
+			simd::f32x4 const y = simd::load(points.y + i);
+			simd::f32x4 const z = simd::load(points.z + i);
+
+			for (uint32_t c {0}; c < 3; ++c)
+			{
+				simd::f32x4 res = simd::madd(z, rows[2][c], rows[3][c]);
+				res = simd::madd(y, rows[1][c], res);
+				res = simd::madd(x, rows[0][c], res);
+				simd::store(dst[c] + i, res);
+			}
+		}
+
+		for (; i < count; ++i)
+		{
+			float const x = points.x[i];
+			float const y = points.y[i];
+			float const z = points.z[i];
+			for (uint32_t c {0}; c < 3; ++c)
+				dst[c][i] = x * a.m[0][c] + y * a.m[1][c] + z * a.m[2][c] + a.m[3][c];
+		}
+	}
+
+	void transform_aabbs(mat4 const& m, vec3_soa centers, vec3_soa extents,
+	                     vec3_soa_out out_centers, vec3_soa_out out_extents,
+	                     uint32_t count)
+	{
+		transform_points(m, centers, out_centers, count);
+
+		// Extents are projected on each axis through the absolute rotation and scale
+		// ("Transforming Axis-Aligned Bounding Boxes", Arvo 1990)
+		m3x4 a = affine(m);
+
+		simd::f32x4 rows[3][3];
+		for (uint32_t r {0}; r < 3; ++r)
+		{
+			for (uint32_t c {0}; c < 3; ++c)
+			{
+				a.m[r][c] = fabsf(a.m[r][c]);
+				rows[r][c] = simd::splat(a.m[r][c]);
+			}
+		}
+
+		float* const dst[3] {out_extents.x, out_extents.y, out_extents.z};
+
+		uint32_t i {0};
+		for (; i + width <= count; i += width)
+		{
+			simd::f32x4 const x = simd::abs(simd::load(extents.x + i));
+			simd::f32x4 const y = simd::abs(simd::load(extents.y + i));
+			simd::f32x4 const z = simd::abs(simd::load(extents.z + i));
+
+			for (uint32_t c {0}; c < 3; ++c)
+			{
+				simd::f32x4 res = simd::mul(z, rows[2][c]);
+				res = simd::madd(y, rows[1][c], res);
+				res = simd::madd(x, rows[0][c], res);
+				simd::store(dst[c] + i, res);
+			}
+		}
+
+		for (; i < count; ++i)
+		{
+			float const x = fabsf(extents.x[i]);
+			float const y = fabsf(extents.y[i]);
+			float const z = fabsf(extents.z[i]);
+			for (uint32_t c {0}; c < 3; ++c)
+				dst[c][i] = x * a.m[0][c] + y * a.m[1][c] + z * a.m[2][c];
+		}
+	}
+
+	void compose_trs(vec3_soa pos, quat_soa rot, vec3_soa scale, mat4* out,
+	                 uint32_t count)
+	{
+		simd::f32x4 const zero = simd::splat(0.f);
+		simd::f32x4 const one = simd::splat(1.f);
+		simd::f32x4 const two = simd::splat(2.f);
+
+		uint32_t i {0};
+		for (; i + width <= count; i += width)
+		{
+			simd::f32x4 w = simd::load(rot.w + i);
+			simd::f32x4 x = simd::load(rot.x + i);
+			simd::f32x4 y = simd::load(rot.y + i);
+			simd::f32x4 z = simd::load(rot.z + i);
+
+			simd::f32x4 x2 = simd::mul(x, two);
+			simd::f32x4 y2 = simd::mul(y, two);
+			simd::f32x4 z2 = simd::mul(z, two);
+			simd::f32x4 xx = simd::mul(x, x2);
+			simd::f32x4 yy = simd::mul(y, y2);
+			simd::f32x4 zz = simd::mul(z, z2);
+			simd::f32x4 xy = simd::mul(x, y2);
+			simd::f32x4 xz = simd::mul(x, z2);
+			simd::f32x4 yz = simd::mul(y, z2);
+			simd::f32x4 wx = simd::mul(w, x2);
+			simd::f32x4 wy = simd::mul(w, y2);
+			simd::f32x4 wz = simd::mul(w, z2);
+
+			simd::f32x4 sx = simd::load(scale.x + i);
+			simd::f32x4 sy = simd::load(scale.y + i);
+			simd::f32x4 sz = simd::load(scale.z + i);
+
+			// Component j of row r for the 4 matrices, then transposed to matrix rows
+			simd::f32x4 r00 = simd::mul(simd::sub(one, simd::add(yy, zz)), sx);
+			simd::f32x4 r01 = simd::mul(simd::sub(xy, wz), sx);
+			simd::f32x4 r02 = simd::mul(simd::add(xz, wy), sx);
+			simd::f32x4 r03 = zero;
+
+			simd::f32x4 r10 = simd::mul(simd::add(xy, wz), sy);
+			simd::f32x4 r11 = simd::mul(simd::sub(one, simd::add(xx, zz)), sy);
+			simd::f32x4 r12 = simd::mul(simd::sub(yz, wx), sy);
+			simd::f32x4 r13 = zero;
+
+			simd::f32x4 r20 = simd::mul(simd::sub(xz, wy), sz);
+			simd::f32x4 r21 = simd::mul(simd::add(yz, wx), sz);
+			simd::f32x4 r22 = simd::mul(simd::sub(one, simd::add(xx, yy)), sz);
+			simd::f32x4 r23 = zero;
+
+			simd::f32x4 r30 = simd::load(pos.x + i);
+			simd::f32x4 r31 = simd::load(pos.y + i);
+			simd::f32x4 r32 = simd::load(pos.z + i);
+			simd::f32x4 r33 = one;
+
+			simd::transpose(r00, r01, r02, r03);
+			simd::transpose(r10, r11, r12, r13);
+			simd::transpose(r20, r21, r22, r23);
+			simd::transpose(r30, r31, r32, r33);
+
+			simd::f32x4 const rows[4][4] {
+				{r00, r10, r20, r30},
+				{r01, r11, r21, r31},
+				{r02, r12, r22, r32},
+				{r03, r13, r23, r33},
+			};
+			for (uint32_t k {0}; k < width; ++k)
+			{
+				mat4& m = out[i + k];
+				for (uint8_t r {0}; r < 4; ++r)
+					simd::store(m[r], rows[k][r]);
+			}
+		}
+
+		for (; i < count; ++i)
+		{
+			float rows[3][3];
+			quat_rows(rot.w[i], rot.x[i], rot.y[i], rot.z[i], rows);
+
+			float const s[3] {scale.x[i], scale.y[i], scale.z[i]};
+			mat4&       m = out[i];
+			for (uint8_t r {0}; r < 3; ++r)
+			{
+				m[r][0] = rows[r][0] * s[r];
+				m[r][1] = rows[r][1] * s[r];
+				m[r][2] = rows[r][2] * s[r];
+				m[r][3] = 0.f;
+			}
+			m[3][0] = pos.x[i];
+			m[3][1] = pos.y[i];
+			m[3][2] = pos.z[i];
+			m[3][3] = 1.f;
+		}
+	}
+
+	void multiply(mat4 const* in, mat4 const& rhs, mat4* out, uint32_t count)
+	{
+		simd::f32x4 const o0 = simd::load(rhs[0]);
+		simd::f32x4 const o1 = simd::load(rhs[1]);
+		simd::f32x4 const o2 = simd::load(rhs[2]);
+		simd::f32x4 const o3 = simd::load(rhs[3]);
+
+		for (uint32_t i {0}; i < count; ++i)
+		{
+			mat4 const& m = in[i];
+
+			// Rows are all computed before storing, out may alias in
+			simd::f32x4 rows[4];
+			for (uint8_t r {0}; r < 4; ++r)
+			{
+				float const* row = m[r];
+				simd::f32x4  res = simd::mul(simd::splat(row[0]), o0);
+				res = simd::madd(simd::splat(row[1]), o1, res);
+				res = simd::madd(simd::splat(row[2]), o2, res);
+				rows[r] = simd::madd(simd::splat(row[3]), o3, res);
+			}
+
+			for (uint8_t r {0}; r < 4; ++r)
+				simd::store(out[i][r], rows[r]);
+		}
+	}
+}
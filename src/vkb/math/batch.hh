@@ -0,0 +1,55 @@
+#pragma once
+
+#include <stdint.h>
+
+namespace vkb
+{
+	class mat4;
+}
+
+// Throughput kernels over arrays, SIMD across elements. They have no shared state, so
+// disjoint ranges can be processed concurrently by jobs, by offsetting the arrays.
+namespace vkb::math
+{
+	// One array per component
+	struct vec3_soa
+	{
+		float const* x;
+		float const* y;
+		float const* z;
+	};
+
+	struct vec3_soa_out
+	{
+		float* x;
+		float* y;
+		float* z;
+	};
+
+	// Unit quaternions
+	struct quat_soa
+	{
+		float const* w;
+		float const* x;
+		float const* y;
+		float const* z;
+	};
+
+	// out = (p, 1) * m. Outputs can alias the inputs.
+	void transform_points(mat4 const& m, vec3_soa points, vec3_soa_out out,
+	                      uint32_t count);
+
+	// Axis aligned boxes given by their center and half extents, out are the boxes
+	// bounding the transformed ones. Outputs can alias the inputs.
+	void transform_aabbs(mat4 const& m, vec3_soa centers, vec3_soa extents,
+	                     vec3_soa_out out_centers, vec3_soa_out out_extents,
+	                     uint32_t count);
+
+	// out = scale(s) * mat4(r) * translate(p)
+	void compose_trs(vec3_soa pos, quat_soa rot, vec3_soa scale, mat4* out,
+	                 uint32_t count);
+
+	// out = in * rhs, e.g. model matrices by a shared view-projection. out can alias
+	// in, but not rhs.
+	void multiply(mat4 const* in, mat4 const& rhs, mat4* out, uint32_t count);
+}
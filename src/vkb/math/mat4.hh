@@ -4,8 +4,11 @@
 
 #include <initializer_list.hh>
 
+#include "simd.hh"
 #include "vec4.hh"
 
+#include <math.h>
+
 namespace vkb
 {
 	enum class fov_axis
@@ -17,31 +20,308 @@ namespace vkb
 	class mat4
 	{
 	public:
-		static mat4 identity;
-		static mat4 scale(vec4 scale);
-		static mat4 rotate(vec4 axis, float angle);
-		static mat4 translate(vec4 trans);
+		static mat4 const     identity;
+		static constexpr mat4 scale(vec4 scale);
+		static mat4           rotate(vec4 axis, float angle);
+		static constexpr mat4 translate(vec4 trans);
 
 		static mat4 persp_proj(float near, float far, float asp_ratio, float fov,
 		                       fov_axis axis = fov_axis::y);
-		static mat4 ortho_proj(float near, float far, float l, float r, float t, float b);
+		static constexpr mat4 ortho_proj(float near, float far, float l, float r, float t,
+		                                 float b);
 
-		mat4();
-		mat4(float arr[4][4]);
-		mat4(float arr[16]);
-		mat4(std::initializer_list<float> arr);
+		constexpr mat4() = default;
+		constexpr mat4(float arr[4][4]);
+		constexpr mat4(float arr[16]);
+		constexpr mat4(std::initializer_list<float> arr);
 
-		float*       operator[](uint8_t i) &;
-		float const* operator[](uint8_t i) const&;
+		constexpr float*       operator[](uint8_t i) &;
+		constexpr float const* operator[](uint8_t i) const&;
 
-		mat4 operator*(mat4 const& other) const;
+		constexpr mat4 operator*(mat4 const& other) const;
 
-		mat4 transpose() const;
+		constexpr mat4 transpose() const;
+		// Expects an invertible matrix
+		constexpr mat4 inverse() const;
 
 		float const* operator[](uint8_t i) const&& = delete;
 
 	private:
-		float arr_[4][4];
+		float arr_[4][4] {};
 	};
 
-}
\ No newline at end of file
+	constexpr mat4::mat4(float arr[4][4])
+	{
+		for (uint32_t i {0}; i < 4; ++i)
+		{
+			for (uint32_t j {0}; j < 4; ++j)
+				arr_[i][j] = arr[i][j];
+		}
+	}
+
+	constexpr mat4::mat4(float arr[16])
+	{
+		for (uint32_t i {0}; i < 16; ++i)
+			arr_[i / 4][i % 4] = arr[i];
+	}
+
+	constexpr mat4::mat4(std::initializer_list<float> arr)
+	{
+		float const* vals = arr.begin();
+		for (uint32_t i {0}; i < 16 && i < arr.size(); ++i)
+			arr_[i / 4][i % 4] = vals[i];
+	}
+
+	VKB_INLINE constexpr float* mat4::operator[](uint8_t i) &
+	{
+		return arr_[i];
+	}
+
+	VKB_INLINE constexpr float const* mat4::operator[](uint8_t i) const&
+	{
+		return arr_[i];
+	}
+
+	// clang-format off
+
+	inline constexpr mat4 mat4::identity {
+		1.f, 0.f, 0.f, 0.f,
+		0.f, 1.f, 0.f, 0.f,
+		0.f, 0.f, 1.f, 0.f,
+		0.f, 0.f, 0.f, 1.f
+	};
+
+	// clang-format on
+
+	constexpr mat4 mat4::scale(vec4 scale)
+	{
+		// clang-format off
+		return {
+			scale.x, 0.f,     0.f,     0.f,
+			0.f,     scale.y, 0.f,     0.f,
+			0.f,     0.f,     scale.z, 0.f,
+			0.f,     0.f,     0.f,     1.f,
+		};
+		// clang-format on
+	}
+
+	inline mat4 mat4::rotate(vec4 axis, float angle)
+	{
+		float a_cos {cosf(angle)};
+		float a_sin {sinf(angle)};
+		float inv_cos {1 - a_cos};
+
+		mat4 res {mat4::identity};
+
+		res[0][0] = axis.x * axis.x * inv_cos + a_cos;
+		res[0][1] = axis.y * axis.x * inv_cos - axis.z * a_sin;
+		res[0][2] = axis.z * axis.x * inv_cos + axis.y * a_sin;
+
+		res[1][0] = axis.x * axis.y * inv_cos + axis.z * a_sin;
+		res[1][1] = axis.y * axis.y * inv_cos + a_cos;
+		res[1][2] = axis.z * axis.y * inv_cos - axis.x * a_sin;
+
+		res[2][0] = axis.x * axis.z * inv_cos - axis.y * a_sin;
+		res[2][1] = axis.y * axis.z * inv_cos + axis.x * a_sin;
+		res[2][2] = axis.z * axis.z * inv_cos + a_cos;
+
+		return res;
+	}
+
+	constexpr mat4 mat4::translate(vec4 trans)
+	{
+		// clang-format off
+		return {
+			1.f, 0.f, 0.f, 0.f,
+			0.f, 1.f, 0.f, 0.f,
+			0.f, 0.f, 1.f, 0.f,
+			trans.x, trans.y, trans.z, 1.f,
+		};
+		// clang-format on
+	}
+
+	inline mat4 mat4::persp_proj(float near, float far, float asp_ratio, float fov,
+	                             fov_axis axis)
+	{
+		float fov_tan = tanf(fov / 2.f);
+		float r;
+		float t;
+		if (axis == fov_axis::y)
+		{
+			t = near * fov_tan;
+			r = t * asp_ratio;
+		}
+		else
+		{
+			r = near * fov_tan;
+			t = r / asp_ratio;
+		}
+
+		float nf = (far) / (far - near);
+		float nf2 = -(far * near) / (far - near);
+
+		// clang-format off
+		return {
+			near / r, 0.f,      0.f, 0.f,
+			0.f,      0.f,      nf,  1.f,
+			0.f,      near / t, 0.f, 0.f,
+			0.f,      0.f,      nf2, 0.f
+		};
+		// clang-format on
+	}
+
+	constexpr mat4 mat4::ortho_proj(float near, float far, float l, float r, float t,
+	                                float b)
+	{
+		float rl = -(r + l) / (r - l);
+		float tb = -(t + b) / (t - b);
+		float nf = 1 / (near - far);
+		float nf2 = (near) / (near - far);
+		// clang-format off
+		return {
+			2 / (r - l), 0.f,          0.f, 0.f,
+			0.f,         0.f,          nf,  0.f,
+			0.f,         2 / (t - b), 0.f, 0.f,
+			rl,          tb,           nf2, 1.f
+		};
+		// clang-format on
+	}
+
+	VKB_INLINE constexpr mat4 mat4::operator*(mat4 const& other) const
+	{
+		mat4 res;
+
+		if (__builtin_is_constant_evaluated())
+		{
+			for (uint32_t i {0}; i < 4; ++i)
+			{
+				for (uint32_t j {0}; j < 4; ++j)
+				{
+					for (uint32_t k {0}; k < 4; ++k)
+						res.arr_[i][j] += arr_[i][k] * other.arr_[k][j];
+				}
+			}
+			return res;
+		}
+
+		simd::f32x4 const o0 = simd::load(other[0]);
+		simd::f32x4 const o1 = simd::load(other[1]);
+		simd::f32x4 const o2 = simd::load(other[2]);
+		simd::f32x4 const o3 = simd::load(other[3]);
+
+		// Row i of the result is row i of this times other
+		for (uint32_t i {0}; i < 4; ++i)
+		{
+			float const* row = arr_[i];
+			simd::f32x4  r = simd::mul(simd::splat(row[0]), o0);
+			r = simd::madd(simd::splat(row[1]), o1, r);
+			r = simd::madd(simd::splat(row[2]), o2, r);
+			r = simd::madd(simd::splat(row[3]), o3, r);
+			simd::store(res.arr_[i], r);
+		}
+
+		return res;
+	}
+
+	VKB_INLINE constexpr mat4 mat4::transpose() const
+	{
+		mat4 res;
+
+		if (__builtin_is_constant_evaluated())
+		{
+			for (uint32_t i {0}; i < 4; ++i)
+			{
+				for (uint32_t j {0}; j < 4; ++j)
+					res.arr_[i][j] = arr_[j][i];
+			}
+			return res;
+		}
+
+		simd::f32x4 r0 = simd::load(arr_[0]);
+		simd::f32x4 r1 = simd::load(arr_[1]);
+		simd::f32x4 r2 = simd::load(arr_[2]);
+		simd::f32x4 r3 = simd::load(arr_[3]);
+		simd::transpose(r0, r1, r2, r3);
+
+		simd::store(res.arr_[0], r0);
+		simd::store(res.arr_[1], r1);
+		simd::store(res.arr_[2], r2);
+		simd::store(res.arr_[3], r3);
+
+		return res;
+	}
+
+	// Laplace expansion along 2x2 sub-determinants, only used outside of hot loops (sky
+	// unprojection, tools) so the scalar version is kept for constant evaluation too
+	constexpr mat4 mat4::inverse() const
+	{
+		float const(&a)[4][4] = arr_;
+
+		float s0 = a[0][0] * a[1][1] - a[1][0] * a[0][1];
+		float s1 = a[0][0] * a[1][2] - a[1][0] * a[0][2];
+		float s2 = a[0][0] * a[1][3] - a[1][0] * a[0][3];
+		float s3 = a[0][1] * a[1][2] - a[1][1] * a[0][2];
+		float s4 = a[0][1] * a[1][3] - a[1][1] * a[0][3];
+		float s5 = a[0][2] * a[1][3] - a[1][2] * a[0][3];
+
+		float c5 = a[2][2] * a[3][3] - a[3][2] * a[2][3];
+		float c4 = a[2][1] * a[3][3] - a[3][1] * a[2][3];
+		float c3 = a[2][1] * a[3][2] - a[3][1] * a[2][2];
+		float c2 = a[2][0] * a[3][3] - a[3][0] * a[2][3];
+		float c1 = a[2][0] * a[3][2] - a[3][0] * a[2][2];
+		float c0 = a[2][0] * a[3][1] - a[3][0] * a[2][1];
+
+		float inv_det =
+			1.f / (s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0);
+
+		// clang-format off
+		return {
+			(a[1][1] * c5 - a[1][2] * c4 + a[1][3] * c3) * inv_det,
+			(-a[0][1] * c5 + a[0][2] * c4 - a[0][3] * c3) * inv_det,
+			(a[3][1] * s5 - a[3][2] * s4 + a[3][3] * s3) * inv_det,
+			(-a[2][1] * s5 + a[2][2] * s4 - a[2][3] * s3) * inv_det,
+
+			(-a[1][0] * c5 + a[1][2] * c2 - a[1][3] * c1) * inv_det,
+			(a[0][0] * c5 - a[0][2] * c2 + a[0][3] * c1) * inv_det,
+			(-a[3][0] * s5 + a[3][2] * s2 - a[3][3] * s1) * inv_det,
+			(a[2][0] * s5 - a[2][2] * s2 + a[2][3] * s1) * inv_det,
+
+			(a[1][0] * c4 - a[1][1] * c2 + a[1][3] * c0) * inv_det,
+			(-a[0][0] * c4 + a[0][1] * c2 - a[0][3] * c0) * inv_det,
+			(a[3][0] * s4 - a[3][1] * s2 + a[3][3] * s0) * inv_det,
+			(-a[2][0] * s4 + a[2][1] * s2 - a[2][3] * s0) * inv_det,
+
+			(-a[1][0] * c3 + a[1][1] * c1 - a[1][2] * c0) * inv_det,
+			(a[0][0] * c3 - a[0][1] * c1 + a[0][2] * c0) * inv_det,
+			(-a[3][0] * s3 + a[3][1] * s1 - a[3][2] * s0) * inv_det,
+			(a[2][0] * s3 - a[2][1] * s1 + a[2][2] * s0) * inv_det,
+		};
+		// clang-format on
+	}
+
+	VKB_INLINE constexpr vec4 vec4::operator*(mat4 const& rhs) const
+	{
+		if (__builtin_is_constant_evaluated())
+		{
+			return {
+				x * rhs[0][0] + y * rhs[1][0] + z * rhs[2][0] + w * rhs[3][0],
+				x * rhs[0][1] + y * rhs[1][1] + z * rhs[2][1] + w * rhs[3][1],
+				x * rhs[0][2] + y * rhs[1][2] + z * rhs[2][2] + w * rhs[3][2],
+				x * rhs[0][3] + y * rhs[1][3] + z * rhs[2][3] + w * rhs[3][3],
+			};
+		}
+
+		simd::f32x4 v = to_reg(*this);
+		simd::f32x4 res = simd::mul(simd::splat<0>(v), simd::load(rhs[0]));
+		res = simd::madd(simd::splat<1>(v), simd::load(rhs[1]), res);
+		res = simd::madd(simd::splat<2>(v), simd::load(rhs[2]), res);
+		res = simd::madd(simd::splat<3>(v), simd::load(rhs[3]), res);
+
+		return from_reg(res);
+	}
+
+	VKB_INLINE constexpr vec4& vec4::operator*=(mat4 const& rhs)
+	{
+		return *this = *this * rhs;
+	}
+}
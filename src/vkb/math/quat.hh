@@ -1,25 +1,188 @@
 #pragma once
 
+#include "mat4.hh"
+#include "simd.hh"
 #include "vec4.hh"
 
+#include <math.h>
+
 namespace vkb
 {
-	class mat4;
-
 	struct quat
 	{
 		static quat angle_axis(vec4 axis, float angle);
 		static quat euler(vec4 euler);
+		// Constant angular velocity between unit quaternions, along the shortest arc
+		static quat slerp(quat a, quat b, float t);
 
-		quat operator*(quat quat) const;
+		constexpr quat operator*(quat quat) const;
 		operator mat4() const;
 
-		vec4 rotate(vec4 vec) const;
-		quat inverse() const;
+		vec4           rotate(vec4 vec) const;
+		constexpr quat inverse() const;
 
 		float w {0.f};
 		float x {0.f};
 		float y {0.f};
 		float z {0.f};
 	};
-}
\ No newline at end of file
+
+	// Lanes are (w, x, y, z)
+	VKB_INLINE simd::f32x4 to_reg(quat q)
+	{
+		return simd::load(&q.w);
+	}
+
+	VKB_INLINE quat quat_from_reg(simd::f32x4 reg)
+	{
+		quat res;
+		simd::store(&res.w, reg);
+		return res;
+	}
+
+	inline quat quat::angle_axis(vec4 axis, float angle)
+	{
+		float a_sin {sinf(angle / 2.f)};
+		return {
+			cosf(angle / 2.f),
+			a_sin * axis.x,
+			a_sin * axis.y,
+			a_sin * axis.z,
+		};
+	}
+
+	inline quat quat::euler(vec4 euler)
+	{
+		float x_cos {cosf(euler.x / 2.f)};
+		float y_cos {cosf(euler.y / 2.f)};
+		float z_cos {cosf(euler.z / 2.f)};
+		float x_sin {sinf(euler.x / 2.f)};
+		float y_sin {sinf(euler.y / 2.f)};
+		float z_sin {sinf(euler.z / 2.f)};
+
+		return {
+			(x_cos * y_cos * z_cos) - (x_sin * y_sin * z_sin),
+			(x_sin * y_cos * z_cos) + (x_cos * y_sin * z_sin),
+			(x_cos * y_sin * z_cos) + (x_sin * y_cos * z_sin),
+			(x_cos * y_cos * z_sin) - (x_sin * y_sin * z_cos),
+		};
+	}
+
+	inline quat quat::slerp(quat a, quat b, float t)
+	{
+		simd::f32x4 ra = to_reg(a);
+		simd::f32x4 rb = to_reg(b);
+
+		float cos_angle = simd::first(simd::dot4(ra, rb));
+		if (cos_angle < 0.f)
+		{
+			rb = simd::mul(rb, simd::splat(-1.f));
+			cos_angle = -cos_angle;
+		}
+
+		// Nearly parallel, sin(angle) is too small to divide by and a normalized lerp is
+		// as accurate
+		if (cos_angle > .9995f)
+		{
+			simd::f32x4 res = simd::madd(simd::sub(rb, ra), simd::splat(t), ra);
+			return quat_from_reg(simd::div(res, simd::sqrt(simd::dot4(res, res))));
+		}
+
+		float angle = acosf(cos_angle);
+		float inv_sin = 1.f / sinf(angle);
+		simd::f32x4 wa = simd::splat(sinf((1.f - t) * angle) * inv_sin);
+		simd::f32x4 wb = simd::splat(sinf(t * angle) * inv_sin);
+
+		return quat_from_reg(simd::madd(ra, wa, simd::mul(rb, wb)));
+	}
+
+	VKB_INLINE constexpr quat quat::operator*(quat quat) const
+	{
+		if (__builtin_is_constant_evaluated())
+		{
+			return {
+				w * quat.w - x * quat.x - y * quat.y - z * quat.z,
+				w * quat.x + x * quat.w - y * quat.z + z * quat.y,
+				w * quat.y + x * quat.z + y * quat.w - z * quat.x,
+				w * quat.z - x * quat.y + y * quat.x + z * quat.w,
+			};
+		}
+
+		simd::f32x4 a = to_reg(*this);
+		simd::f32x4 b = to_reg(quat);
+
+		simd::f32x4 res = simd::mul(simd::splat<0>(a), b);
+		res = simd::madd(simd::mul(simd::splat<1>(a), simd::shuffle<1, 0, 3, 2>(b)),
+		                 simd::set(-1.f, 1.f, 1.f, -1.f), res);
+		res = simd::madd(simd::mul(simd::splat<2>(a), simd::shuffle<2, 3, 0, 1>(b)),
+		                 simd::set(-1.f, -1.f, 1.f, 1.f), res);
+		res = simd::madd(simd::mul(simd::splat<3>(a), simd::shuffle<3, 2, 1, 0>(b)),
+		                 simd::set(-1.f, 1.f, -1.f, 1.f), res);
+
+		return quat_from_reg(res);
+	}
+
+	VKB_INLINE quat::operator mat4() const
+	{
+		// Lanes are (w, x, y, z), rows are built as identity + 2 * (q_i * q_perm)
+		simd::f32x4 q = to_reg(*this);
+		simd::f32x4 q2 = simd::add(q, q);
+		simd::f32x4 x2 = simd::splat<1>(q2);
+		simd::f32x4 y2 = simd::splat<2>(q2);
+		simd::f32x4 z2 = simd::splat<3>(q2);
+
+		simd::f32x4 r0 = simd::mul(simd::mul(y2, simd::shuffle<2, 1, 0, 0>(q)),
+		                           simd::set(-1.f, 1.f, 1.f, 0.f));
+		r0 = simd::madd(simd::mul(z2, simd::shuffle<3, 0, 1, 0>(q)),
+		                simd::set(-1.f, -1.f, 1.f, 0.f), r0);
+
+		simd::f32x4 r1 = simd::mul(simd::mul(x2, simd::shuffle<2, 1, 0, 0>(q)),
+		                           simd::set(1.f, -1.f, -1.f, 0.f));
+		r1 = simd::madd(simd::mul(z2, simd::shuffle<0, 3, 2, 0>(q)),
+		                simd::set(1.f, -1.f, 1.f, 0.f), r1);
+
+		simd::f32x4 r2 = simd::mul(simd::mul(x2, simd::shuffle<3, 0, 1, 0>(q)),
+		                           simd::set(1.f, 1.f, -1.f, 0.f));
+		r2 = simd::madd(simd::mul(y2, simd::shuffle<0, 3, 2, 0>(q)),
+		                simd::set(-1.f, 1.f, -1.f, 0.f), r2);
+
+		float res[4][4];
+		simd::store(res[0], simd::add(r0, simd::set(1.f, 0.f, 0.f, 0.f)));
+		simd::store(res[1], simd::add(r1, simd::set(0.f, 1.f, 0.f, 0.f)));
+		simd::store(res[2], simd::add(r2, simd::set(0.f, 0.f, 1.f, 0.f)));
+		simd::store(res[3], simd::set(0.f, 0.f, 0.f, 1.f));
+
+		return {res};
+	}
+
+	VKB_INLINE vec4 quat::rotate(vec4 vec) const
+	{
+		simd::f32x4 q = to_reg(*this);
+		simd::f32x4 v = to_reg(vec);
+		// (x, y, z, 0)
+		simd::f32x4 qv =
+			simd::mul(simd::shuffle<1, 2, 3, 0>(q), simd::set(1.f, 1.f, 1.f, 0.f));
+		simd::f32x4 qw = simd::splat<0>(q);
+
+		simd::f32x4 two = simd::splat(2.f);
+		simd::f32x4 res = simd::mul(qv, simd::mul(two, simd::dot4(qv, v)));
+		res = simd::madd(v, simd::sub(simd::mul(qw, qw), simd::dot4(qv, qv)), res);
+		res = simd::madd(simd::cross3(qv, v), simd::mul(two, qw), res);
+
+		return from_reg(res);
+	}
+
+	VKB_INLINE constexpr quat quat::inverse() const
+	{
+		if (__builtin_is_constant_evaluated())
+		{
+			float sq_len = w * w + x * x + y * y + z * z;
+			return {w / sq_len, -x / sq_len, -y / sq_len, -z / sq_len};
+		}
+
+		simd::f32x4 q = to_reg(*this);
+
+		return quat_from_reg(simd::div(simd::mul(q, simd::set(1.f, -1.f, -1.f, -1.f)),
+		                               simd::dot4(q, q)));
+	}
+}
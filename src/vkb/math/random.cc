@@ -0,0 +1,192 @@
+#include "random.hh"
+
+#include "trig.hh"
+
+#include <math.h>
+
+namespace vkb::math
+{
+	namespace
+	{
+		uint64_t global_seed {0};
+		uint32_t next_thread_stream {0};
+
+		thread_local rng  local_rng {0};
+		thread_local bool local_seeded {false};
+
+		// Expands 64 bits of seed into well mixed state
+		uint64_t splitmix64(uint64_t& x)
+		{
+			uint64_t z = (x += 0x9e37'79b9'7f4a'7c15);
+			z = (z ^ (z >> 30)) * 0xbf58'476d'1ce4'e5b9;
+			z = (z ^ (z >> 27)) * 0x94d0'49bb'1331'11eb;
+			return z ^ (z >> 31);
+		}
+
+		// sin and cos of a in [-pi / 2, pi / 2], Taylor polynomials of degree 11 and 12
+		// whose error is below float precision on that range
+		void sin_cos(simd::f32x4 a, simd::f32x4& s, simd::f32x4& c)
+		{
+			simd::f32x4 const one = simd::splat(1.f);
+			simd::f32x4 const a2 = simd::mul(a, a);
+
+			s = simd::sub(one, simd::mul(a2, simd::splat(1.f / 110.f)));
+			s = simd::sub(one, simd::mul(simd::mul(a2, simd::splat(1.f / 72.f)), s));
+			s = simd::sub(one, simd::mul(simd::mul(a2, simd::splat(1.f / 42.f)), s));
+			s = simd::sub(one, simd::mul(simd::mul(a2, simd::splat(1.f / 20.f)), s));
+			s = simd::sub(one, simd::mul(simd::mul(a2, simd::splat(1.f / 6.f)), s));
+			s = simd::mul(a, s);
+
+			c = simd::sub(one, simd::mul(a2, simd::splat(1.f / 132.f)));
+			c = simd::sub(one, simd::mul(simd::mul(a2, simd::splat(1.f / 90.f)), c));
+			c = simd::sub(one, simd::mul(simd::mul(a2, simd::splat(1.f / 56.f)), c));
+			c = simd::sub(one, simd::mul(simd::mul(a2, simd::splat(1.f / 30.f)), c));
+			c = simd::sub(one, simd::mul(simd::mul(a2, simd::splat(1.f / 12.f)), c));
+			c = simd::sub(one, simd::mul(simd::mul(a2, simd::splat(1.f / 2.f)), c));
+		}
+	}
+
+	rng::rng(uint64_t seed, uint32_t stream)
+	{
+		uint64_t x {seed};
+		uint64_t a = splitmix64(x);
+		uint64_t b = splitmix64(x);
+		s_[0] = static_cast<uint32_t>(a);
+		s_[1] = static_cast<uint32_t>(a >> 32);
+		s_[2] = static_cast<uint32_t>(b);
+		s_[3] = static_cast<uint32_t>(b >> 32);
+
+		for (uint32_t i {0}; i < stream; ++i)
+			jump();
+	}
+
+	vec4 rng::sphere_point()
+	{
+		// Uniform height and angle around the axis (Archimedes' hat-box theorem)
+		float z = next_float(-1.f, 1.f);
+		float angle = next_float(-pi, pi);
+		float r = sqrtf(1.f - z * z);
+
+		return {r * cosf(angle), r * sinf(angle), z, 1.f};
+	}
+
+	void rng::jump()
+	{
+		constexpr uint32_t poly[4] {0x8764'000b, 0xf542'd2d3, 0x6fa0'35c3, 0x77f2'db5b};
+
+		uint32_t s[4] {0};
+		for (uint32_t word : poly)
+		{
+			for (uint32_t b {0}; b < 32; ++b)
+			{
+				if (word & (1u << b))
+				{
+					for (uint32_t i {0}; i < 4; ++i)
+						s[i] ^= s_[i];
+				}
+				next_u32();
+			}
+		}
+
+		for (uint32_t i {0}; i < 4; ++i)
+			s_[i] = s[i];
+	}
+
+	rng_x4::rng_x4(uint64_t seed, uint32_t first_stream)
+	{
+		rng gen {seed, first_stream};
+
+		uint32_t lanes[4][4];
+		for (uint32_t lane {0}; lane < 4; ++lane)
+		{
+			for (uint32_t i {0}; i < 4; ++i)
+				lanes[i][lane] = gen.s_[i];
+			gen.jump();
+		}
+
+		for (uint32_t i {0}; i < 4; ++i)
+			s_[i] = simd::load(lanes[i]);
+	}
+
+	void rng_x4::fill_floats(float* out, uint32_t count, float min, float max)
+	{
+		simd::f32x4 const base = simd::splat(min);
+		simd::f32x4 const range = simd::splat(max - min);
+
+		uint32_t i {0};
+		for (; i + 4 <= count; i += 4)
+			simd::store(out + i, simd::madd(next_float(), range, base));
+
+		if (i < count)
+		{
+			float tail[4];
+			simd::store(tail, simd::madd(next_float(), range, base));
+			for (uint32_t j {0}; i < count; ++i, ++j)
+				out[i] = tail[j];
+		}
+	}
+
+	void rng_x4::fill_sphere_points(float* x, float* y, float* z, uint32_t count)
+	{
+		simd::f32x4 const one = simd::splat(1.f);
+		simd::f32x4 const two = simd::splat(2.f);
+		simd::f32x4 const pi_x4 = simd::splat(static_cast<float>(pi));
+		simd::f32x4 const half_pi = simd::splat(static_cast<float>(pi / 2.0));
+
+		for (uint32_t i {0}; i < count; i += 4)
+		{
+			simd::f32x4 h = simd::sub(simd::mul(next_float(), two), one);
+			simd::f32x4 r = simd::sqrt(simd::sub(one, simd::mul(h, h)));
+
+			// Half of the angle, doubled with sin(2a) = 2 sin(a) cos(a) and
+			// cos(2a) = 1 - 2 sin(a)^2 to stay on the range of sin_cos
+			simd::f32x4 a = simd::sub(simd::mul(next_float(), pi_x4), half_pi);
+			simd::f32x4 s;
+			simd::f32x4 c;
+			sin_cos(a, s, c);
+
+			simd::f32x4 cos_2a = simd::sub(one, simd::mul(two, simd::mul(s, s)));
+			simd::f32x4 sin_2a = simd::mul(two, simd::mul(s, c));
+			simd::f32x4 px = simd::mul(r, cos_2a);
+			simd::f32x4 py = simd::mul(r, sin_2a);
+
+			if (i + 4 <= count)
+			{
+				simd::store(x + i, px);
+				simd::store(y + i, py);
+				simd::store(z + i, h);
+				continue;
+			}
+
+			float tail[3][4];
+			simd::store(tail[0], px);
+			simd::store(tail[1], py);
+			simd::store(tail[2], h);
+			for (uint32_t j {0}; i + j < count; ++j)
+			{
+				x[i + j] = tail[0][j];
+				y[i + j] = tail[1][j];
+				z[i + j] = tail[2][j];
+			}
+		}
+	}
+
+	void seed(uint64_t seed)
+	{
+		__atomic_store_n(&global_seed, seed, __ATOMIC_RELAXED);
+		__atomic_store_n(&next_thread_stream, 0, __ATOMIC_RELAXED);
+	}
+
+	rng& thread_rng()
+	{
+		if (!local_seeded)
+		{
+			uint32_t stream =
+				__atomic_fetch_add(&next_thread_stream, 1, __ATOMIC_RELAXED);
+			local_rng = rng {__atomic_load_n(&global_seed, __ATOMIC_RELAXED), stream};
+			local_seeded = true;
+		}
+
+		return local_rng;
+	}
+}
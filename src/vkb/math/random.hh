@@ -0,0 +1,124 @@
+#pragma once
+
+#include "simd.hh"
+#include "vec4.hh"
+
+#include <stdint.h>
+
+// xoshiro128** ("Scrambled Linear Pseudorandom Number Generators", Blackman and Vigna
+// 2018), 16 bytes of state. Generators are not thread safe, each thread draws from its
+// own: thread_rng, or streams of a shared seed for deterministic parallel generation.
+namespace vkb::math
+{
+	class rng
+	{
+	public:
+		// Streams of a seed don't overlap for 2^64 draws
+		explicit rng(uint64_t seed, uint32_t stream = 0);
+
+		uint32_t next_u32();
+		// [0, bound), with a bias below bound / 2^32
+		uint32_t next_below(uint32_t bound);
+		// [0, 1)
+		float    next_float();
+		// [min, max)
+		float    next_float(float min, float max);
+		// Uniform on the unit sphere, w is 1
+		vec4     sphere_point();
+
+		// Advances by 2^64 draws, to the next stream
+		void jump();
+
+	private:
+		friend class rng_x4;
+
+		uint32_t s_[4];
+	};
+
+	// 4 generators advanced together, lane i is stream first_stream + i of the seed.
+	// Throughput version of rng for large procedural batches.
+	class rng_x4
+	{
+	public:
+		explicit rng_x4(uint64_t seed, uint32_t first_stream = 0);
+
+		simd::u32x4 next_u32();
+		// [0, 1)
+		simd::f32x4 next_float();
+
+		// [min, max)
+		void fill_floats(float* out, uint32_t count, float min, float max);
+		// Uniform on the unit sphere, one array per component
+		void fill_sphere_points(float* x, float* y, float* z, uint32_t count);
+
+	private:
+		simd::u32x4 s_[4];
+	};
+
+	// Seed of the thread generators, to call before any thread draws from them
+	void seed(uint64_t seed);
+	// Generator of the calling thread, stream n of the seed for the nth thread to call
+	// it, so only the first thread's draws are reproducible across runs
+	rng& thread_rng();
+
+	namespace detail
+	{
+		VKB_INLINE uint32_t rotl(uint32_t x, int n)
+		{
+			return (x << n) | (x >> (32 - n));
+		}
+	}
+
+	VKB_INLINE uint32_t rng::next_u32()
+	{
+		uint32_t const res = detail::rotl(s_[1] * 5, 7) * 9;
+		uint32_t const t = s_[1] << 9;
+
+		s_[2] ^= s_[0];
+		s_[3] ^= s_[1];
+		s_[1] ^= s_[2];
+		s_[0] ^= s_[3];
+		s_[2] ^= t;
+		s_[3] = detail::rotl(s_[3], 11);
+
+		return res;
+	}
+
+	VKB_INLINE uint32_t rng::next_below(uint32_t bound)
+	{
+		return static_cast<uint32_t>((static_cast<uint64_t>(next_u32()) * bound) >> 32);
+	}
+
+	VKB_INLINE float rng::next_float()
+	{
+		return (next_u32() >> 8) * (1.f / 16'777'216.f);
+	}
+
+	VKB_INLINE float rng::next_float(float min, float max)
+	{
+		return min + (max - min) * next_float();
+	}
+
+	VKB_INLINE simd::u32x4 rng_x4::next_u32()
+	{
+		// Multiplications by 5 and 9 as shifts and adds, SSE2 has no 32 bit multiply
+		simd::u32x4 x5 = simd::add(simd::shl<2>(s_[1]), s_[1]);
+		simd::u32x4 r = simd::rotl<7>(x5);
+		simd::u32x4 const res = simd::add(simd::shl<3>(r), r);
+		simd::u32x4 const t = simd::shl<9>(s_[1]);
+
+		s_[2] = simd::bit_xor(s_[2], s_[0]);
+		s_[3] = simd::bit_xor(s_[3], s_[1]);
+		s_[1] = simd::bit_xor(s_[1], s_[2]);
+		s_[0] = simd::bit_xor(s_[0], s_[3]);
+		s_[2] = simd::bit_xor(s_[2], t);
+		s_[3] = simd::rotl<11>(s_[3]);
+
+		return res;
+	}
+
+	VKB_INLINE simd::f32x4 rng_x4::next_float()
+	{
+		return simd::to_unit_float(next_u32());
+	}
+}
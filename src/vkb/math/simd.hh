@@ -0,0 +1,393 @@
+#pragma once
+
+// Registers of 4 floats backing vec4, mat4 rows and quat. Defining VKB_MATH_SCALAR
+// forces the portable fallback, to compare results or debug.
+#if !defined(VKB_MATH_SCALAR) && defined(__SSE2__)
+#include <immintrin.h>
+#define VKB_SIMD_SSE
+#elif !defined(VKB_MATH_SCALAR) && defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define VKB_SIMD_NEON
+#endif
+
+#include <math.h>
+#include <stdint.h>
+
+// Math operations are a few instructions, a call would cost more than their body
+#define VKB_INLINE __attribute__((always_inline)) inline
+
+namespace vkb::simd
+{
+#if defined(VKB_SIMD_SSE)
+	using f32x4 = __m128;
+#elif defined(VKB_SIMD_NEON)
+	using f32x4 = float32x4_t;
+#else
+	struct f32x4
+	{
+		float v[4];
+	};
+#endif
+
+#if defined(VKB_SIMD_SSE)
+	using u32x4 = __m128i;
+#elif defined(VKB_SIMD_NEON)
+	using u32x4 = uint32x4_t;
+#else
+	struct u32x4
+	{
+		uint32_t v[4];
+	};
+#endif
+
+	// Unaligned, vec4 and mat4 keep their natural alignment so that the layouts
+	// shared with the GPU don't change
+	VKB_INLINE f32x4 load(float const* src)
+	{
+#if defined(VKB_SIMD_SSE)
+		return _mm_loadu_ps(src);
+#elif defined(VKB_SIMD_NEON)
+		return vld1q_f32(src);
+#else
+		return {src[0], src[1], src[2], src[3]};
+#endif
+	}
+
+	VKB_INLINE void store(float* dst, f32x4 a)
+	{
+#if defined(VKB_SIMD_SSE)
+		_mm_storeu_ps(dst, a);
+#elif defined(VKB_SIMD_NEON)
+		vst1q_f32(dst, a);
+#else
+		for (int i {0}; i < 4; ++i)
+			dst[i] = a.v[i];
+#endif
+	}
+
+	VKB_INLINE f32x4 set(float x, float y, float z, float w)
+	{
+#if defined(VKB_SIMD_SSE)
+		return _mm_setr_ps(x, y, z, w);
+#elif defined(VKB_SIMD_NEON)
+		float const arr[4] {x, y, z, w};
+		return vld1q_f32(arr);
+#else
+		return {x, y, z, w};
+#endif
+	}
+
+	VKB_INLINE f32x4 splat(float s)
+	{
+#if defined(VKB_SIMD_SSE)
+		return _mm_set1_ps(s);
+#elif defined(VKB_SIMD_NEON)
+		return vdupq_n_f32(s);
+#else
+		return {s, s, s, s};
+#endif
+	}
+
+	VKB_INLINE float first(f32x4 a)
+	{
+#if defined(VKB_SIMD_SSE)
+		return _mm_cvtss_f32(a);
+#elif defined(VKB_SIMD_NEON)
+		return vgetq_lane_f32(a, 0);
+#else
+		return a.v[0];
+#endif
+	}
+
+	// Lanes (a[i0], a[i1], a[i2], a[i3])
+	template <int i0, int i1, int i2, int i3>
+	VKB_INLINE f32x4 shuffle(f32x4 a)
+	{
+#if defined(VKB_SIMD_SSE)
+		return _mm_shuffle_ps(a, a, _MM_SHUFFLE(i3, i2, i1, i0));
+#elif defined(VKB_SIMD_NEON)
+		return __builtin_shufflevector(a, a, i0, i1, i2, i3);
+#else
+		return {a.v[i0], a.v[i1], a.v[i2], a.v[i3]};
+#endif
+	}
+
+	template <int i>
+	VKB_INLINE f32x4 splat(f32x4 a)
+	{
+#if defined(VKB_SIMD_NEON)
+		return vdupq_laneq_f32(a, i);
+#else
+		return shuffle<i, i, i, i>(a);
+#endif
+	}
+
+#if defined(VKB_SIMD_SSE)
+	VKB_INLINE f32x4 add(f32x4 a, f32x4 b)
+	{
+		return _mm_add_ps(a, b);
+	}
+
+	VKB_INLINE f32x4 sub(f32x4 a, f32x4 b)
+	{
+		return _mm_sub_ps(a, b);
+	}
+
+	VKB_INLINE f32x4 mul(f32x4 a, f32x4 b)
+	{
+		return _mm_mul_ps(a, b);
+	}
+
+	VKB_INLINE f32x4 div(f32x4 a, f32x4 b)
+	{
+		return _mm_div_ps(a, b);
+	}
+
+	VKB_INLINE f32x4 sqrt(f32x4 a)
+	{
+		return _mm_sqrt_ps(a);
+	}
+#elif defined(VKB_SIMD_NEON)
+	VKB_INLINE f32x4 add(f32x4 a, f32x4 b)
+	{
+		return vaddq_f32(a, b);
+	}
+
+	VKB_INLINE f32x4 sub(f32x4 a, f32x4 b)
+	{
+		return vsubq_f32(a, b);
+	}
+
+	VKB_INLINE f32x4 mul(f32x4 a, f32x4 b)
+	{
+		return vmulq_f32(a, b);
+	}
+
+	VKB_INLINE f32x4 div(f32x4 a, f32x4 b)
+	{
+		return vdivq_f32(a, b);
+	}
+
+	VKB_INLINE f32x4 sqrt(f32x4 a)
+	{
+		return vsqrtq_f32(a);
+	}
+#else
+	VKB_INLINE f32x4 add(f32x4 a, f32x4 b)
+	{
+		return {a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3]};
+	}
+
+	VKB_INLINE f32x4 sub(f32x4 a, f32x4 b)
+	{
+		return {a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3]};
+	}
+
+	VKB_INLINE f32x4 mul(f32x4 a, f32x4 b)
+	{
+		return {a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3]};
+	}
+
+	VKB_INLINE f32x4 div(f32x4 a, f32x4 b)
+	{
+		return {a.v[0] / b.v[0], a.v[1] / b.v[1], a.v[2] / b.v[2], a.v[3] / b.v[3]};
+	}
+
+	VKB_INLINE f32x4 sqrt(f32x4 a)
+	{
+		return {sqrtf(a.v[0]), sqrtf(a.v[1]), sqrtf(a.v[2]), sqrtf(a.v[3])};
+	}
+#endif
+
+	VKB_INLINE f32x4 abs(f32x4 a)
+	{
+#if defined(VKB_SIMD_SSE)
+		return _mm_andnot_ps(_mm_set1_ps(-0.f), a);
+#elif defined(VKB_SIMD_NEON)
+		return vabsq_f32(a);
+#else
+		return {fabsf(a.v[0]), fabsf(a.v[1]), fabsf(a.v[2]), fabsf(a.v[3])};
+#endif
+	}
+
+	// a * b + c, fused when the target has FMA
+	VKB_INLINE f32x4 madd(f32x4 a, f32x4 b, f32x4 c)
+	{
+#if defined(VKB_SIMD_SSE) && defined(__FMA__)
+		return _mm_fmadd_ps(a, b, c);
+#elif defined(VKB_SIMD_NEON)
+		return vfmaq_f32(c, a, b);
+#else
+		return add(mul(a, b), c);
+#endif
+	}
+
+	// Dot products, broadcast to all lanes
+	VKB_INLINE f32x4 dot4(f32x4 a, f32x4 b)
+	{
+#if defined(VKB_SIMD_SSE) && defined(__SSE4_1__)
+		return _mm_dp_ps(a, b, 0xff);
+#elif defined(VKB_SIMD_SSE)
+		f32x4 m = _mm_mul_ps(a, b);
+		m = _mm_add_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(2, 3, 0, 1)));
+		return _mm_add_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(1, 0, 3, 2)));
+#elif defined(VKB_SIMD_NEON)
+		return vdupq_n_f32(vaddvq_f32(vmulq_f32(a, b)));
+#else
+		return splat(a.v[0] * b.v[0] + a.v[1] * b.v[1] + a.v[2] * b.v[2] +
+		             a.v[3] * b.v[3]);
+#endif
+	}
+
+	VKB_INLINE f32x4 dot3(f32x4 a, f32x4 b)
+	{
+#if defined(VKB_SIMD_SSE) && defined(__SSE4_1__)
+		return _mm_dp_ps(a, b, 0x7f);
+#elif defined(VKB_SIMD_NEON)
+		return vdupq_n_f32(vaddvq_f32(vsetq_lane_f32(0.f, vmulq_f32(a, b), 3)));
+#else
+		f32x4 m = mul(a, b);
+		return add(add(splat<0>(m), splat<1>(m)), splat<2>(m));
+#endif
+	}
+
+	// Cross product of the first 3 lanes, 0 in the last one
+	VKB_INLINE f32x4 cross3(f32x4 a, f32x4 b)
+	{
+		f32x4 a_yzx = shuffle<1, 2, 0, 3>(a);
+		f32x4 b_yzx = shuffle<1, 2, 0, 3>(b);
+		f32x4 c = sub(mul(a, b_yzx), mul(a_yzx, b));
+		return shuffle<1, 2, 0, 3>(c);
+	}
+
+	VKB_INLINE void transpose(f32x4& r0, f32x4& r1, f32x4& r2, f32x4& r3)
+	{
+#if defined(VKB_SIMD_SSE)
+		_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+#elif defined(VKB_SIMD_NEON)
+		float32x4x2_t t01 = vtrnq_f32(r0, r1);
+		float32x4x2_t t23 = vtrnq_f32(r2, r3);
+		r0 = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+		r1 = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+		r2 = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+		r3 = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+#else
+		f32x4 rows[4] {r0, r1, r2, r3};
+		for (int i {0}; i < 4; ++i)
+		{
+			for (int j {i + 1}; j < 4; ++j)
+			{
+				float tmp = rows[i].v[j];
+				rows[i].v[j] = rows[j].v[i];
+				rows[j].v[i] = tmp;
+			}
+		}
+		r0 = rows[0];
+		r1 = rows[1];
+		r2 = rows[2];
+		r3 = rows[3];
+#endif
+	}
+
+	// Integer lanes, wrapping arithmetic
+
+	VKB_INLINE u32x4 load(uint32_t const* src)
+	{
+#if defined(VKB_SIMD_SSE)
+		return _mm_loadu_si128(reinterpret_cast<__m128i const*>(src));
+#elif defined(VKB_SIMD_NEON)
+		return vld1q_u32(src);
+#else
+		return {src[0], src[1], src[2], src[3]};
+#endif
+	}
+
+	VKB_INLINE void store(uint32_t* dst, u32x4 a)
+	{
+#if defined(VKB_SIMD_SSE)
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), a);
+#elif defined(VKB_SIMD_NEON)
+		vst1q_u32(dst, a);
+#else
+		for (int i {0}; i < 4; ++i)
+			dst[i] = a.v[i];
+#endif
+	}
+
+	VKB_INLINE u32x4 add(u32x4 a, u32x4 b)
+	{
+#if defined(VKB_SIMD_SSE)
+		return _mm_add_epi32(a, b);
+#elif defined(VKB_SIMD_NEON)
+		return vaddq_u32(a, b);
+#else
+		return {a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3]};
+#endif
+	}
+
+	VKB_INLINE u32x4 bit_or(u32x4 a, u32x4 b)
+	{
+#if defined(VKB_SIMD_SSE)
+		return _mm_or_si128(a, b);
+#elif defined(VKB_SIMD_NEON)
+		return vorrq_u32(a, b);
+#else
+		return {a.v[0] | b.v[0], a.v[1] | b.v[1], a.v[2] | b.v[2], a.v[3] | b.v[3]};
+#endif
+	}
+
+	VKB_INLINE u32x4 bit_xor(u32x4 a, u32x4 b)
+	{
+#if defined(VKB_SIMD_SSE)
+		return _mm_xor_si128(a, b);
+#elif defined(VKB_SIMD_NEON)
+		return veorq_u32(a, b);
+#else
+		return {a.v[0] ^ b.v[0], a.v[1] ^ b.v[1], a.v[2] ^ b.v[2], a.v[3] ^ b.v[3]};
+#endif
+	}
+
+	template <int n>
+	VKB_INLINE u32x4 shl(u32x4 a)
+	{
+#if defined(VKB_SIMD_SSE)
+		return _mm_slli_epi32(a, n);
+#elif defined(VKB_SIMD_NEON)
+		return vshlq_n_u32(a, n);
+#else
+		return {a.v[0] << n, a.v[1] << n, a.v[2] << n, a.v[3] << n};
+#endif
+	}
+
+	template <int n>
+	VKB_INLINE u32x4 shr(u32x4 a)
+	{
+#if defined(VKB_SIMD_SSE)
+		return _mm_srli_epi32(a, n);
+#elif defined(VKB_SIMD_NEON)
+		return vshrq_n_u32(a, n);
+#else
+		return {a.v[0] >> n, a.v[1] >> n, a.v[2] >> n, a.v[3] >> n};
+#endif
+	}
+
+	template <int n>
+	VKB_INLINE u32x4 rotl(u32x4 a)
+	{
+		return bit_or(shl<n>(a), shr<32 - n>(a));
+	}
+
+	// Top 24 bits as a float in [0, 1), all of them are exactly representable
+	VKB_INLINE f32x4 to_unit_float(u32x4 a)
+	{
+#if defined(VKB_SIMD_SSE)
+		f32x4 f = _mm_cvtepi32_ps(_mm_srli_epi32(a, 8));
+#elif defined(VKB_SIMD_NEON)
+		f32x4 f = vcvtq_f32_u32(vshrq_n_u32(a, 8));
+#else
+		f32x4 f {static_cast<float>(a.v[0] >> 8), static_cast<float>(a.v[1] >> 8),
+		         static_cast<float>(a.v[2] >> 8), static_cast<float>(a.v[3] >> 8)};
+#endif
+		return mul(f, splat(1.f / 16'777'216.f));
+	}
+}
@@ -2,6 +2,15 @@
 
 namespace vkb
 {
-	float deg(float rad);
-	float rad(float deg);
-}
\ No newline at end of file
+	constexpr double pi {3.14159265358979323846};
+
+	constexpr float deg(float rad)
+	{
+		return rad * 180 * (1 / pi);
+	}
+
+	constexpr float rad(float deg)
+	{
+		return deg * pi / 180.0;
+	}
+}
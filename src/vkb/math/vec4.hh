@@ -1,43 +1,48 @@
 #pragma once
 
+#include "simd.hh"
+
+#include <math.h>
+
 namespace vkb
 {
 	class mat4;
 
 	struct vec4
 	{
-		vec4  operator+(vec4 rhs) const;
-		vec4& operator+=(vec4 rhs);
-		vec4  operator+(float rhs) const;
-		vec4& operator+=(float rhs);
+		constexpr vec4  operator+(vec4 rhs) const;
+		constexpr vec4& operator+=(vec4 rhs);
+		constexpr vec4  operator+(float rhs) const;
+		constexpr vec4& operator+=(float rhs);
 
-		vec4  operator-() const;
-		vec4  operator-(vec4 rhs) const;
-		vec4& operator-=(vec4 rhs);
-		vec4  operator-(float rhs) const;
-		vec4& operator-=(float rhs);
+		constexpr vec4  operator-() const;
+		constexpr vec4  operator-(vec4 rhs) const;
+		constexpr vec4& operator-=(vec4 rhs);
+		constexpr vec4  operator-(float rhs) const;
+		constexpr vec4& operator-=(float rhs);
 
-		vec4  operator*(mat4 const& rhs) const;
-		vec4& operator*=(mat4 const& rhs);
-		vec4  operator*(vec4 rhs) const;
-		vec4& operator*=(vec4 rhs);
-		vec4  operator*(float rhs) const;
-		vec4& operator*=(float rhs);
+		// Defined in mat4.hh
+		constexpr vec4  operator*(mat4 const& rhs) const;
+		constexpr vec4& operator*=(mat4 const& rhs);
+		constexpr vec4  operator*(vec4 rhs) const;
+		constexpr vec4& operator*=(vec4 rhs);
+		constexpr vec4  operator*(float rhs) const;
+		constexpr vec4& operator*=(float rhs);
 
-		vec4  operator/(vec4 rhs) const;
-		vec4& operator/=(vec4 rhs);
-		vec4  operator/(float rhs) const;
-		vec4& operator/=(float rhs);
+		constexpr vec4  operator/(vec4 rhs) const;
+		constexpr vec4& operator/=(vec4 rhs);
+		constexpr vec4  operator/(float rhs) const;
+		constexpr vec4& operator/=(float rhs);
 
-		vec4 cross3(vec4 vec) const;
+		constexpr vec4 cross3(vec4 vec) const;
 
-		vec4  norm() const;
-		vec4  norm3() const;
-		float dot(vec4 vec) const;
-		float dot3(vec4 vec) const;
+		vec4            norm() const;
+		vec4            norm3() const;
+		constexpr float dot(vec4 vec) const;
+		constexpr float dot3(vec4 vec) const;
 
-		float sq_len() const;
-		float len() const;
+		constexpr float sq_len() const;
+		float           len() const;
 
 		float x {0.f};
 		float y {0.f};
@@ -45,4 +50,177 @@ namespace vkb
 		float w {0.f};
 	};
 
-}
\ No newline at end of file
+	// Register holding the 4 components, only outside of constant evaluation
+	VKB_INLINE simd::f32x4 to_reg(vec4 vec)
+	{
+		return simd::load(&vec.x);
+	}
+
+	VKB_INLINE vec4 from_reg(simd::f32x4 reg)
+	{
+		vec4 res;
+		simd::store(&res.x, reg);
+		return res;
+	}
+
+	VKB_INLINE constexpr vec4 vec4::operator+(vec4 rhs) const
+	{
+		if (__builtin_is_constant_evaluated())
+			return {x + rhs.x, y + rhs.y, z + rhs.z, w + rhs.w};
+		return from_reg(simd::add(to_reg(*this), to_reg(rhs)));
+	}
+
+	VKB_INLINE constexpr vec4& vec4::operator+=(vec4 rhs)
+	{
+		return *this = *this + rhs;
+	}
+
+	VKB_INLINE constexpr vec4 vec4::operator+(float rhs) const
+	{
+		if (__builtin_is_constant_evaluated())
+			return {x + rhs, y + rhs, z + rhs, w + rhs};
+		return from_reg(simd::add(to_reg(*this), simd::splat(rhs)));
+	}
+
+	VKB_INLINE constexpr vec4& vec4::operator+=(float rhs)
+	{
+		return *this = *this + rhs;
+	}
+
+	VKB_INLINE constexpr vec4 vec4::operator-() const
+	{
+		if (__builtin_is_constant_evaluated())
+			return {-x, -y, -z, -w};
+		return from_reg(simd::mul(to_reg(*this), simd::splat(-1.f)));
+	}
+
+	VKB_INLINE constexpr vec4 vec4::operator-(vec4 rhs) const
+	{
+		if (__builtin_is_constant_evaluated())
+			return {x - rhs.x, y - rhs.y, z - rhs.z, w - rhs.w};
+		return from_reg(simd::sub(to_reg(*this), to_reg(rhs)));
+	}
+
+	VKB_INLINE constexpr vec4& vec4::operator-=(vec4 rhs)
+	{
+		return *this = *this - rhs;
+	}
+
+	VKB_INLINE constexpr vec4 vec4::operator-(float rhs) const
+	{
+		if (__builtin_is_constant_evaluated())
+			return {x - rhs, y - rhs, z - rhs, w - rhs};
+		return from_reg(simd::sub(to_reg(*this), simd::splat(rhs)));
+	}
+
+	VKB_INLINE constexpr vec4& vec4::operator-=(float rhs)
+	{
+		return *this = *this - rhs;
+	}
+
+	VKB_INLINE constexpr vec4 vec4::operator*(vec4 rhs) const
+	{
+		if (__builtin_is_constant_evaluated())
+			return {x * rhs.x, y * rhs.y, z * rhs.z, w * rhs.w};
+		return from_reg(simd::mul(to_reg(*this), to_reg(rhs)));
+	}
+
+	VKB_INLINE constexpr vec4& vec4::operator*=(vec4 rhs)
+	{
+		return *this = *this * rhs;
+	}
+
+	VKB_INLINE constexpr vec4 vec4::operator*(float rhs) const
+	{
+		if (__builtin_is_constant_evaluated())
+			return {x * rhs, y * rhs, z * rhs, w * rhs};
+		return from_reg(simd::mul(to_reg(*this), simd::splat(rhs)));
+	}
+
+	VKB_INLINE constexpr vec4& vec4::operator*=(float rhs)
+	{
+		return *this = *this * rhs;
+	}
+
+	VKB_INLINE constexpr vec4 vec4::operator/(vec4 rhs) const
+	{
+		if (__builtin_is_constant_evaluated())
+			return {x / rhs.x, y / rhs.y, z / rhs.z, w / rhs.w};
+		return from_reg(simd::div(to_reg(*this), to_reg(rhs)));
+	}
+
+	VKB_INLINE constexpr vec4& vec4::operator/=(vec4 rhs)
+	{
+		return *this = *this / rhs;
+	}
+
+	VKB_INLINE constexpr vec4 vec4::operator/(float rhs) const
+	{
+		if (__builtin_is_constant_evaluated())
+			return {x / rhs, y / rhs, z / rhs, w / rhs};
+		return from_reg(simd::div(to_reg(*this), simd::splat(rhs)));
+	}
+
+	VKB_INLINE constexpr vec4& vec4::operator/=(float rhs)
+	{
+		return *this = *this / rhs;
+	}
+
+	VKB_INLINE constexpr vec4 vec4::cross3(vec4 vec) const
+	{
+		if (__builtin_is_constant_evaluated())
+		{
+			return {
+				y * vec.z - z * vec.y,
+				z * vec.x - x * vec.z,
+				x * vec.y - y * vec.x,
+				w,
+			};
+		}
+
+		vec4 res = from_reg(simd::cross3(to_reg(*this), to_reg(vec)));
+		res.w = w;
+
+		return res;
+	}
+
+	VKB_INLINE vec4 vec4::norm() const
+	{
+		simd::f32x4 v = to_reg(*this);
+
+		return from_reg(simd::div(v, simd::sqrt(simd::dot4(v, v))));
+	}
+
+	VKB_INLINE vec4 vec4::norm3() const
+	{
+		simd::f32x4 v = to_reg(*this);
+		vec4        res = from_reg(simd::div(v, simd::sqrt(simd::dot3(v, v))));
+		res.w = 1.f;
+
+		return res;
+	}
+
+	VKB_INLINE constexpr float vec4::dot(vec4 vec) const
+	{
+		if (__builtin_is_constant_evaluated())
+			return x * vec.x + y * vec.y + z * vec.z + w * vec.w;
+		return simd::first(simd::dot4(to_reg(*this), to_reg(vec)));
+	}
+
+	VKB_INLINE constexpr float vec4::dot3(vec4 vec) const
+	{
+		if (__builtin_is_constant_evaluated())
+			return x * vec.x + y * vec.y + z * vec.z;
+		return simd::first(simd::dot3(to_reg(*this), to_reg(vec)));
+	}
+
+	VKB_INLINE constexpr float vec4::sq_len() const
+	{
+		return dot(*this);
+	}
+
+	VKB_INLINE float vec4::len() const
+	{
+		return sqrtf(dot(*this));
+	}
+}
@@ -0,0 +1,149 @@
+#pragma once
+
+#include "mat4.hh"
+#include "quat.hh"
+#include "simd.hh"
+#include "vec4.hh"
+
+namespace vkb
+{
+	// Rotation, translation and uniform scale, half the size of the equivalent mat4.
+	// Points are scaled, rotated as by mat4(rot), then translated: operator mat4 is
+	// mat4::scale(scale) * mat4(rot) * mat4::translate(pos). The layout is the xform
+	// struct of res/shaders/common/xform.slang.
+	struct xform
+	{
+		// Linear translation and scale, spherical rotation
+		static xform lerp(xform const& a, xform const& b, float t);
+
+		// This transform then rhs, as mat4(*this) * mat4(rhs)
+		xform operator*(xform const& rhs) const;
+		operator mat4() const;
+
+		// w of the result is 1
+		vec4  apply(vec4 point) const;
+		// Expects rot to be a unit quaternion and scale not to be 0
+		xform inverse() const;
+
+		// Translation, 3 floats, and scale, stored in pos_scale
+		float*       pos();
+		float const* pos() const;
+		float&       scale();
+		float        scale() const;
+
+		quat  rot {1.f, 0.f, 0.f, 0.f};
+		// Translation then scale, in one array which SIMD loads and stores as a whole
+		float pos_scale[4] {0.f, 0.f, 0.f, 1.f};
+	};
+
+	static_assert(sizeof(xform) == 32, "Layout shared with the shaders");
+
+	// Lanes are (pos.x, pos.y, pos.z, scale)
+	VKB_INLINE simd::f32x4 to_reg(xform const& t)
+	{
+		return simd::load(t.pos_scale);
+	}
+
+	namespace detail
+	{
+		// v * mat4(q) for a unit quaternion in lanes (w, x, y, z), which rotates by the
+		// conjugate of q. Lane 3 of the result is undefined.
+		VKB_INLINE simd::f32x4 rotate_row(simd::f32x4 q, simd::f32x4 v)
+		{
+			simd::f32x4 qv = simd::shuffle<1, 2, 3, 0>(q);
+			simd::f32x4 qw = simd::splat<0>(q);
+			simd::f32x4 two = simd::splat(2.f);
+
+			simd::f32x4 res = simd::mul(qv, simd::mul(two, simd::dot3(qv, v)));
+			res = simd::madd(v, simd::sub(simd::mul(qw, qw), simd::dot3(qv, qv)), res);
+			return simd::madd(simd::cross3(v, qv), simd::mul(two, qw), res);
+		}
+	}
+
+	inline xform xform::lerp(xform const& a, xform const& b, float t)
+	{
+		simd::f32x4 ra = to_reg(a);
+		simd::f32x4 rb = to_reg(b);
+
+		xform res;
+		res.rot = quat::slerp(a.rot, b.rot, t);
+		simd::store(res.pos_scale, simd::madd(simd::sub(rb, ra), simd::splat(t), ra));
+
+		return res;
+	}
+
+	VKB_INLINE xform xform::operator*(xform const& rhs) const
+	{
+		simd::f32x4 a = to_reg(*this);
+		simd::f32x4 b = to_reg(rhs);
+		simd::f32x4 p = simd::mul(a, simd::splat<3>(b));
+		p = simd::add(detail::rotate_row(to_reg(rhs.rot), p), b);
+
+		xform res;
+		// mat4(a) * mat4(b) is mat4(b * a)
+		res.rot = rhs.rot * rot;
+		simd::store(res.pos_scale, p);
+		res.scale() = scale() * rhs.scale();
+
+		return res;
+	}
+
+	VKB_INLINE xform::operator mat4() const
+	{
+		mat4        res = rot;
+		simd::f32x4 s = simd::splat(scale());
+		for (uint8_t i {0}; i < 3; ++i)
+			simd::store(res[i], simd::mul(simd::load(res[i]), s));
+
+		res[3][0] = pos()[0];
+		res[3][1] = pos()[1];
+		res[3][2] = pos()[2];
+
+		return res;
+	}
+
+	VKB_INLINE vec4 xform::apply(vec4 point) const
+	{
+		simd::f32x4 t = to_reg(*this);
+		simd::f32x4 p = simd::mul(to_reg(point), simd::splat<3>(t));
+
+		vec4 res = from_reg(simd::add(detail::rotate_row(to_reg(rot), p), t));
+		res.w = 1.f;
+
+		return res;
+	}
+
+	VKB_INLINE xform xform::inverse() const
+	{
+		xform res;
+		res.rot = {rot.w, -rot.x, -rot.y, -rot.z};
+		res.scale() = 1.f / scale();
+
+		vec4 p = rot.rotate({-pos()[0], -pos()[1], -pos()[2], 0.f}) * res.scale();
+		res.pos()[0] = p.x;
+		res.pos()[1] = p.y;
+		res.pos()[2] = p.z;
+
+		return res;
+	}
+
+	VKB_INLINE float* xform::pos()
+	{
+		return pos_scale;
+	}
+
+	VKB_INLINE float const* xform::pos() const
+	{
+		return pos_scale;
+	}
+
+	VKB_INLINE float& xform::scale()
+	{
+		return pos_scale[3];
+	}
+
+	VKB_INLINE float xform::scale() const
+	{
+		return pos_scale[3];
+	}
+}
@@ -0,0 +1,183 @@
+#include "meshlet.hh"
+
+#include "../log.hh"
+
+#include <math.h>
+
+namespace vkb::mesh
+{
+	namespace
+	{
+		struct vec3
+		{
+			float x;
+			float y;
+			float z;
+		};
+
+		vec3 sub(vec3 a, vec3 b)
+		{
+			return {a.x - b.x, a.y - b.y, a.z - b.z};
+		}
+
+		vec3 cross(vec3 a, vec3 b)
+		{
+			return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+		}
+
+		float dot(vec3 a, vec3 b)
+		{
+			return a.x * b.x + a.y * b.y + a.z * b.z;
+		}
+
+		// Cones wider than this cull too rarely to be worth testing
+		constexpr float min_cone_dot {0.1f};
+	}
+
+	void build_meshlets(float const* positions, uint32_t stride, uint32_t vert_count,
+	                    mc::array_view<uint16_t> idcs, meshlet_set& out)
+	{
+		log::assert(idcs.size() % 3 == 0, "Index count %u is not a triangle list",
+		            idcs.size());
+
+		auto pos = [&](uint32_t v)
+		{
+			float const* p = reinterpret_cast<float const*>(
+				reinterpret_cast<uint8_t const*>(positions) + v * stride);
+			return vec3 {p[0], p[1], p[2]};
+		};
+
+		out.meshlets.clear();
+		out.bounds.clear();
+		out.verts.clear();
+		out.tris.clear();
+		out.tris.reserve(idcs.size() / 3);
+
+		// Index of each mesh vertex in the current meshlet, UINT8_MAX when not in it
+		mc::vector<uint8_t> local;
+		local.resize(vert_count);
+		for (uint8_t& l : local)
+			l = UINT8_MAX;
+
+		auto bounds_of = [&](meshlet const& m)
+		{
+			uint32_t const* verts = &out.verts[m.first_vert];
+			uint32_t const* tris = &out.tris[m.first_tri];
+
+			meshlet_bounds res {};
+
+			// Sphere around the bounding box, to the farthest vertex
+			vec3 min = pos(verts[0]);
+			vec3 max = min;
+			for (uint32_t i {1}; i < m.vert_count; ++i)
+			{
+				vec3 p = pos(verts[i]);
+				min = {fminf(min.x, p.x), fminf(min.y, p.y), fminf(min.z, p.z)};
+				max = {fmaxf(max.x, p.x), fmaxf(max.y, p.y), fmaxf(max.z, p.z)};
+			}
+			vec3 center {(min.x + max.x) / 2.f, (min.y + max.y) / 2.f,
+			             (min.z + max.z) / 2.f};
+			float radius_sq {0.f};
+			for (uint32_t i {0}; i < m.vert_count; ++i)
+			{
+				vec3 d = sub(pos(verts[i]), center);
+				radius_sq = fmaxf(radius_sq, dot(d, d));
+			}
+
+			res.center[0] = center.x;
+			res.center[1] = center.y;
+			res.center[2] = center.z;
+			res.radius = sqrtf(radius_sq);
+
+			auto normal = [&](uint32_t tri)
+			{
+				vec3 a = pos(verts[tris[tri] & 0xff]);
+				vec3 b = pos(verts[(tris[tri] >> 8) & 0xff]);
+				vec3 c = pos(verts[(tris[tri] >> 16) & 0xff]);
+				vec3 n = cross(sub(b, a), sub(c, a));
+				float len = sqrtf(dot(n, n));
+				return len > 0.f ? vec3 {n.x / len, n.y / len, n.z / len} : n;
+			};
+
+			// Cone around the average normal, as wide as the farthest normal from it
+			vec3 axis {0.f, 0.f, 0.f};
+			for (uint32_t i {0}; i < m.tri_count; ++i)
+			{
+				vec3 n = normal(i);
+				axis = {axis.x + n.x, axis.y + n.y, axis.z + n.z};
+			}
+
+			float len = sqrtf(dot(axis, axis));
+			if (len == 0.f)
+				return res;
+			axis = {axis.x / len, axis.y / len, axis.z / len};
+
+			float min_dot {1.f};
+			for (uint32_t i {0}; i < m.tri_count; ++i)
+			{
+				vec3 n = normal(i);
+				if (dot(n, n) > 0.f)
+					min_dot = fminf(min_dot, dot(n, axis));
+			}
+
+			res.cone_axis[0] = axis.x;
+			res.cone_axis[1] = axis.y;
+			res.cone_axis[2] = axis.z;
+			// Triangles all face away when the view direction is within 90 degrees
+			// minus the cone angle of the axis
+			if (min_dot > min_cone_dot)
+				res.cone_cutoff = sqrtf(1.f - min_dot * min_dot);
+
+			return res;
+		};
+
+		meshlet cur {};
+
+		auto finish = [&]()
+		{
+			if (!cur.tri_count)
+				return;
+
+			for (uint32_t i {0}; i < cur.vert_count; ++i)
+				local[out.verts[cur.first_vert + i]] = UINT8_MAX;
+
+			out.meshlets.emplace_back(cur);
+			out.bounds.emplace_back(bounds_of(cur));
+
+			cur.first_vert = out.verts.size();
+			cur.vert_count = 0;
+			cur.first_tri += cur.tri_count;
+			cur.tri_count = 0;
+		};
+
+		for (uint32_t i {0}; i < idcs.size(); i += 3)
+		{
+			// Degenerate triangles may count a vertex twice, which only ends the meshlet
+			// early
+			uint32_t new_verts {0};
+			for (uint32_t k {0}; k < 3; ++k)
+				new_verts += local[idcs[i + k]] == UINT8_MAX;
+
+			if (cur.vert_count + new_verts > max_meshlet_verts ||
+			    cur.tri_count == max_meshlet_tris)
+				finish();
+
+			uint32_t packed {0};
+			for (uint32_t k {0}; k < 3; ++k)
+			{
+				uint16_t v = idcs[i + k];
+				if (local[v] == UINT8_MAX)
+				{
+					local[v] = cur.vert_count++;
+					out.verts.emplace_back(v);
+				}
+				packed |= uint32_t {local[v]} << (8 * k);
+			}
+
+			out.tris.emplace_back(packed);
+			++cur.tri_count;
+		}
+
+		finish();
+	}
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <array_view.hh>
+#include <vector.hh>
+
+#include <stdint.h>
+
+// Meshlets, small clusters of triangles culled on their own so that large meshes only
+// pay for their visible parts
+namespace vkb::mesh
+{
+	// Mesh shader workgroup sizes that suit every vendor. 124 triangles keep the
+	// primitive indices of a meshlet within 3 blocks of 128 bytes.
+	constexpr uint32_t max_meshlet_verts {64};
+	constexpr uint32_t max_meshlet_tris {124};
+
+	struct meshlet
+	{
+		// Range of meshlet_set::verts
+		uint32_t first_vert {0};
+		uint32_t vert_count {0};
+		// Range of triangles of the mesh indices, and of meshlet_set::tris
+		uint32_t first_tri {0};
+		uint32_t tri_count {0};
+	};
+
+	// Model space bounds
+	struct meshlet_bounds
+	{
+		float center[3] {0.f, 0.f, 0.f};
+		float radius {0.f};
+		// Normal cone, every triangle faces away from eyes where
+		// dot(center - eye, cone_axis) >= cone_cutoff * |center - eye| + radius.
+		// A cutoff of 1 never culls.
+		float cone_axis[3] {0.f, 0.f, 0.f};
+		float cone_cutoff {1.f};
+	};
+
+	struct meshlet_set
+	{
+		mc::vector<meshlet>        meshlets;
+		mc::vector<meshlet_bounds> bounds;
+		// Mesh vertices used by each meshlet
+		mc::vector<uint32_t> verts;
+		// Triangles as 3 bytes indexing the vertices of their meshlet, packed in the
+		// low bytes
+		mc::vector<uint32_t> tris;
+	};
+
+	// Groups consecutive triangles until a meshlet is full, so that each meshlet is also
+	// a range of the index buffer, drawable without mesh shaders. Works best on indices
+	// ordered for the vertex cache (see optimize_vertex_cache), whose neighbouring
+	// triangles share vertices.
+	void build_meshlets(float const* positions, uint32_t stride, uint32_t vert_count,
+	                    mc::array_view<uint16_t> idcs, meshlet_set& out);
+}
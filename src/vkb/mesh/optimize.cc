@@ -0,0 +1,410 @@
+#include "optimize.hh"
+
+#include "../log.hh"
+
+#include <math.h>
+
+namespace vkb::mesh
+{
+	namespace
+	{
+		// FIFO cache simulated with the time each vertex entered it, a vertex being
+		// cached while fewer than `size` vertices entered after it
+		class fifo_cache
+		{
+		public:
+			fifo_cache(uint32_t vert_count, uint32_t size)
+			    : size_ {size}
+			    , time_ {size + 1}
+			{
+				entry_.resize(vert_count);
+				for (uint32_t& t : entry_)
+					t = 0;
+			}
+
+			uint32_t age(uint32_t v) const
+			{
+				return time_ - entry_[v];
+			}
+
+			// Returns whether `v` missed
+			bool access(uint32_t v)
+			{
+				if (age(v) <= size_)
+					return false;
+
+				entry_[v] = time_++;
+				return true;
+			}
+
+			void flush()
+			{
+				time_ += size_ + 1;
+			}
+
+		private:
+			mc::vector<uint32_t> entry_;
+			uint32_t             size_;
+			uint32_t             time_;
+		};
+
+		struct vec3
+		{
+			float x;
+			float y;
+			float z;
+		};
+
+		vec3 sub(vec3 a, vec3 b)
+		{
+			return {a.x - b.x, a.y - b.y, a.z - b.z};
+		}
+
+		vec3 cross(vec3 a, vec3 b)
+		{
+			return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+		}
+
+		float dot(vec3 a, vec3 b)
+		{
+			return a.x * b.x + a.y * b.y + a.z * b.z;
+		}
+
+		void check_idcs(mc::array_view<uint16_t> idcs, uint32_t vert_count)
+		{
+			log::assert(idcs.size() % 3 == 0, "Index count %u is not a triangle list",
+			            idcs.size());
+			for (uint16_t idx : idcs)
+				log::assert(idx < vert_count, "Index %u out of %u vertices", idx,
+				            vert_count);
+		}
+	}
+
+	cache_stats analyze_vertex_cache(mc::array_view<uint16_t> idcs, uint32_t vert_count,
+	                                 uint32_t cache_size)
+	{
+		check_idcs(idcs, vert_count);
+
+		if (idcs.empty())
+			return {};
+
+		fifo_cache          cache {vert_count, cache_size};
+		mc::vector<uint8_t> used;
+		used.resize(vert_count);
+		for (uint8_t& u : used)
+			u = 0;
+
+		uint32_t misses {0};
+		uint32_t unique {0};
+		for (uint16_t idx : idcs)
+		{
+			unique += !used[idx];
+			used[idx] = 1;
+			misses += cache.access(idx);
+		}
+
+		return {static_cast<float>(misses) / (idcs.size() / 3),
+		        static_cast<float>(misses) / unique};
+	}
+
+	void optimize_vertex_cache(mc::array_view<uint16_t> idcs, uint32_t vert_count,
+	                           mc::vector<uint16_t>& out, uint32_t cache_size)
+	{
+		check_idcs(idcs, vert_count);
+
+		uint32_t const tri_count = idcs.size() / 3;
+
+		out.clear();
+		out.reserve(idcs.size());
+		if (!tri_count)
+			return;
+
+		// Triangles of each vertex, and how many of them are left to emit
+		mc::vector<uint32_t> offsets;
+		mc::vector<uint32_t> live;
+		mc::vector<uint32_t> tris;
+		offsets.resize(vert_count + 1);
+		live.resize(vert_count);
+		tris.resize(idcs.size());
+		for (uint32_t& l : live)
+			l = 0;
+		for (uint16_t idx : idcs)
+			++live[idx];
+
+		offsets[0] = 0;
+		for (uint32_t v {0}; v < vert_count; ++v)
+			offsets[v + 1] = offsets[v] + live[v];
+		for (uint32_t i {0}; i < idcs.size(); ++i)
+			tris[offsets[idcs[i]]++] = i / 3;
+		for (uint32_t v {vert_count}; v > 0; --v)
+			offsets[v] = offsets[v - 1];
+		offsets[0] = 0;
+
+		mc::vector<uint8_t> emitted;
+		emitted.resize(tri_count);
+		for (uint8_t& e : emitted)
+			e = 0;
+
+		// Vertices of the emitted triangles, most recent last, to resume from when a fan
+		// has no candidate left
+		mc::vector<uint16_t> dead_end;
+		mc::vector<uint16_t> candidates;
+		dead_end.reserve(idcs.size());
+
+		fifo_cache cache {vert_count, cache_size};
+		uint32_t   cursor {0};
+
+		// Next fan among the vertices of the last one. Vertices that would still be in
+		// cache after emitting their triangles are preferred, the oldest first.
+		auto next_fan = [&]()
+		{
+			uint32_t best {UINT32_MAX};
+			int32_t  best_priority {-1};
+			for (uint16_t v : candidates)
+			{
+				if (!live[v])
+					continue;
+
+				int32_t priority {0};
+				if (cache.age(v) + 2 * live[v] <= cache_size)
+					priority = cache.age(v);
+				if (priority > best_priority)
+				{
+					best = v;
+					best_priority = priority;
+				}
+			}
+			if (best != UINT32_MAX)
+				return best;
+
+			while (dead_end.size())
+			{
+				uint16_t v = dead_end.back();
+				dead_end.pop_back();
+				if (live[v])
+					return static_cast<uint32_t>(v);
+			}
+
+			while (cursor < vert_count)
+			{
+				if (live[cursor])
+					return cursor;
+				++cursor;
+			}
+
+			return UINT32_MAX;
+		};
+
+		uint32_t fan = idcs[0];
+		while (fan != UINT32_MAX)
+		{
+			candidates.clear();
+			for (uint32_t i {offsets[fan]}; i < offsets[fan + 1]; ++i)
+			{
+				uint32_t tri = tris[i];
+				if (emitted[tri])
+					continue;
+
+				emitted[tri] = 1;
+				for (uint32_t k {0}; k < 3; ++k)
+				{
+					uint16_t v = idcs[tri * 3 + k];
+					out.emplace_back(v);
+					dead_end.emplace_back(v);
+					candidates.emplace_back(v);
+					--live[v];
+					cache.access(v);
+				}
+			}
+
+			fan = next_fan();
+		}
+	}
+
+	void optimize_overdraw(float const* positions, uint32_t stride, uint32_t vert_count,
+	                       mc::array_view<uint16_t> idcs, mc::vector<uint16_t>& out,
+	                       float threshold, uint32_t cache_size)
+	{
+		check_idcs(idcs, vert_count);
+
+		uint32_t const tri_count = idcs.size() / 3;
+
+		out.clear();
+		out.reserve(idcs.size());
+		if (!tri_count)
+			return;
+
+		auto pos = [&](uint32_t v)
+		{
+			float const* p = reinterpret_cast<float const*>(
+				reinterpret_cast<uint8_t const*>(positions) + v * stride);
+			return vec3 {p[0], p[1], p[2]};
+		};
+
+		fifo_cache cache {vert_count, cache_size};
+
+		auto tri_misses = [&](uint32_t tri)
+		{
+			return static_cast<uint32_t>(cache.access(idcs[tri * 3])) +
+			       cache.access(idcs[tri * 3 + 1]) + cache.access(idcs[tri * 3 + 2]);
+		};
+
+		// Hard boundaries, where a triangle misses all its vertices and the order jumped
+		// to another part of the mesh
+		mc::vector<uint32_t> hard;
+		for (uint32_t tri {0}; tri < tri_count; ++tri)
+		{
+			if (tri_misses(tri) == 3 || tri == 0)
+				hard.emplace_back(tri);
+		}
+		hard.emplace_back(tri_count);
+
+		// Soft boundaries, cutting hard clusters as soon as the part before the cut is
+		// about as cache efficient as the whole cluster, each part starting cold
+		mc::vector<uint32_t> starts;
+		for (uint32_t c {0}; c + 1 < hard.size(); ++c)
+		{
+			uint32_t const begin = hard[c];
+			uint32_t const end = hard[c + 1];
+
+			cache.flush();
+			uint32_t misses {0};
+			for (uint32_t tri {begin}; tri < end; ++tri)
+				misses += tri_misses(tri);
+			float const max_acmr = threshold * misses / (end - begin);
+
+			cache.flush();
+			starts.emplace_back(begin);
+			misses = 0;
+			for (uint32_t tri {begin}; tri + 1 < end; ++tri)
+			{
+				misses += tri_misses(tri);
+				if (misses <= max_acmr * (tri + 1 - starts.back()))
+				{
+					cache.flush();
+					starts.emplace_back(tri + 1);
+					misses = 0;
+				}
+			}
+		}
+		starts.emplace_back(tri_count);
+
+		uint32_t const cluster_count = starts.size() - 1;
+
+		// Area weighted centroid and normal of each cluster and of the mesh
+		mc::vector<vec3> centroids;
+		mc::vector<vec3> normals;
+		centroids.resize(cluster_count);
+		normals.resize(cluster_count);
+
+		vec3  center {0.f, 0.f, 0.f};
+		float total_area {0.f};
+		for (uint32_t c {0}; c < cluster_count; ++c)
+		{
+			vec3  centroid {0.f, 0.f, 0.f};
+			vec3  normal {0.f, 0.f, 0.f};
+			float area {0.f};
+			for (uint32_t tri {starts[c]}; tri < starts[c + 1]; ++tri)
+			{
+				vec3 a = pos(idcs[tri * 3]);
+				vec3 b = pos(idcs[tri * 3 + 1]);
+				vec3 d = pos(idcs[tri * 3 + 2]);
+				vec3 n = cross(sub(b, a), sub(d, a));
+				// Twice the area, which cancels out
+				float w = sqrtf(dot(n, n));
+
+				centroid.x += (a.x + b.x + d.x) * w;
+				centroid.y += (a.y + b.y + d.y) * w;
+				centroid.z += (a.z + b.z + d.z) * w;
+				normal = {normal.x + n.x, normal.y + n.y, normal.z + n.z};
+				area += w;
+			}
+
+			center.x += centroid.x;
+			center.y += centroid.y;
+			center.z += centroid.z;
+			total_area += area;
+
+			float inv_area = area > 0.f ? 1.f / (3.f * area) : 0.f;
+			centroids[c] = {centroid.x * inv_area, centroid.y * inv_area,
+			                centroid.z * inv_area};
+			normals[c] = normal;
+		}
+
+		float inv_total = total_area > 0.f ? 1.f / (3.f * total_area) : 0.f;
+		center = {center.x * inv_total, center.y * inv_total, center.z * inv_total};
+
+		// Clusters facing away from the center first, by the distance of their plane to
+		// it. Counting sort on the quantized key, stable so that ties keep cache order.
+		mc::vector<float> keys;
+		keys.resize(cluster_count);
+		float min_key {INFINITY};
+		float max_key {-INFINITY};
+		for (uint32_t c {0}; c < cluster_count; ++c)
+		{
+			vec3  n = normals[c];
+			float len = sqrtf(dot(n, n));
+			keys[c] = len > 0.f ? dot(sub(centroids[c], center), n) / len : 0.f;
+			min_key = keys[c] < min_key ? keys[c] : min_key;
+			max_key = keys[c] > max_key ? keys[c] : max_key;
+		}
+
+		constexpr uint32_t buckets {1 << 10};
+
+		float const scale = max_key > min_key ? (buckets - 1) / (max_key - min_key) : 0.f;
+		auto        bucket = [&](uint32_t c)
+		{
+			return static_cast<uint32_t>((max_key - keys[c]) * scale);
+		};
+
+		mc::vector<uint32_t> offsets;
+		offsets.resize(buckets);
+		for (uint32_t& offset : offsets)
+			offset = 0;
+		for (uint32_t c {0}; c < cluster_count; ++c)
+			++offsets[bucket(c)];
+
+		uint32_t sum {0};
+		for (uint32_t& offset : offsets)
+		{
+			uint32_t cnt = offset;
+			offset = sum;
+			sum += cnt;
+		}
+
+		mc::vector<uint32_t> order;
+		order.resize(cluster_count);
+		for (uint32_t c {0}; c < cluster_count; ++c)
+			order[offsets[bucket(c)]++] = c;
+
+		for (uint32_t c : order)
+		{
+			for (uint32_t i {starts[c] * 3}; i < starts[c + 1] * 3; ++i)
+				out.emplace_back(idcs[i]);
+		}
+	}
+
+	uint32_t optimize_vertex_fetch(mc::array_view<uint16_t> idcs, uint32_t vert_count,
+	                               mc::vector<uint16_t>& out,
+	                               mc::vector<uint32_t>& remap)
+	{
+		check_idcs(idcs, vert_count);
+
+		remap.resize(vert_count);
+		for (uint32_t& idx : remap)
+			idx = UINT32_MAX;
+
+		out.clear();
+		out.reserve(idcs.size());
+
+		uint32_t kept {0};
+		for (uint16_t idx : idcs)
+		{
+			if (remap[idx] == UINT32_MAX)
+				remap[idx] = kept++;
+			out.emplace_back(static_cast<uint16_t>(remap[idx]));
+		}
+
+		return kept;
+	}
+}
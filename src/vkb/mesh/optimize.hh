@@ -0,0 +1,51 @@
+#pragma once
+
+#include <array_view.hh>
+#include <vector.hh>
+
+#include <stdint.h>
+
+// Index and vertex reordering for the GPU front end, run when meshes are imported. The
+// passes are meant to run in order: vertex cache, overdraw, then vertex fetch.
+namespace vkb::mesh
+{
+	// Post transform cache size assumed by the passes. Actual caches vary and are not
+	// strictly FIFO, but orders tuned for 16 entries do well on all of them.
+	constexpr uint32_t vertex_cache_size {16};
+
+	// Vertex shader invocations of an index order, simulated with a FIFO cache
+	struct cache_stats
+	{
+		// Average cache miss ratio, invocations per triangle. 3 at worst, close to 0.5
+		// for large regular meshes.
+		float acmr {0.f};
+		// Average transformed vertex ratio, invocations per referenced vertex. 1 at best.
+		float atvr {0.f};
+	};
+
+	cache_stats analyze_vertex_cache(mc::array_view<uint16_t> idcs, uint32_t vert_count,
+	                                 uint32_t cache_size = vertex_cache_size);
+
+	// Tipsify (Sander et al. 2007): triangles are emitted in fans around one vertex at a
+	// time, the next fan being the oldest vertex of the last one that remains cached
+	// through its own fan. Linear time.
+	void optimize_vertex_cache(mc::array_view<uint16_t> idcs, uint32_t vert_count,
+	                           mc::vector<uint16_t>& out,
+	                           uint32_t cache_size = vertex_cache_size);
+
+	// Splits a cache optimized order in clusters and draws the ones facing away from the
+	// mesh center first, as they are the likeliest to occlude the others. Clusters are
+	// cut where the cache is cold, and where their own ACMR is within `threshold` of the
+	// input's, so the cache efficiency drops by about `threshold`.
+	void optimize_overdraw(float const* positions, uint32_t stride, uint32_t vert_count,
+	                       mc::array_view<uint16_t> idcs, mc::vector<uint16_t>& out,
+	                       float    threshold = 1.05f,
+	                       uint32_t cache_size = vertex_cache_size);
+
+	// Renumbers vertices in order of first use, dropping unused ones, so that vertex
+	// fetches walk the buffer forward. `remap` gives the new index of each vertex, or
+	// UINT32_MAX when unused. Returns the number of vertices kept.
+	uint32_t optimize_vertex_fetch(mc::array_view<uint16_t> idcs, uint32_t vert_count,
+	                               mc::vector<uint16_t>& out,
+	                               mc::vector<uint32_t>& remap);
+}
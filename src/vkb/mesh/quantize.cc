@@ -0,0 +1,166 @@
+#include "quantize.hh"
+
+#include <math.h>
+#include <string.h>
+
+namespace vkb::mesh
+{
+	namespace
+	{
+		// Smallest extent kept, under which an axis is considered flat
+		constexpr float min_extent {1e-6f};
+
+		float sign_not_zero(float v)
+		{
+			return v >= 0.f ? 1.f : -1.f;
+		}
+	}
+
+	quant_bounds position_bounds(float const* positions, uint32_t stride,
+	                             uint32_t vert_count)
+	{
+		quant_bounds res {};
+		if (!vert_count)
+			return res;
+
+		float min[3] {positions[0], positions[1], positions[2]};
+		float max[3] {positions[0], positions[1], positions[2]};
+		for (uint32_t v {1}; v < vert_count; ++v)
+		{
+			float const* p = reinterpret_cast<float const*>(
+				reinterpret_cast<uint8_t const*>(positions) + v * stride);
+			for (uint32_t k {0}; k < 3; ++k)
+			{
+				min[k] = fminf(min[k], p[k]);
+				max[k] = fmaxf(max[k], p[k]);
+			}
+		}
+
+		for (uint32_t k {0}; k < 3; ++k)
+		{
+			res.center[k] = (min[k] + max[k]) / 2.f;
+			res.extent[k] = fmaxf((max[k] - min[k]) / 2.f, min_extent);
+		}
+
+		return res;
+	}
+
+	void quantize_position(float const* pos, quant_bounds const& bounds, int16_t out[4])
+	{
+		for (uint32_t k {0}; k < 3; ++k)
+			out[k] = quantize_snorm16((pos[k] - bounds.center[k]) / bounds.extent[k]);
+		out[3] = INT16_MAX;
+	}
+
+	int16_t quantize_snorm16(float v)
+	{
+		v = fminf(fmaxf(v, -1.f), 1.f);
+		return static_cast<int16_t>(lrintf(v * INT16_MAX));
+	}
+
+	uint8_t quantize_unorm8(float v)
+	{
+		v = fminf(fmaxf(v, 0.f), 1.f);
+		return static_cast<uint8_t>(lrintf(v * UINT8_MAX));
+	}
+
+	float dequantize_snorm16(int16_t v)
+	{
+		// -32768 and -32767 are both -1
+		return fmaxf(v / static_cast<float>(INT16_MAX), -1.f);
+	}
+
+	uint16_t quantize_half(float v)
+	{
+		uint32_t bits;
+		memcpy(&bits, &v, sizeof(bits));
+
+		uint16_t sign = (bits >> 16) & 0x8000;
+		uint32_t abs = bits & 0x7fffffff;
+
+		// Infinity, or NaN kept quiet
+		if (abs >= 0x7f800000)
+			return sign | 0x7c00 | (abs > 0x7f800000 ? 0x200 : 0);
+		// 65520 and above round past the largest half, 65504
+		if (abs >= 0x477ff000)
+			return sign | 0x7c00;
+
+		// Subnormal halves, multiples of 2^-24 which are exact in floats
+		if (abs < 0x38800000)
+		{
+			float a;
+			memcpy(&a, &abs, sizeof(a));
+			return sign | static_cast<uint16_t>(lrintf(a * 16777216.f));
+		}
+
+		// Rebias the exponent from 127 to 15, and round the 13 dropped mantissa bits to
+		// nearest even. A carry correctly moves to the exponent.
+		uint32_t h = abs - 0x38000000;
+		h = (h + 0xfff + ((h >> 13) & 1)) >> 13;
+		return sign | static_cast<uint16_t>(h);
+	}
+
+	float dequantize_half(uint16_t v)
+	{
+		uint32_t sign = static_cast<uint32_t>(v & 0x8000) << 16;
+		uint32_t exp = (v >> 10) & 0x1f;
+		uint32_t mant = v & 0x3ff;
+
+		uint32_t bits;
+		if (exp == 0)
+		{
+			float res = ldexpf(static_cast<float>(mant), -24);
+			return sign ? -res : res;
+		}
+		else if (exp == 0x1f)
+			bits = sign | 0x7f800000 | (mant << 13);
+		else
+			bits = sign | ((exp + 112) << 23) | (mant << 13);
+
+		float res;
+		memcpy(&res, &bits, sizeof(res));
+		return res;
+	}
+
+	void encode_octahedral(float const* normal, int16_t out[2])
+	{
+		float l1 = fabsf(normal[0]) + fabsf(normal[1]) + fabsf(normal[2]);
+		if (l1 == 0.f)
+		{
+			out[0] = 0;
+			out[1] = 0;
+			return;
+		}
+
+		float u = normal[0] / l1;
+		float v = normal[1] / l1;
+		// The lower half is folded over the diagonals
+		if (normal[2] < 0.f)
+		{
+			float fu = (1.f - fabsf(v)) * sign_not_zero(u);
+			float fv = (1.f - fabsf(u)) * sign_not_zero(v);
+			u = fu;
+			v = fv;
+		}
+
+		out[0] = quantize_snorm16(u);
+		out[1] = quantize_snorm16(v);
+	}
+
+	void decode_octahedral(int16_t const* enc, float out[3])
+	{
+		float x = dequantize_snorm16(enc[0]);
+		float y = dequantize_snorm16(enc[1]);
+		float z = 1.f - fabsf(x) - fabsf(y);
+
+		// Unfolds the lower half
+		float t = fmaxf(-z, 0.f);
+		x += x >= 0.f ? -t : t;
+		y += y >= 0.f ? -t : t;
+
+		float len = sqrtf(x * x + y * y + z * z);
+		out[0] = x / len;
+		out[1] = y / len;
+		out[2] = z / len;
+	}
+}
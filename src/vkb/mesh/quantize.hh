@@ -0,0 +1,36 @@
+#pragma once
+
+#include <stdint.h>
+
+// Attribute quantization for compact vertex formats. Each encoding matches a Vulkan
+// vertex format, converted back to floats by the vertex input.
+namespace vkb::mesh
+{
+	// Box around a mesh, which maps its positions to [-1, 1] for snorm quantization.
+	// Every LOD of a mesh uses the bounds of the source one.
+	struct quant_bounds
+	{
+		float center[3] {0.f, 0.f, 0.f};
+		// Half size, never 0 so that flat meshes dequantize
+		float extent[3] {1.f, 1.f, 1.f};
+	};
+
+	quant_bounds position_bounds(float const* positions, uint32_t stride,
+	                             uint32_t vert_count);
+	// VK_FORMAT_R16G16B16A16_SNORM, w is 1
+	void quantize_position(float const* pos, quant_bounds const& bounds, int16_t out[4]);
+
+	// Round to nearest, values outside of [-1, 1] and [0, 1] are clamped
+	int16_t quantize_snorm16(float v);
+	uint8_t quantize_unorm8(float v);
+	float   dequantize_snorm16(int16_t v);
+
+	// IEEE 754 binary16, rounded to nearest even. Overflows to infinity.
+	uint16_t quantize_half(float v);
+	float    dequantize_half(uint16_t v);
+
+	// Unit vector projected on an octahedron unfolded in [-1, 1]^2, as snorm16. Errors
+	// stay under 0.01 degree, 4 bytes instead of 12.
+	void encode_octahedral(float const* normal, int16_t out[2]);
+	void decode_octahedral(int16_t const* enc, float out[3]);
+}
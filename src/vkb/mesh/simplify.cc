@@ -0,0 +1,481 @@
+#include "simplify.hh"
+
+#include "../log.hh"
+
+#include <float.h>
+#include <math.h>
+#include <string.h>
+
+namespace vkb::mesh
+{
+	namespace
+	{
+		struct vec3
+		{
+			double x;
+			double y;
+			double z;
+		};
+
+		vec3 sub(vec3 a, vec3 b)
+		{
+			return {a.x - b.x, a.y - b.y, a.z - b.z};
+		}
+
+		vec3 cross(vec3 a, vec3 b)
+		{
+			return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+		}
+
+		double dot(vec3 a, vec3 b)
+		{
+			return a.x * b.x + a.y * b.y + a.z * b.z;
+		}
+
+		// Sum of weighted squared distances to planes, as the symmetric matrix A, the
+		// vector b and the scalar c of p.A.p + 2 b.p + c
+		struct quadric
+		{
+			double a00 {0}, a01 {0}, a02 {0}, a11 {0}, a12 {0}, a22 {0};
+			double b0 {0}, b1 {0}, b2 {0};
+			double c {0};
+			double weight {0};
+
+			static quadric plane(vec3 n, double d, double weight)
+			{
+				quadric q;
+				q.a00 = n.x * n.x * weight;
+				q.a01 = n.x * n.y * weight;
+				q.a02 = n.x * n.z * weight;
+				q.a11 = n.y * n.y * weight;
+				q.a12 = n.y * n.z * weight;
+				q.a22 = n.z * n.z * weight;
+				q.b0 = n.x * d * weight;
+				q.b1 = n.y * d * weight;
+				q.b2 = n.z * d * weight;
+				q.c = d * d * weight;
+				q.weight = weight;
+				return q;
+			}
+
+			quadric& operator+=(quadric const& o)
+			{
+				a00 += o.a00;
+				a01 += o.a01;
+				a02 += o.a02;
+				a11 += o.a11;
+				a12 += o.a12;
+				a22 += o.a22;
+				b0 += o.b0;
+				b1 += o.b1;
+				b2 += o.b2;
+				c += o.c;
+				weight += o.weight;
+				return *this;
+			}
+
+			double eval(vec3 p) const
+			{
+				double res = p.x * (a00 * p.x + 2 * (a01 * p.y + a02 * p.z + b0)) +
+				             p.y * (a11 * p.y + 2 * (a12 * p.z + b1)) +
+				             p.z * (a22 * p.z + 2 * b2) + c;
+				return res > 0 ? res : 0;
+			}
+		};
+
+		// Open addressing set of keys, giving each distinct key a dense id
+		class key_ids
+		{
+		public:
+			key_ids(uint32_t max_keys)
+			{
+				uint32_t capacity {1};
+				while (capacity < max_keys * 2)
+					capacity *= 2;
+
+				mask_ = capacity - 1;
+				keys_.resize(capacity);
+				ids_.resize(capacity);
+				for (uint64_t& key : keys_)
+					key = UINT64_MAX;
+			}
+
+			// Id of the key, and whether it was seen before
+			uint32_t get(uint64_t key, bool& found)
+			{
+				uint64_t hash = key * 0x9e3779b97f4a7c15ull;
+				uint32_t slot = static_cast<uint32_t>(hash >> 32) & mask_;
+				while (keys_[slot] != UINT64_MAX)
+				{
+					if (keys_[slot] == key)
+					{
+						found = true;
+						return ids_[slot];
+					}
+					slot = (slot + 1) & mask_;
+				}
+
+				found = false;
+				keys_[slot] = key;
+				ids_[slot] = count_++;
+				return ids_[slot];
+			}
+
+		private:
+			mc::vector<uint64_t> keys_;
+			mc::vector<uint32_t> ids_;
+			uint32_t             mask_ {0};
+			uint32_t             count_ {0};
+		};
+
+		uint64_t edge_key(uint32_t a, uint32_t b)
+		{
+			return a < b ? (uint64_t {a} << 32) | b : (uint64_t {b} << 32) | a;
+		}
+
+		struct collapse
+		{
+			uint32_t from;
+			uint32_t to;
+			float    error;
+		};
+
+		// Orders collapses by error with a counting sort on the 11 highest bits of the
+		// (positive) floats, keeping the exponent and 2 bits of mantissa
+		void sort_collapses(mc::vector<collapse>& collapses, mc::vector<collapse>& tmp)
+		{
+			constexpr uint32_t buckets {1 << 11};
+
+			auto bucket = [](float error)
+			{
+				uint32_t bits;
+				memcpy(&bits, &error, sizeof(bits));
+				return bits >> 21;
+			};
+
+			mc::vector<uint32_t> offsets;
+			offsets.resize(buckets);
+			for (collapse const& c : collapses)
+				++offsets[bucket(c.error)];
+
+			uint32_t sum {0};
+			for (uint32_t& offset : offsets)
+			{
+				uint32_t cnt = offset;
+				offset = sum;
+				sum += cnt;
+			}
+
+			tmp.resize(collapses.size());
+			for (collapse const& c : collapses)
+				tmp[offsets[bucket(c.error)]++] = c;
+
+			collapses = static_cast<mc::vector<collapse>&&>(tmp);
+		}
+	}
+
+	float simplify(float const* positions, uint32_t stride, uint32_t vert_count,
+	               mc::array_view<uint16_t> idcs, uint32_t target_idx_count,
+	               float max_error, mc::vector<uint16_t>& out)
+	{
+		log::assert(idcs.size() % 3 == 0, "Index count %u is not a triangle list",
+		            idcs.size());
+
+		auto raw = [&](uint32_t v)
+		{
+			return reinterpret_cast<float const*>(
+				reinterpret_cast<uint8_t const*>(positions) + v * stride);
+		};
+		auto pos = [&](uint32_t v)
+		{
+			float const* p = raw(v);
+			return vec3 {p[0], p[1], p[2]};
+		};
+
+		out.clear();
+		out.reserve(idcs.size());
+		for (uint16_t idx : idcs)
+			out.emplace_back(idx);
+
+		// Vertices sharing a position are welded to the first of them, and locked since
+		// they differ by other attributes
+		mc::vector<uint32_t> weld;
+		mc::vector<uint8_t>  locked;
+		weld.resize(vert_count);
+		locked.resize(vert_count);
+		{
+			uint32_t capacity {1};
+			while (capacity < vert_count * 2)
+				capacity *= 2;
+
+			mc::vector<uint32_t> table;
+			table.resize(capacity);
+			for (uint32_t& slot : table)
+				slot = UINT32_MAX;
+
+			for (uint32_t v {0}; v < vert_count; ++v)
+			{
+				uint32_t bits[3];
+				memcpy(bits, raw(v), sizeof(bits));
+				uint32_t hash = (bits[0] * 73856093u) ^ (bits[1] * 19349663u) ^
+				                (bits[2] * 83492791u);
+
+				uint32_t slot = hash & (capacity - 1);
+				while (table[slot] != UINT32_MAX &&
+				       memcmp(raw(table[slot]), raw(v), sizeof(bits)) != 0)
+					slot = (slot + 1) & (capacity - 1);
+
+				if (table[slot] == UINT32_MAX)
+				{
+					table[slot] = v;
+					weld[v] = v;
+				}
+				else
+				{
+					weld[v] = table[slot];
+					locked[v] = 1;
+					locked[table[slot]] = 1;
+				}
+			}
+		}
+
+		// Edges used by a single triangle are on a border
+		{
+			key_ids              ids {static_cast<uint32_t>(out.size())};
+			mc::vector<uint32_t> uses;
+			mc::vector<uint64_t> keys;
+			for (uint32_t i {0}; i < out.size(); ++i)
+			{
+				uint32_t a = weld[out[i]];
+				uint32_t b = weld[out[i - i % 3 + (i + 1) % 3]];
+
+				bool     found;
+				uint32_t id = ids.get(edge_key(a, b), found);
+				if (!found)
+				{
+					uses.emplace_back(0u);
+					keys.emplace_back(edge_key(a, b));
+				}
+				++uses[id];
+			}
+
+			for (uint32_t i {0}; i < uses.size(); ++i)
+			{
+				if (uses[i] != 1)
+					continue;
+				locked[keys[i] >> 32] = 1;
+				locked[keys[i] & UINT32_MAX] = 1;
+			}
+
+			// Locks propagate to the whole welded group
+			for (uint32_t v {0}; v < vert_count; ++v)
+				locked[v] |= locked[weld[v]];
+		}
+
+		// Area weighted planes of the source triangles, on the welded vertices
+		mc::vector<quadric> quadrics;
+		quadrics.resize(vert_count);
+		for (uint32_t i {0}; i < out.size(); i += 3)
+		{
+			vec3   p0 = pos(out[i]);
+			vec3   n = cross(sub(pos(out[i + 1]), p0), sub(pos(out[i + 2]), p0));
+			double len = sqrt(dot(n, n));
+			if (len == 0)
+				continue;
+
+			n = {n.x / len, n.y / len, n.z / len};
+			quadric q = quadric::plane(n, -dot(n, p0), len / 2);
+			for (uint32_t k {0}; k < 3; ++k)
+				quadrics[weld[out[i + k]]] += q;
+		}
+
+		float result_error {0.f};
+
+		mc::vector<uint32_t> tri_offsets;
+		mc::vector<uint32_t> vert_tris;
+		mc::vector<collapse> collapses;
+		mc::vector<collapse> sorted;
+		mc::vector<uint32_t> remap;
+		mc::vector<uint8_t>  touched;
+		remap.resize(vert_count);
+		touched.resize(vert_count);
+
+		// Each pass collapses independent edges by increasing error, then rebuilds the
+		// indices, until the target is reached
+		while (out.size() > target_idx_count)
+		{
+			uint32_t const tri_cnt = out.size() / 3;
+
+			// Triangles around each vertex
+			tri_offsets.clear();
+			tri_offsets.resize(vert_count + 1);
+			for (uint16_t idx : out)
+				++tri_offsets[idx + 1];
+			for (uint32_t v {0}; v < vert_count; ++v)
+				tri_offsets[v + 1] += tri_offsets[v];
+
+			vert_tris.resize(out.size());
+			for (uint32_t i {0}; i < out.size(); ++i)
+				vert_tris[tri_offsets[out[i]]++] = i / 3;
+			for (uint32_t v {vert_count}; v > 0; --v)
+				tri_offsets[v] = tri_offsets[v - 1];
+			tri_offsets[0] = 0;
+
+			// Cheapest direction of each edge, collapsing only unlocked vertices
+			collapses.clear();
+			for (uint32_t i {0}; i < out.size(); ++i)
+			{
+				uint32_t a = out[i];
+				uint32_t b = out[i - i % 3 + (i + 1) % 3];
+				// Shared edges are seen once per triangle, keep one
+				if (a > b || (locked[a] && locked[b]))
+					continue;
+
+				quadric q = quadrics[weld[a]];
+				q += quadrics[weld[b]];
+
+				collapse best {0, 0, FLT_MAX};
+				if (!locked[a])
+					best = {a, b, static_cast<float>(sqrt(q.eval(pos(b)) / q.weight))};
+				if (!locked[b])
+				{
+					float error = static_cast<float>(sqrt(q.eval(pos(a)) / q.weight));
+					if (error < best.error)
+						best = {b, a, error};
+				}
+
+				if (best.error <= max_error)
+					collapses.emplace_back(best);
+			}
+
+			if (collapses.empty())
+				break;
+
+			sort_collapses(collapses, sorted);
+
+			for (uint32_t v {0}; v < vert_count; ++v)
+			{
+				remap[v] = v;
+				touched[v] = 0;
+			}
+
+			// Each collapse removes about 2 triangles
+			uint32_t const target_tris = target_idx_count / 3;
+			uint32_t       removed {0};
+			uint32_t       applied {0};
+			for (collapse const& c : collapses)
+			{
+				if (tri_cnt - removed <= target_tris)
+					break;
+				if (touched[c.from] || touched[c.to])
+					continue;
+
+				// Rejects collapses flipping a remaining triangle around the vertex
+				vec3     to = pos(c.to);
+				bool     flips {false};
+				uint32_t degenerate {0};
+				for (uint32_t t = tri_offsets[c.from]; t < tri_offsets[c.from + 1]; ++t)
+				{
+					uint32_t const tri = vert_tris[t] * 3;
+					uint32_t       v[3] {out[tri], out[tri + 1], out[tri + 2]};
+					if (v[0] == c.to || v[1] == c.to || v[2] == c.to)
+					{
+						++degenerate;
+						continue;
+					}
+
+					vec3 p[3] {pos(v[0]), pos(v[1]), pos(v[2])};
+					vec3 before = cross(sub(p[1], p[0]), sub(p[2], p[0]));
+					for (uint32_t k {0}; k < 3; ++k)
+					{
+						if (v[k] == c.from)
+							p[k] = to;
+					}
+					vec3 after = cross(sub(p[1], p[0]), sub(p[2], p[0]));
+
+					// Over about 75 degrees of rotation, folds start to appear
+					if (dot(before, after) <= 0.25 * sqrt(dot(before, before) *
+					                                      dot(after, after)))
+					{
+						flips = true;
+						break;
+					}
+				}
+				if (flips)
+					continue;
+
+				// Triangles around the collapsed vertex change, so the whole ring waits
+				// for the next pass
+				for (uint32_t t = tri_offsets[c.from]; t < tri_offsets[c.from + 1]; ++t)
+				{
+					uint32_t const tri = vert_tris[t] * 3;
+					for (uint32_t k {0}; k < 3; ++k)
+						touched[out[tri + k]] = 1;
+				}
+
+				remap[c.from] = c.to;
+				quadrics[weld[c.to]] += quadrics[weld[c.from]];
+				if (c.error > result_error)
+					result_error = c.error;
+
+				removed += degenerate;
+				++applied;
+			}
+
+			if (applied == 0)
+				break;
+
+			// Drops the triangles collapsed to edges
+			uint32_t cnt {0};
+			for (uint32_t i {0}; i < out.size(); i += 3)
+			{
+				uint32_t a = remap[out[i]];
+				uint32_t b = remap[out[i + 1]];
+				uint32_t c = remap[out[i + 2]];
+				if (a == b || b == c || c == a)
+					continue;
+
+				out[cnt++] = a;
+				out[cnt++] = b;
+				out[cnt++] = c;
+			}
+			out.resize(cnt);
+		}
+
+		return result_error;
+	}
+
+	mc::vector<lod> build_lods(float const* positions, uint32_t stride,
+	                           uint32_t vert_count, mc::array_view<uint16_t> idcs,
+	                           uint32_t max_levels)
+	{
+		mc::vector<lod> lods;
+		if (max_levels == 0)
+			return lods;
+
+		lod& source = lods.emplace_back();
+		source.idcs.reserve(idcs.size());
+		for (uint16_t idx : idcs)
+			source.idcs.emplace_back(idx);
+
+		// Levels are simplified from the source, so that their error is measured against
+		// it rather than accumulated through the chain
+		while (lods.size() < max_levels)
+		{
+			uint32_t prev_cnt = lods[lods.size() - 1].idcs.size();
+			uint32_t target = prev_cnt / 6 * 3;
+
+			lod next;
+			next.error = simplify(positions, stride, vert_count, idcs, target, FLT_MAX,
+			                      next.idcs);
+
+			// Levels saving less than a sixth of the triangles are not worth a switch
+			if (next.idcs.size() > prev_cnt - prev_cnt / 6)
+				break;
+
+			lods.emplace_back(static_cast<lod&&>(next));
+		}
+
+		return lods;
+	}
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <array_view.hh>
+#include <vector.hh>
+
+#include <stdint.h>
+
+// Mesh simplification, run when meshes are imported rather than per frame. Positions
+// are read as 3 floats every `stride` bytes, so any vertex layout can be passed.
+namespace vkb::mesh
+{
+	// Quadric error metric edge collapses (Garland & Heckbert 1997). Vertices collapse
+	// onto existing ones, so `out` indexes the input vertices. Vertices sharing their
+	// position with others (attribute seams) and vertices on open borders are kept in
+	// place. Stops at `target_idx_count` indices, or when no collapse stays under
+	// `max_error`. Returns the error of the result, as a distance to the source surface
+	// in model units.
+	float simplify(float const* positions, uint32_t stride, uint32_t vert_count,
+	               mc::array_view<uint16_t> idcs, uint32_t target_idx_count,
+	               float max_error, mc::vector<uint16_t>& out);
+
+	struct lod
+	{
+		mc::vector<uint16_t> idcs;
+		// Distance to the source surface in model units, 0 for the source mesh
+		float error {0.f};
+	};
+
+	// Level 0 is the source mesh, then each level targets half the triangles of the
+	// previous one. Stops after `max_levels`, or when simplification stalls.
+	mc::vector<lod> build_lods(float const* positions, uint32_t stride,
+	                           uint32_t vert_count, mc::array_view<uint16_t> idcs,
+	                           uint32_t max_levels);
+}
@@ -0,0 +1,213 @@
+#include "sphere.hh"
+
+#include "../log.hh"
+#include "../math/trig.hh"
+
+#include <math.h>
+
+namespace vkb::mesh
+{
+	namespace
+	{
+		// Largest distance between a triangle plane and the unit sphere per subdivision
+		// level, measured on the generated meshes and rounded up. Midpoints are pushed
+		// back on the sphere, which makes triangles uneven, so the error does not
+		// simply quarter with each level.
+		float const icosphere_errors[max_icosphere_subdivisions + 1] {
+			2.06e-1f, 6.59e-2f, 1.78e-2f, 4.53e-3f, 1.14e-3f, 2.85e-4f, 7.14e-5f,
+		};
+
+		sphere_vert normalize(float x, float y, float z)
+		{
+			float inv_len = 1.f / sqrtf(x * x + y * y + z * z);
+			return {x * inv_len, y * inv_len, z * inv_len};
+		}
+
+		// Vertices added at the middle of edges while subdividing, shared by the two
+		// triangles of the edge. Open addressing on the sorted vertex pair.
+		class midpoints
+		{
+		public:
+			midpoints(uint32_t edge_count)
+			{
+				uint32_t capacity {1};
+				while (capacity < edge_count * 2)
+					capacity *= 2;
+
+				mask_ = capacity - 1;
+				keys_.resize(capacity);
+				vals_.resize(capacity);
+				for (uint32_t& key : keys_)
+					key = UINT32_MAX;
+			}
+
+			uint16_t get(uint16_t a, uint16_t b, mc::vector<sphere_vert>& verts)
+			{
+				uint32_t key = a < b ? (uint32_t {a} << 16) | b
+				                     : (uint32_t {b} << 16) | a;
+				uint32_t slot = (key * 2654435761u) & mask_;
+				while (keys_[slot] != UINT32_MAX)
+				{
+					if (keys_[slot] == key)
+						return vals_[slot];
+					slot = (slot + 1) & mask_;
+				}
+
+				sphere_vert const& va = verts[a];
+				sphere_vert const& vb = verts[b];
+				sphere_vert        mid = normalize(va.x + vb.x, va.y + vb.y, va.z + vb.z);
+
+				keys_[slot] = key;
+				vals_[slot] = verts.size();
+				verts.emplace_back(mid);
+
+				return vals_[slot];
+			}
+
+		private:
+			mc::vector<uint32_t> keys_;
+			mc::vector<uint16_t> vals_;
+			uint32_t             mask_ {0};
+		};
+	}
+
+	sphere_mesh icosphere(uint32_t subdivisions)
+	{
+		log::assert(subdivisions <= max_icosphere_subdivisions,
+		            "Icosphere subdivisions %u over the 16 bits index limit (max %u)",
+		            subdivisions, max_icosphere_subdivisions);
+
+		float const t {(1.f + sqrtf(5.f)) / 2.f};
+
+		// clang-format off
+		float const base_verts[12][3] {
+			{-1.f, t,    0.f}, {1.f,  t,    0.f}, {-1.f, -t,   0.f}, {1.f,  -t,   0.f},
+			{0.f,  -1.f, t  }, {0.f,  1.f,  t  }, {0.f,  -1.f, -t }, {0.f,  1.f,  -t },
+			{t,    0.f,  -1.f}, {t,    0.f,  1.f}, {-t,   0.f,  -1.f}, {-t,   0.f,  1.f},
+		};
+
+		uint16_t const base_idcs[60] {
+			0, 11, 5,  0, 5,  1, 0,  1,  7,  0,  7,  10, 0, 10, 11,
+			1, 5,  9,  5, 11, 4, 11, 10, 2,  10, 7,  6,  7, 1,  8,
+			3, 9,  4,  3, 4,  2, 3,  2,  6,  3,  6,  8,  3, 8,  9,
+			4, 9,  5,  2, 4,  11, 6, 2,  10, 8,  6,  7,  9, 8,  1,
+		};
+		// clang-format on
+
+		uint32_t const vert_count = 10 * (1u << (2 * subdivisions)) + 2;
+		uint32_t const tri_count = 20 * (1u << (2 * subdivisions));
+
+		sphere_mesh res;
+		res.verts.reserve(vert_count);
+		res.idcs.reserve(tri_count * 3);
+
+		for (float const(&v)[3] : base_verts)
+			res.verts.emplace_back(normalize(v[0], v[1], v[2]));
+		for (uint16_t idx : base_idcs)
+			res.idcs.emplace_back(idx);
+
+		mc::vector<uint16_t> split;
+		for (uint32_t lvl {0}; lvl < subdivisions; ++lvl)
+		{
+			// Each triangle is replaced by its 3 corners and the middle one
+			uint32_t  tri_cnt = res.idcs.size() / 3;
+			midpoints mids {tri_cnt * 3 / 2};
+
+			split.clear();
+			split.reserve(tri_cnt * 12);
+			for (uint32_t i {0}; i < tri_cnt; ++i)
+			{
+				uint16_t a = res.idcs[i * 3];
+				uint16_t b = res.idcs[i * 3 + 1];
+				uint16_t c = res.idcs[i * 3 + 2];
+				uint16_t ab = mids.get(a, b, res.verts);
+				uint16_t bc = mids.get(b, c, res.verts);
+				uint16_t ca = mids.get(c, a, res.verts);
+
+				uint16_t const tris[12] {a, ab, ca, b, bc, ab, c, ca, bc, ab, bc, ca};
+				for (uint16_t idx : tris)
+					split.emplace_back(idx);
+			}
+
+			res.idcs.clear();
+			for (uint16_t idx : split)
+				res.idcs.emplace_back(idx);
+		}
+
+		return res;
+	}
+
+	sphere_mesh uv_sphere(uint32_t rings, uint32_t segments)
+	{
+		log::assert(rings >= 2 && segments >= 3, "Degenerate UV sphere (%u x %u)", rings,
+		            segments);
+		log::assert((rings + 1) * (segments + 1) <= UINT16_MAX + 1u,
+		            "UV sphere over the 16 bits index limit (%u x %u)", rings, segments);
+
+		sphere_mesh res;
+		res.verts.reserve((rings + 1) * (segments + 1));
+		res.idcs.reserve(rings * segments * 6);
+
+		// Rings go from the north pole (+y) to the south pole
+		for (uint32_t r {0}; r <= rings; ++r)
+		{
+			float phi = pi * r / rings;
+			float y = cosf(phi);
+			float ring_radius = sinf(phi);
+			for (uint32_t s {0}; s <= segments; ++s)
+			{
+				float theta = 2.f * pi * s / segments;
+				float x = ring_radius * cosf(theta);
+				float z = -ring_radius * sinf(theta);
+				res.verts.emplace_back(sphere_vert {x, y, z});
+			}
+		}
+
+		uint32_t const stride = segments + 1;
+		for (uint32_t r {0}; r < rings; ++r)
+		{
+			for (uint32_t s {0}; s < segments; ++s)
+			{
+				uint16_t a = r * stride + s;
+				uint16_t b = a + 1;
+				uint16_t c = a + stride;
+				uint16_t d = c + 1;
+
+				// Pole quads collapse to a single triangle
+				if (r != 0)
+				{
+					uint16_t const tri[3] {a, c, b};
+					for (uint16_t idx : tri)
+						res.idcs.emplace_back(idx);
+				}
+				if (r != rings - 1)
+				{
+					uint16_t const tri[3] {b, c, d};
+					for (uint16_t idx : tri)
+						res.idcs.emplace_back(idx);
+				}
+			}
+		}
+
+		return res;
+	}
+
+	float icosphere_error(uint32_t subdivisions)
+	{
+		log::assert(subdivisions <= max_icosphere_subdivisions,
+		            "Icosphere subdivisions %u over the 16 bits index limit (max %u)",
+		            subdivisions, max_icosphere_subdivisions);
+
+		return icosphere_errors[subdivisions];
+	}
+
+	uint32_t icosphere_lod(float radius_px, float max_error_px)
+	{
+		uint32_t lvl {0};
+		while (lvl < max_icosphere_subdivisions &&
+		       radius_px * icosphere_error(lvl) > max_error_px)
+			++lvl;
+
+		return lvl;
+	}
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <vector.hh>
+
+#include <stdint.h>
+
+// Procedural unit spheres, generated at startup at the resolution they are drawn at
+namespace vkb::mesh
+{
+	// Position on the unit sphere, which is also the normal
+	struct sphere_vert
+	{
+		float x;
+		float y;
+		float z;
+	};
+
+	// Counter clockwise triangles seen from outside
+	struct sphere_mesh
+	{
+		mc::vector<sphere_vert> verts;
+		mc::vector<uint16_t>    idcs;
+	};
+
+	// 10 * 4^n + 2 vertices and 20 * 4^n triangles, the last level fitting 16 bits
+	// indices
+	constexpr uint32_t max_icosphere_subdivisions {6};
+
+	// Icosahedron whose triangles are split in 4 `subdivisions` times, with evenly
+	// sized triangles
+	sphere_mesh icosphere(uint32_t subdivisions);
+	// Latitude and longitude grid, denser at the poles. Seam vertices are duplicated
+	// so that uvs can be derived from the grid.
+	sphere_mesh uv_sphere(uint32_t rings, uint32_t segments);
+
+	// Largest distance between the icosphere and the unit sphere, the LOD error of
+	// a sphere of radius 1 (see mesh::build_lods)
+	float icosphere_error(uint32_t subdivisions);
+	// Coarsest icosphere subdivisions whose error projects under `max_error_px` pixels,
+	// for a sphere of `radius_px` pixels of radius on screen
+	uint32_t icosphere_lod(float radius_px, float max_error_px = 1.f);
+}
@@ -29,18 +29,17 @@ namespace vkb::mtl
 		return true;
 	}
 
-	bool context::prepare_draw()
+	bool context::prepare_draw(uint32_t w, uint32_t h)
 	{
 		instance& inst = instance::get();
 
 		bool need_resize = false;
-		if (surface_.need_resize())
+		if (surface_.need_resize(w, h))
 		{
-			surface_.resize();
+			surface_.resize(w, h);
 			depth_tex_->release();
 			create_depth_texture();
 
-			auto [w, h] = surface_.get_size();
 			proj_ = mat4::persp_proj(0.1f, 100.f, w / (float)h, rad(70));
 
 			need_resize = true;
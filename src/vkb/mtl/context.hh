@@ -40,7 +40,9 @@ namespace vkb::mtl
 		// void init_texture(texture& tex, mc::string_view path);
 		// void destroy_texture(texture& tex);
 
-		bool prepare_draw();
+		// Resizes the surface first when the window physical size `w` x `h` changed,
+		// returns whether it did
+		bool prepare_draw(uint32_t w, uint32_t h);
 		void begin_draw();
 		bool present();
 
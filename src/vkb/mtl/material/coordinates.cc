@@ -1,5 +1,4 @@
 #include "coordinates.hh"
-#include "vkb/cam/base.hh"
 #include "vkb/math/mat4.hh"
 #include "vkb/math/vec2.hh"
 #include "vkb/mtl/instance.hh"
@@ -61,14 +60,14 @@ namespace vkb::mtl
 		// TODO release resources
 	}
 
-	void coordinates::prepare_draw(uint32_t cur_img, cam::base const& cam,
-	                               mat4 const& proj, vec2 const& translate)
+	void coordinates::prepare_draw(uint32_t cur_img, mat4 const& rot, mat4 const& proj,
+	                               vec2 const& translate)
 	{
 		MTL::Buffer* buf = mvp_[cur_img];
 
 		mvp mvp;
 
-		mvp.view = cam.rot_mat();
+		mvp.view = rot;
 		mvp.proj = proj;
 		mvp.translate = translate;
 
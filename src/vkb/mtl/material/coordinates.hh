@@ -15,11 +15,6 @@ namespace vkb
 {
 	class mat4;
 	struct vec2;
-
-	namespace cam
-	{
-		class base;
-	}
 }
 
 namespace vkb::mtl
@@ -30,7 +25,8 @@ namespace vkb::mtl
 		coordinates();
 		~coordinates();
 
-		void prepare_draw(uint32_t cur_img, cam::base const& cam, mat4 const& proj,
+		// `rot` is the camera rotation, the axes don't follow its position
+		void prepare_draw(uint32_t cur_img, mat4 const& rot, mat4 const& proj,
 		                  vec2 const& translate);
 		void draw(uint32_t cur_img, MTL::RenderCommandEncoder* cmd);
 
@@ -43,16 +43,14 @@ namespace vkb::mtl
 		return layer_->nextDrawable();
 	}
 
-	bool surface::need_resize()
+	bool surface::need_resize(uint32_t w, uint32_t h)
 	{
 		CGSize drawable_size = layer_->drawableSize();
-		auto [w, h] = win_.physical_size();
 		return (drawable_size.width != w) || (drawable_size.height != h);
 	}
 
-	void surface::resize()
+	void surface::resize(uint32_t w, uint32_t h)
 	{
-		auto [w, h] = win_.physical_size();
 		layer_->setDrawableSize(CGSizeMake(w, h));
 	}
 }
\ No newline at end of file
@@ -24,8 +24,9 @@ namespace vkb::mtl
 		mc::pair<uint32_t, uint32_t> get_size();
 		CA::MetalDrawable*           get_drawable();
 
-		bool need_resize();
-		void resize();
+		// Against the window physical size, read by the thread handling its events
+		bool need_resize(uint32_t w, uint32_t h);
+		void resize(uint32_t w, uint32_t h);
 
 	private:
 		void set_window_layer();
@@ -0,0 +1,342 @@
+#include "cull.hh"
+
+#include "../core/jobs.hh"
+#include "../math/mat4.hh"
+
+#include <math.h>
+#include <string.h>
+
+#if defined(__SSE__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define VKB_CULL_NEON
+#endif
+
+namespace vkb::scene
+{
+	namespace
+	{
+		uint32_t append_mask(uint32_t mask, uint32_t base, uint32_t* visible)
+		{
+			uint32_t cnt {0};
+			while (mask)
+			{
+				visible[cnt++] = base + __builtin_ctz(mask);
+				mask &= mask - 1;
+			}
+
+			return cnt;
+		}
+
+		bool sphere_visible(frustum const& f, float x, float y, float z, float r)
+		{
+			for (uint32_t p {0}; p < 6; ++p)
+			{
+				float const* pl = f.planes[p];
+				if (pl[0] * x + pl[1] * y + pl[2] * z + pl[3] < -r)
+					return false;
+			}
+
+			return true;
+		}
+
+		bool aabb_visible(frustum const& f, float x, float y, float z, float ex, float ey,
+		                  float ez)
+		{
+			for (uint32_t p {0}; p < 6; ++p)
+			{
+				float const* pl = f.planes[p];
+				// Projected extent of the box on the plane normal
+				float r = fabsf(pl[0]) * ex + fabsf(pl[1]) * ey + fabsf(pl[2]) * ez;
+				if (pl[0] * x + pl[1] * y + pl[2] * z + pl[3] < -r)
+					return false;
+			}
+
+			return true;
+		}
+
+		// Chunks run on the job workers, each writing its visible indices at its own
+		// offset, then get packed together in order
+		template <typename F>
+		void cull_chunks(uint32_t count, mc::vector<uint32_t>& visible, F const& cull)
+		{
+			uint32_t const chunk_cnt = (count + cull_chunk_size - 1) / cull_chunk_size;
+
+			mc::vector<uint32_t> chunk_visible;
+			chunk_visible.resize(chunk_cnt);
+			visible.resize(count);
+
+			auto cull_range = [&](uint32_t first, uint32_t last)
+			{
+				for (uint32_t c {first}; c < last; ++c)
+				{
+					uint32_t begin = c * cull_chunk_size;
+					uint32_t end =
+						count - begin < cull_chunk_size ? count : begin + cull_chunk_size;
+					chunk_visible[c] = cull(begin, end, visible.data() + begin);
+				}
+			};
+			jobs::parallel_for(0, chunk_cnt, 1, cull_range);
+
+			uint32_t cnt {0};
+			for (uint32_t c {0}; c < chunk_cnt; ++c)
+			{
+				memmove(visible.data() + cnt, visible.data() + c * cull_chunk_size,
+				        chunk_visible[c] * sizeof(uint32_t));
+				cnt += chunk_visible[c];
+			}
+
+			visible.resize(cnt);
+		}
+	}
+
+	frustum extract_frustum(mat4 const& view_proj)
+	{
+		// clip = p * view_proj, so each clip component is a column of the matrix
+		auto column = [&view_proj](uint32_t c, float out[4])
+		{
+			for (uint8_t r {0}; r < 4; ++r)
+				out[r] = view_proj[r][c];
+		};
+
+		float cols[4][4];
+		for (uint32_t c {0}; c < 4; ++c)
+			column(c, cols[c]);
+
+		frustum f;
+		for (uint32_t i {0}; i < 4; ++i)
+		{
+			f.planes[0][i] = cols[3][i] + cols[0][i]; // left
+			f.planes[1][i] = cols[3][i] - cols[0][i]; // right
+			f.planes[2][i] = cols[3][i] + cols[1][i]; // top
+			f.planes[3][i] = cols[3][i] - cols[1][i]; // bottom
+			f.planes[4][i] = cols[2][i];              // near
+			f.planes[5][i] = cols[3][i] - cols[2][i]; // far
+		}
+
+		for (uint32_t p {0}; p < 6; ++p)
+		{
+			float* pl = f.planes[p];
+			float  len = sqrtf(pl[0] * pl[0] + pl[1] * pl[1] + pl[2] * pl[2]);
+			if (len > 0.f)
+			{
+				for (uint32_t i {0}; i < 4; ++i)
+					pl[i] /= len;
+			}
+		}
+
+		return f;
+	}
+
+	uint32_t cull_spheres(frustum const& f, sphere_soa const& spheres, uint32_t begin,
+	                      uint32_t end, uint32_t* visible)
+	{
+		uint32_t cnt {0};
+		uint32_t i {begin};
+
+#if defined(__AVX__)
+		for (; i + 8 <= end; i += 8)
+		{
+			__m256 x = _mm256_loadu_ps(spheres.x + i);
+			__m256 y = _mm256_loadu_ps(spheres.y + i);
+			__m256 z = _mm256_loadu_ps(spheres.z + i);
+			__m256 r = _mm256_loadu_ps(spheres.radius + i);
+			__m256 in = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+			for (uint32_t p {0}; p < 6; ++p)
+			{
+				float const* pl = f.planes[p];
+				__m256       d = _mm256_add_ps(r, _mm256_set1_ps(pl[3]));
+				d = _mm256_add_ps(d, _mm256_mul_ps(_mm256_set1_ps(pl[0]), x));
+				d = _mm256_add_ps(d, _mm256_mul_ps(_mm256_set1_ps(pl[1]), y));
+				d = _mm256_add_ps(d, _mm256_mul_ps(_mm256_set1_ps(pl[2]), z));
+				in = _mm256_and_ps(in, _mm256_cmp_ps(d, _mm256_setzero_ps(), _CMP_GE_OQ));
+			}
+
+			cnt += append_mask(_mm256_movemask_ps(in), i, visible + cnt);
+		}
+#endif
+
+#if defined(__SSE__)
+		for (; i + 4 <= end; i += 4)
+		{
+			__m128 x = _mm_loadu_ps(spheres.x + i);
+			__m128 y = _mm_loadu_ps(spheres.y + i);
+			__m128 z = _mm_loadu_ps(spheres.z + i);
+			__m128 r = _mm_loadu_ps(spheres.radius + i);
+			__m128 in = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+			for (uint32_t p {0}; p < 6; ++p)
+			{
+				float const* pl = f.planes[p];
+				__m128       d = _mm_add_ps(r, _mm_set1_ps(pl[3]));
+				d = _mm_add_ps(d, _mm_mul_ps(_mm_set1_ps(pl[0]), x));
+				d = _mm_add_ps(d, _mm_mul_ps(_mm_set1_ps(pl[1]), y));
+				d = _mm_add_ps(d, _mm_mul_ps(_mm_set1_ps(pl[2]), z));
+				in = _mm_and_ps(in, _mm_cmpge_ps(d, _mm_setzero_ps()));
+			}
+
+			cnt += append_mask(_mm_movemask_ps(in), i, visible + cnt);
+		}
+#elif defined(VKB_CULL_NEON)
+		uint32x4_t const lane_bits {1, 2, 4, 8};
+		for (; i + 4 <= end; i += 4)
+		{
+			float32x4_t x = vld1q_f32(spheres.x + i);
+			float32x4_t y = vld1q_f32(spheres.y + i);
+			float32x4_t z = vld1q_f32(spheres.z + i);
+			float32x4_t r = vld1q_f32(spheres.radius + i);
+			uint32x4_t  in = vdupq_n_u32(UINT32_MAX);
+
+			for (uint32_t p {0}; p < 6; ++p)
+			{
+				float const* pl = f.planes[p];
+				float32x4_t  d = vmlaq_n_f32(vaddq_f32(r, vdupq_n_f32(pl[3])), x, pl[0]);
+				d = vmlaq_n_f32(d, y, pl[1]);
+				d = vmlaq_n_f32(d, z, pl[2]);
+				in = vandq_u32(in, vcgeq_f32(d, vdupq_n_f32(0.f)));
+			}
+
+			cnt += append_mask(vaddvq_u32(vandq_u32(in, lane_bits)), i, visible + cnt);
+		}
+#endif
+
+		for (; i < end; ++i)
+		{
+			if (sphere_visible(f, spheres.x[i], spheres.y[i], spheres.z[i],
+			                   spheres.radius[i]))
+				visible[cnt++] = i;
+		}
+
+		return cnt;
+	}
+
+	uint32_t cull_aabbs(frustum const& f, aabb_soa const& aabbs, uint32_t begin,
+	                    uint32_t end, uint32_t* visible)
+	{
+		uint32_t cnt {0};
+		uint32_t i {begin};
+
+		float abs_normals[6][3];
+		for (uint32_t p {0}; p < 6; ++p)
+		{
+			for (uint32_t c {0}; c < 3; ++c)
+				abs_normals[p][c] = fabsf(f.planes[p][c]);
+		}
+
+#if defined(__AVX__)
+		for (; i + 8 <= end; i += 8)
+		{
+			__m256 x = _mm256_loadu_ps(aabbs.x + i);
+			__m256 y = _mm256_loadu_ps(aabbs.y + i);
+			__m256 z = _mm256_loadu_ps(aabbs.z + i);
+			__m256 ex = _mm256_loadu_ps(aabbs.extent_x + i);
+			__m256 ey = _mm256_loadu_ps(aabbs.extent_y + i);
+			__m256 ez = _mm256_loadu_ps(aabbs.extent_z + i);
+			__m256 in = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+			for (uint32_t p {0}; p < 6; ++p)
+			{
+				float const* pl = f.planes[p];
+				float const* an = abs_normals[p];
+				__m256       d = _mm256_set1_ps(pl[3]);
+				d = _mm256_add_ps(d, _mm256_mul_ps(_mm256_set1_ps(pl[0]), x));
+				d = _mm256_add_ps(d, _mm256_mul_ps(_mm256_set1_ps(pl[1]), y));
+				d = _mm256_add_ps(d, _mm256_mul_ps(_mm256_set1_ps(pl[2]), z));
+				d = _mm256_add_ps(d, _mm256_mul_ps(_mm256_set1_ps(an[0]), ex));
+				d = _mm256_add_ps(d, _mm256_mul_ps(_mm256_set1_ps(an[1]), ey));
+				d = _mm256_add_ps(d, _mm256_mul_ps(_mm256_set1_ps(an[2]), ez));
+				in = _mm256_and_ps(in, _mm256_cmp_ps(d, _mm256_setzero_ps(), _CMP_GE_OQ));
+			}
+
+			cnt += append_mask(_mm256_movemask_ps(in), i, visible + cnt);
+		}
+#endif
+
+#if defined(__SSE__)
+		for (; i + 4 <= end; i += 4)
+		{
+			__m128 x = _mm_loadu_ps(aabbs.x + i);
+			__m128 y = _mm_loadu_ps(aabbs.y + i);
+			__m128 z = _mm_loadu_ps(aabbs.z + i);
+			__m128 ex = _mm_loadu_ps(aabbs.extent_x + i);
+			__m128 ey = _mm_loadu_ps(aabbs.extent_y + i);
+			__m128 ez = _mm_loadu_ps(aabbs.extent_z + i);
+			__m128 in = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+			for (uint32_t p {0}; p < 6; ++p)
+			{
+				float const* pl = f.planes[p];
+				float const* an = abs_normals[p];
+				__m128       d = _mm_set1_ps(pl[3]);
+				d = _mm_add_ps(d, _mm_mul_ps(_mm_set1_ps(pl[0]), x));
+				d = _mm_add_ps(d, _mm_mul_ps(_mm_set1_ps(pl[1]), y));
+				d = _mm_add_ps(d, _mm_mul_ps(_mm_set1_ps(pl[2]), z));
+				d = _mm_add_ps(d, _mm_mul_ps(_mm_set1_ps(an[0]), ex));
+				d = _mm_add_ps(d, _mm_mul_ps(_mm_set1_ps(an[1]), ey));
+				d = _mm_add_ps(d, _mm_mul_ps(_mm_set1_ps(an[2]), ez));
+				in = _mm_and_ps(in, _mm_cmpge_ps(d, _mm_setzero_ps()));
+			}
+
+			cnt += append_mask(_mm_movemask_ps(in), i, visible + cnt);
+		}
+#elif defined(VKB_CULL_NEON)
+		uint32x4_t const lane_bits {1, 2, 4, 8};
+		for (; i + 4 <= end; i += 4)
+		{
+			float32x4_t x = vld1q_f32(aabbs.x + i);
+			float32x4_t y = vld1q_f32(aabbs.y + i);
+			float32x4_t z = vld1q_f32(aabbs.z + i);
+			float32x4_t ex = vld1q_f32(aabbs.extent_x + i);
+			float32x4_t ey = vld1q_f32(aabbs.extent_y + i);
+			float32x4_t ez = vld1q_f32(aabbs.extent_z + i);
+			uint32x4_t  in = vdupq_n_u32(UINT32_MAX);
+
+			for (uint32_t p {0}; p < 6; ++p)
+			{
+				float const* pl = f.planes[p];
+				float const* an = abs_normals[p];
+				float32x4_t  d = vmlaq_n_f32(vdupq_n_f32(pl[3]), x, pl[0]);
+				d = vmlaq_n_f32(d, y, pl[1]);
+				d = vmlaq_n_f32(d, z, pl[2]);
+				d = vmlaq_n_f32(d, ex, an[0]);
+				d = vmlaq_n_f32(d, ey, an[1]);
+				d = vmlaq_n_f32(d, ez, an[2]);
+				in = vandq_u32(in, vcgeq_f32(d, vdupq_n_f32(0.f)));
+			}
+
+			cnt += append_mask(vaddvq_u32(vandq_u32(in, lane_bits)), i, visible + cnt);
+		}
+#endif
+
+		for (; i < end; ++i)
+		{
+			if (aabb_visible(f, aabbs.x[i], aabbs.y[i], aabbs.z[i], aabbs.extent_x[i],
+			                 aabbs.extent_y[i], aabbs.extent_z[i]))
+				visible[cnt++] = i;
+		}
+
+		return cnt;
+	}
+
+	void cull_spheres(frustum const& f, sphere_soa const& spheres, uint32_t count,
+	                  mc::vector<uint32_t>& visible)
+	{
+		auto cull = [&f, &spheres](uint32_t begin, uint32_t end, uint32_t* out)
+		{
+			return cull_spheres(f, spheres, begin, end, out);
+		};
+		cull_chunks(count, visible, cull);
+	}
+
+	void cull_aabbs(frustum const& f, aabb_soa const& aabbs, uint32_t count,
+	                mc::vector<uint32_t>& visible)
+	{
+		auto cull = [&f, &aabbs](uint32_t begin, uint32_t end, uint32_t* out)
+		{
+			return cull_aabbs(f, aabbs, begin, end, out);
+		};
+		cull_chunks(count, visible, cull);
+	}
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <vector.hh>
+
+#include <stdint.h>
+
+namespace vkb
+{
+	class mat4;
+}
+
+namespace vkb::scene
+{
+	// Planes are stored as (nx, ny, nz, d) with normalized normals pointing inside,
+	// so a point p is inside the frustum when dot(n, p) + d >= 0 for all of them.
+	struct frustum
+	{
+		float planes[6][4];
+	};
+
+	// Extracted from the columns of a row vector view-projection matrix, using the
+	// Vulkan clip volume (0 <= z <= w)
+	frustum extract_frustum(mat4 const& view_proj);
+
+	// World space bounding volumes stored as one array per component
+	struct sphere_soa
+	{
+		float const* x;
+		float const* y;
+		float const* z;
+		float const* radius;
+	};
+
+	struct aabb_soa
+	{
+		float const* x;
+		float const* y;
+		float const* z;
+		float const* extent_x;
+		float const* extent_y;
+		float const* extent_z;
+	};
+
+	// Number of volumes processed by a single call to the range functions when
+	// culling a whole set, sized to spread work across threads
+	constexpr uint32_t cull_chunk_size {4096};
+
+	// Test volumes [begin, end), writing the indices of visible ones to `visible`,
+	// which needs room for end - begin indices. Returns the number of visible volumes.
+	// These have no shared state and can run concurrently on disjoint ranges.
+	uint32_t cull_spheres(frustum const& f, sphere_soa const& spheres, uint32_t begin,
+	                      uint32_t end, uint32_t* visible);
+	uint32_t cull_aabbs(frustum const& f, aabb_soa const& aabbs, uint32_t begin,
+	                    uint32_t end, uint32_t* visible);
+
+	// Test `count` volumes in chunks spread over the job workers, leaving the visible
+	// indices in ascending order in `visible`
+	void cull_spheres(frustum const& f, sphere_soa const& spheres, uint32_t count,
+	                  mc::vector<uint32_t>& visible);
+	void cull_aabbs(frustum const& f, aabb_soa const& aabbs, uint32_t count,
+	                mc::vector<uint32_t>& visible);
+}
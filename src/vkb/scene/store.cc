@@ -0,0 +1,521 @@
+#include "store.hh"
+
+#include "../core/jobs.hh"
+#include "../log.hh"
+#include "../math/batch.hh"
+#include "../math/quat.hh"
+#include "../math/trig.hh"
+
+#include <math.h>
+
+namespace vkb::scene
+{
+	namespace
+	{
+		template <typename T>
+		void swap_remove(mc::vector<T>& vec, uint32_t idx)
+		{
+			vec[idx] = vec.back();
+			vec.pop_back();
+		}
+
+		template <typename T>
+		void permute(mc::vector<T>& vec, mc::vector<uint32_t> const& order)
+		{
+			mc::vector<T> sorted;
+			sorted.reserve(order.size());
+			for (uint32_t i : order)
+				sorted.emplace_back(vec[i]);
+			vec = static_cast<mc::vector<T>&&>(sorted);
+		}
+
+		float row_len(mat4 const& m, uint8_t r)
+		{
+			return sqrtf(m[r][0] * m[r][0] + m[r][1] * m[r][1] + m[r][2] * m[r][2]);
+		}
+	}
+
+	handle store::create(object_desc const& desc, handle parent)
+	{
+		uint32_t parent_idx {UINT32_MAX};
+		uint32_t depth {0};
+		if (parent.index != UINT32_MAX)
+		{
+			uint32_t parent_dense = checked_index(parent);
+			parent_idx = parent.index;
+			depth = depths_[parent_dense] + 1;
+		}
+
+		handle h {};
+		if (!free_handles_.empty())
+		{
+			h.index = free_handles_.back();
+			free_handles_.pop_back();
+		}
+		else
+		{
+			h.index = sparse_.size();
+			sparse_.emplace_back(UINT32_MAX);
+			generations_.emplace_back(0u);
+			first_child_.emplace_back(UINT32_MAX);
+			next_sibling_.emplace_back(UINT32_MAX);
+			prev_sibling_.emplace_back(UINT32_MAX);
+		}
+		h.generation = generations_[h.index];
+		if (parent_idx != UINT32_MAX)
+			link(h.index, parent_idx);
+
+		uint32_t const idx = handles_.size();
+
+		// Appending keeps the order as long as the object is not above the last one
+		if (!layout_dirty_)
+		{
+			if (!depths_.empty() && depth < depths_.back())
+				layout_dirty_ = true;
+			else if (depth == levels_.size())
+				levels_.emplace_back(idx);
+		}
+
+		sparse_[h.index] = idx;
+		handles_.emplace_back(h.index);
+
+		parent_handles_.emplace_back(parent_idx);
+		parents_.emplace_back(parent_idx == UINT32_MAX ? UINT32_MAX
+		                                               : sparse_[parent_idx]);
+		depths_.emplace_back(depth);
+		dirty_.emplace_back(uint8_t {1});
+		if (depth < min_dirty_depth_)
+			min_dirty_depth_ = depth;
+		if (desc.rot_speed != 0.f)
+			++animated_cnt_;
+
+		pos_.emplace_back(desc.pos);
+		scale_.emplace_back(desc.scale);
+		rot_axis_.emplace_back(desc.rot_axis);
+		rot_.emplace_back(desc.rot);
+		rot_speed_.emplace_back(desc.rot_speed);
+
+		// Computed by the next update
+		transforms_.emplace_back(mat4::identity);
+		local_radius_.emplace_back(desc.radius);
+		bound_x_.emplace_back(0.f);
+		bound_y_.emplace_back(0.f);
+		bound_z_.emplace_back(0.f);
+		bound_radius_.emplace_back(0.f);
+
+		meshes_.emplace_back(desc.mesh);
+		materials_.emplace_back(desc.material);
+
+		return h;
+	}
+
+	void store::destroy(handle h)
+	{
+		checked_index(h);
+		unlink(h.index);
+
+		// Gathered before any removal, removals reset the links
+		mc::vector<uint32_t> subtree;
+		subtree.emplace_back(h.index);
+		for (uint32_t i {0}; i < subtree.size(); ++i)
+		{
+			for (uint32_t c {first_child_[subtree[i]]}; c != UINT32_MAX;
+			     c = next_sibling_[c])
+				subtree.emplace_back(c);
+		}
+
+		for (uint32_t handle_idx : subtree)
+			remove(handle_idx);
+	}
+
+	bool store::valid(handle h) const
+	{
+		return h.index < sparse_.size() && generations_[h.index] == h.generation &&
+		       sparse_[h.index] != UINT32_MAX;
+	}
+
+	uint32_t store::size() const
+	{
+		return handles_.size();
+	}
+
+	uint32_t store::dense_index(handle h) const
+	{
+		return checked_index(h);
+	}
+
+	handle store::get_handle(uint32_t dense) const
+	{
+		log::assert(dense < handles_.size(), "Invalid dense index %u", dense);
+
+		uint32_t idx = handles_[dense];
+		return {idx, generations_[idx]};
+	}
+
+	void store::set_parent(handle h, handle parent)
+	{
+		uint32_t idx = checked_index(h);
+
+		uint32_t parent_idx {UINT32_MAX};
+		if (parent.index != UINT32_MAX)
+		{
+			checked_index(parent);
+			parent_idx = parent.index;
+
+			for (uint32_t p {parent_idx}; p != UINT32_MAX;
+			     p = parent_handles_[sparse_[p]])
+				log::assert(p != h.index, "Parenting %u to %u would create a cycle",
+				            h.index, parent.index);
+		}
+
+		unlink(h.index);
+		if (parent_idx != UINT32_MAX)
+			link(h.index, parent_idx);
+
+		parent_handles_[idx] = parent_idx;
+		layout_dirty_ = true;
+		mark_dirty(idx);
+	}
+
+	handle store::get_parent(handle h) const
+	{
+		uint32_t parent_idx = parent_handles_[checked_index(h)];
+		if (parent_idx == UINT32_MAX)
+			return {};
+
+		return {parent_idx, generations_[parent_idx]};
+	}
+
+	void store::set_pos(handle h, vec4 pos)
+	{
+		uint32_t idx = checked_index(h);
+		pos_[idx] = pos;
+		mark_dirty(idx);
+	}
+
+	void store::set_scale(handle h, vec4 scale)
+	{
+		uint32_t idx = checked_index(h);
+		scale_[idx] = scale;
+		mark_dirty(idx);
+	}
+
+	void store::set_rotation(handle h, vec4 axis, float rot, float rot_speed)
+	{
+		uint32_t idx = checked_index(h);
+		if (rot_speed_[idx] == 0.f && rot_speed != 0.f)
+			++animated_cnt_;
+		else if (rot_speed_[idx] != 0.f && rot_speed == 0.f)
+			--animated_cnt_;
+
+		rot_axis_[idx] = axis;
+		rot_[idx] = rot;
+		rot_speed_[idx] = rot_speed;
+		mark_dirty(idx);
+	}
+
+	void store::set_mesh(handle h, uint32_t mesh)
+	{
+		meshes_[checked_index(h)] = mesh;
+	}
+
+	void store::set_material(handle h, uint32_t material)
+	{
+		materials_[checked_index(h)] = material;
+	}
+
+	void store::update(double dt)
+	{
+		uint32_t const cnt = handles_.size();
+
+		if (animated_cnt_)
+		{
+			float const step = static_cast<float>(dt);
+			for (uint32_t i {0}; i < cnt; ++i)
+			{
+				if (rot_speed_[i] == 0.f)
+					continue;
+
+				rot_[i] = fmodf(rot_[i] + step * rot_speed_[i], pi * 2.f);
+				dirty_[i] = 1;
+			}
+
+			// Conservative, animated objects are usually spread over every level
+			min_dirty_depth_ = 0;
+		}
+
+		if (layout_dirty_)
+			rebuild_layout();
+
+		// Nothing moved, static objects cost nothing
+		if (min_dirty_depth_ == UINT32_MAX)
+			return;
+
+		// Each level only reads transforms of the previous one and is split across
+		// the job workers
+		auto update_level = [this](uint32_t begin, uint32_t end)
+		{
+			update_range(begin, end);
+		};
+		for (uint32_t d {min_dirty_depth_}; d < levels_.size(); ++d)
+		{
+			uint32_t end = d + 1 < levels_.size() ? levels_[d + 1] : cnt;
+			jobs::parallel_for(levels_[d], end, update_grain, update_level);
+		}
+
+		for (uint32_t i {levels_[min_dirty_depth_]}; i < cnt; ++i)
+			dirty_[i] = 0;
+		min_dirty_depth_ = UINT32_MAX;
+	}
+
+	void store::cull(frustum const& f, mc::vector<uint32_t>& visible) const
+	{
+		cull_spheres(f, bounds(), handles_.size(), visible);
+	}
+
+	mat4 const* store::transforms() const
+	{
+		return transforms_.data();
+	}
+
+	uint32_t const* store::meshes() const
+	{
+		return meshes_.data();
+	}
+
+	uint32_t const* store::materials() const
+	{
+		return materials_.data();
+	}
+
+	sphere_soa store::bounds() const
+	{
+		return {bound_x_.data(), bound_y_.data(), bound_z_.data(), bound_radius_.data()};
+	}
+
+	uint32_t store::checked_index(handle h) const
+	{
+		log::assert(valid(h), "Invalid scene handle %u (generation %u)", h.index,
+		            h.generation);
+
+		return sparse_[h.index];
+	}
+
+	void store::mark_dirty(uint32_t idx)
+	{
+		dirty_[idx] = 1;
+		if (depths_[idx] < min_dirty_depth_)
+			min_dirty_depth_ = depths_[idx];
+	}
+
+	void store::link(uint32_t child, uint32_t parent)
+	{
+		uint32_t first = first_child_[parent];
+		next_sibling_[child] = first;
+		prev_sibling_[child] = UINT32_MAX;
+		if (first != UINT32_MAX)
+			prev_sibling_[first] = child;
+		first_child_[parent] = child;
+	}
+
+	void store::unlink(uint32_t child)
+	{
+		uint32_t parent = parent_handles_[sparse_[child]];
+		if (parent == UINT32_MAX)
+			return;
+
+		uint32_t prev = prev_sibling_[child];
+		uint32_t next = next_sibling_[child];
+		if (prev != UINT32_MAX)
+			next_sibling_[prev] = next;
+		else
+			first_child_[parent] = next;
+		if (next != UINT32_MAX)
+			prev_sibling_[next] = prev;
+
+		next_sibling_[child] = UINT32_MAX;
+		prev_sibling_[child] = UINT32_MAX;
+	}
+
+	void store::remove(uint32_t handle_idx)
+	{
+		uint32_t idx = sparse_[handle_idx];
+		if (rot_speed_[idx] != 0.f)
+			--animated_cnt_;
+
+		// The last object takes the freed slot, which breaks the depth order
+		sparse_[handles_.back()] = idx;
+		swap_remove(handles_, idx);
+		layout_dirty_ = true;
+
+		swap_remove(parent_handles_, idx);
+		swap_remove(parents_, idx);
+		swap_remove(depths_, idx);
+		swap_remove(dirty_, idx);
+
+		swap_remove(pos_, idx);
+		swap_remove(scale_, idx);
+		swap_remove(rot_axis_, idx);
+		swap_remove(rot_, idx);
+		swap_remove(rot_speed_, idx);
+		swap_remove(transforms_, idx);
+		swap_remove(local_radius_, idx);
+		swap_remove(bound_x_, idx);
+		swap_remove(bound_y_, idx);
+		swap_remove(bound_z_, idx);
+		swap_remove(bound_radius_, idx);
+		swap_remove(meshes_, idx);
+		swap_remove(materials_, idx);
+
+		sparse_[handle_idx] = UINT32_MAX;
+		++generations_[handle_idx];
+		first_child_[handle_idx] = UINT32_MAX;
+		next_sibling_[handle_idx] = UINT32_MAX;
+		prev_sibling_[handle_idx] = UINT32_MAX;
+		free_handles_.emplace_back(handle_idx);
+	}
+
+	void store::rebuild_layout()
+	{
+		uint32_t const cnt = handles_.size();
+
+		uint32_t max_depth {0};
+		bool     sorted {true};
+		for (uint32_t i {0}; i < cnt; ++i)
+		{
+			uint32_t depth {0};
+			for (uint32_t p {parent_handles_[i]}; p != UINT32_MAX;
+			     p = parent_handles_[sparse_[p]])
+				++depth;
+
+			depths_[i] = depth;
+			if (depth > max_depth)
+				max_depth = depth;
+			if (i > 0 && depth < depths_[i - 1])
+				sorted = false;
+		}
+
+		// Counting sort by depth, stable to keep siblings in creation order
+		levels_.clear();
+		if (cnt > 0)
+			levels_.resize(max_depth + 1);
+		for (uint32_t& level : levels_)
+			level = 0;
+		for (uint32_t i {0}; i < cnt; ++i)
+		{
+			if (depths_[i] < max_depth)
+				++levels_[depths_[i] + 1];
+		}
+		for (uint32_t d {1}; d < levels_.size(); ++d)
+			levels_[d] += levels_[d - 1];
+
+		if (!sorted)
+		{
+			mc::vector<uint32_t> next {levels_};
+			mc::vector<uint32_t> order;
+			order.resize(cnt);
+			for (uint32_t i {0}; i < cnt; ++i)
+				order[next[depths_[i]]++] = i;
+
+			permute(handles_, order);
+			permute(parent_handles_, order);
+			permute(depths_, order);
+			permute(dirty_, order);
+			permute(pos_, order);
+			permute(scale_, order);
+			permute(rot_axis_, order);
+			permute(rot_, order);
+			permute(rot_speed_, order);
+			permute(transforms_, order);
+			permute(local_radius_, order);
+			permute(bound_x_, order);
+			permute(bound_y_, order);
+			permute(bound_z_, order);
+			permute(bound_radius_, order);
+			permute(meshes_, order);
+			permute(materials_, order);
+
+			for (uint32_t i {0}; i < cnt; ++i)
+				sparse_[handles_[i]] = i;
+		}
+
+		parents_.resize(cnt);
+		min_dirty_depth_ = UINT32_MAX;
+		for (uint32_t i {0}; i < cnt; ++i)
+		{
+			uint32_t p = parent_handles_[i];
+			parents_[i] = p == UINT32_MAX ? UINT32_MAX : sparse_[p];
+
+			if (dirty_[i] && depths_[i] < min_dirty_depth_)
+				min_dirty_depth_ = depths_[i];
+		}
+
+		layout_dirty_ = false;
+	}
+
+	void store::update_range(uint32_t begin, uint32_t end)
+	{
+		// Dirty objects are gathered in blocks whose local transforms are composed
+		// together
+		constexpr uint32_t block {64};
+		uint32_t           idcs[block];
+		float              pos[3][block];
+		float              rot[4][block];
+		float              scale[3][block];
+		mat4               locals[block];
+
+		uint32_t i {begin};
+		while (i < end)
+		{
+			uint32_t cnt {0};
+			for (; i < end && cnt < block; ++i)
+			{
+				uint32_t p = parents_[i];
+				if (!dirty_[i] && (p == UINT32_MAX || !dirty_[p]))
+					continue;
+
+				// Lets children know their parent moved
+				dirty_[i] = 1;
+
+				quat q = quat::angle_axis(rot_axis_[i], rot_[i]);
+				idcs[cnt] = i;
+				pos[0][cnt] = pos_[i].x;
+				pos[1][cnt] = pos_[i].y;
+				pos[2][cnt] = pos_[i].z;
+				rot[0][cnt] = q.w;
+				rot[1][cnt] = q.x;
+				rot[2][cnt] = q.y;
+				rot[3][cnt] = q.z;
+				scale[0][cnt] = scale_[i].x;
+				scale[1][cnt] = scale_[i].y;
+				scale[2][cnt] = scale_[i].z;
+				++cnt;
+			}
+
+			math::compose_trs({pos[0], pos[1], pos[2]}, {rot[0], rot[1], rot[2], rot[3]},
+			                  {scale[0], scale[1], scale[2]}, locals, cnt);
+
+			for (uint32_t k {0}; k < cnt; ++k)
+			{
+				uint32_t idx = idcs[k];
+				uint32_t p = parents_[idx];
+				transforms_[idx] =
+					p == UINT32_MAX ? locals[k] : locals[k] * transforms_[p];
+
+				mat4 const& world = transforms_[idx];
+				float       max_scale = row_len(world, 0);
+				float       scale_y = row_len(world, 1);
+				float       scale_z = row_len(world, 2);
+				if (scale_y > max_scale)
+					max_scale = scale_y;
+				if (scale_z > max_scale)
+					max_scale = scale_z;
+
+				bound_x_[idx] = world[3][0];
+				bound_y_[idx] = world[3][1];
+				bound_z_[idx] = world[3][2];
+				bound_radius_[idx] = local_radius_[idx] * max_scale;
+			}
+		}
+	}
+}
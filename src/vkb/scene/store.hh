@@ -0,0 +1,135 @@
+#pragma once
+
+#include "../math/mat4.hh"
+#include "../math/vec4.hh"
+#include "cull.hh"
+
+#include <vector.hh>
+
+#include <stdint.h>
+
+namespace vkb::scene
+{
+	// Stable reference to an object. The generation detects handles to destroyed
+	// objects whose slot got reused.
+	struct handle
+	{
+		uint32_t index {UINT32_MAX};
+		uint32_t generation {0};
+	};
+
+	struct object_desc
+	{
+		vec4     pos {0.f, 0.f, 0.f, 1.f};
+		vec4     scale {1.f, 1.f, 1.f, 1.f};
+		vec4     rot_axis {0.f, 0.f, 1.f, 1.f};
+		float    rot {0.f};
+		float    rot_speed {0.f};
+		// Bounding sphere radius in model space, centered on the origin
+		float    radius {1.f};
+		uint32_t mesh {UINT32_MAX};
+		uint32_t material {UINT32_MAX};
+	};
+
+	// Renderable objects stored as one packed array per component, so that each pass
+	// only streams the components it touches.
+	// Position, scale and rotation are relative to the parent object. Arrays are kept
+	// sorted by depth in the hierarchy so that world transforms are computed level by
+	// level, parents first, and only for objects whose transform or one of their
+	// ancestors' changed. Dense indices change on structural changes, handles don't.
+	class store
+	{
+	public:
+		handle create(object_desc const& desc, handle parent = {});
+		// Also destroys the children
+		void   destroy(handle h);
+		bool   valid(handle h) const;
+
+		uint32_t size() const;
+		uint32_t dense_index(handle h) const;
+		handle   get_handle(uint32_t dense) const;
+
+		void   set_parent(handle h, handle parent);
+		handle get_parent(handle h) const;
+
+		void set_pos(handle h, vec4 pos);
+		void set_scale(handle h, vec4 scale);
+		void set_rotation(handle h, vec4 axis, float rot, float rot_speed);
+		void set_mesh(handle h, uint32_t mesh);
+		void set_material(handle h, uint32_t material);
+
+		// Advances rotations and rebuilds world transforms and bounds of modified
+		// objects and their descendants
+		void update(double dt);
+		// Dense indices of the objects intersecting `f`, from bounds of the last update
+		void cull(frustum const& f, mc::vector<uint32_t>& visible) const;
+
+		// Arrays indexed by dense index, valid after update
+		mat4 const*     transforms() const;
+		uint32_t const* meshes() const;
+		uint32_t const* materials() const;
+		sphere_soa      bounds() const;
+
+	private:
+		// Objects per job when updating a level
+		constexpr static uint32_t update_grain {1024};
+
+		uint32_t checked_index(handle h) const;
+		void     mark_dirty(uint32_t idx);
+
+		// Child lists, by handle index
+		void link(uint32_t child, uint32_t parent);
+		void unlink(uint32_t child);
+		// Removes the object from the dense arrays and frees its handle
+		void remove(uint32_t handle_idx);
+
+		// Sorts arrays by depth and rebuilds dense parent indices and level ranges
+		void rebuild_layout();
+		// World transforms and bounds of dirty objects in [begin, end), which must not
+		// hold a parent of another object of the range
+		void update_range(uint32_t begin, uint32_t end);
+
+		// Handle index to dense index, generation and free handle indices
+		mc::vector<uint32_t> sparse_;
+		mc::vector<uint32_t> generations_;
+		mc::vector<uint32_t> free_handles_;
+		// Handle index to first child and siblings, as handle indices. Indexed by
+		// handle so that they survive dense reorders.
+		mc::vector<uint32_t> first_child_;
+		mc::vector<uint32_t> next_sibling_;
+		mc::vector<uint32_t> prev_sibling_;
+		// Dense index to handle index
+		mc::vector<uint32_t> handles_;
+
+		// Hierarchy, parents as handle indices and, once the layout is rebuilt, as
+		// dense indices. levels_[d] is the first dense index of depth d.
+		mc::vector<uint32_t> parent_handles_;
+		mc::vector<uint32_t> parents_;
+		mc::vector<uint32_t> depths_;
+		mc::vector<uint32_t> levels_;
+		bool                 layout_dirty_ {false};
+
+		// Set on objects whose world transform needs an update, cleared by update
+		mc::vector<uint8_t> dirty_;
+		uint32_t            min_dirty_depth_ {UINT32_MAX};
+		uint32_t            animated_cnt_ {0};
+
+		// Local transform
+		mc::vector<vec4>  pos_;
+		mc::vector<vec4>  scale_;
+		mc::vector<vec4>  rot_axis_;
+		mc::vector<float> rot_;
+		mc::vector<float> rot_speed_;
+
+		// World transform and bounding sphere
+		mc::vector<mat4>  transforms_;
+		mc::vector<float> local_radius_;
+		mc::vector<float> bound_x_;
+		mc::vector<float> bound_y_;
+		mc::vector<float> bound_z_;
+		mc::vector<float> bound_radius_;
+
+		mc::vector<uint32_t> meshes_;
+		mc::vector<uint32_t> materials_;
+	};
+}
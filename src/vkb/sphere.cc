@@ -1,812 +0,0 @@
-#include "sphere.hh"
-
-namespace vkb
-{
-	vec4 sphere_vertices[] = {
-		{0.000000,  0.555570,  0.831470,  1.0},
-        {0.000000,  0.831470,  0.555570,  1.0},
-		{0.000000,  0.980785,  0.195090,  1.0},
-        {0.000000,  1.000000,  0.000000,  1.0},
-		{0.000000,  0.980785,  -0.195090, 1.0},
-        {0.000000,  0.831470,  -0.555570, 1.0},
-		{0.038060,  0.191342,  0.980785,  1.0},
-        {0.074658,  0.375330,  0.923880,  1.0},
-		{0.108386,  0.544895,  0.831470,  1.0},
-        {0.137950,  0.693520,  0.707107,  1.0},
-		{0.162212,  0.815493,  0.555570,  1.0},
-        {0.180240,  0.906127,  0.382683,  1.0},
-		{0.191342,  0.961940,  0.195090,  1.0},
-        {0.195090,  0.980785,  0.000000,  1.0},
-		{0.191342,  0.961940,  -0.195090, 1.0},
-        {0.180240,  0.906127,  -0.382683, 1.0},
-		{0.162212,  0.815493,  -0.555570, 1.0},
-        {0.137950,  0.693520,  -0.707107, 1.0},
-		{0.108386,  0.544895,  -0.831470, 1.0},
-        {0.074658,  0.375330,  -0.923880, 1.0},
-		{0.038060,  0.191342,  -0.980785, 1.0},
-        {0.074658,  0.180240,  0.980785,  1.0},
-		{0.146447,  0.353553,  0.923880,  1.0},
-        {0.212608,  0.513280,  0.831470,  1.0},
-		{0.270598,  0.653281,  0.707107,  1.0},
-        {0.318190,  0.768178,  0.555570,  1.0},
-		{0.353553,  0.853553,  0.382683,  1.0},
-        {0.375330,  0.906127,  0.195090,  1.0},
-		{0.382683,  0.923879,  0.000000,  1.0},
-        {0.375330,  0.906127,  -0.195090, 1.0},
-		{0.353553,  0.853553,  -0.382683, 1.0},
-        {0.318190,  0.768178,  -0.555570, 1.0},
-		{0.270598,  0.653281,  -0.707107, 1.0},
-        {0.212608,  0.513280,  -0.831470, 1.0},
-		{0.146447,  0.353553,  -0.923880, 1.0},
-        {0.074658,  0.180240,  -0.980785, 1.0},
-		{0.108386,  0.162212,  0.980785,  1.0},
-        {0.212608,  0.318190,  0.923880,  1.0},
-		{0.308658,  0.461940,  0.831470,  1.0},
-        {0.392847,  0.587938,  0.707107,  1.0},
-		{0.461940,  0.691342,  0.555570,  1.0},
-        {0.513280,  0.768178,  0.382683,  1.0},
-		{0.544895,  0.815493,  0.195090,  1.0},
-        {0.555570,  0.831469,  0.000000,  1.0},
-		{0.544895,  0.815493,  -0.195090, 1.0},
-        {0.513280,  0.768178,  -0.382683, 1.0},
-		{0.461940,  0.691342,  -0.555570, 1.0},
-        {0.392847,  0.587938,  -0.707107, 1.0},
-		{0.308658,  0.461940,  -0.831470, 1.0},
-        {0.212608,  0.318190,  -0.923880, 1.0},
-		{0.108386,  0.162212,  -0.980785, 1.0},
-        {0.137950,  0.137950,  0.980785,  1.0},
-		{0.270598,  0.270598,  0.923880,  1.0},
-        {0.392847,  0.392847,  0.831470,  1.0},
-		{0.500000,  0.500000,  0.707107,  1.0},
-        {0.587938,  0.587938,  0.555570,  1.0},
-		{0.653281,  0.653281,  0.382683,  1.0},
-        {0.693520,  0.693520,  0.195090,  1.0},
-		{0.707107,  0.707107,  0.000000,  1.0},
-        {0.693520,  0.693520,  -0.195090, 1.0},
-		{0.653281,  0.653281,  -0.382683, 1.0},
-        {0.587938,  0.587938,  -0.555570, 1.0},
-		{0.500000,  0.500000,  -0.707107, 1.0},
-        {0.392847,  0.392847,  -0.831470, 1.0},
-		{0.270598,  0.270598,  -0.923880, 1.0},
-        {0.137950,  0.137950,  -0.980785, 1.0},
-		{0.162212,  0.108386,  0.980785,  1.0},
-        {0.318190,  0.212608,  0.923880,  1.0},
-		{0.461940,  0.308658,  0.831470,  1.0},
-        {0.587938,  0.392847,  0.707107,  1.0},
-		{0.691342,  0.461940,  0.555570,  1.0},
-        {0.768178,  0.513280,  0.382683,  1.0},
-		{0.815493,  0.544895,  0.195090,  1.0},
-        {0.831470,  0.555570,  0.000000,  1.0},
-		{0.815493,  0.544895,  -0.195090, 1.0},
-        {0.768178,  0.513280,  -0.382683, 1.0},
-		{0.691342,  0.461940,  -0.555570, 1.0},
-        {0.587938,  0.392847,  -0.707107, 1.0},
-		{0.461940,  0.308658,  -0.831470, 1.0},
-        {0.318190,  0.212608,  -0.923880, 1.0},
-		{0.162212,  0.108386,  -0.980785, 1.0},
-        {0.000000,  0.000000,  1.000000,  1.0},
-		{0.180240,  0.074658,  0.980785,  1.0},
-        {0.353553,  0.146447,  0.923880,  1.0},
-		{0.513280,  0.212607,  0.831470,  1.0},
-        {0.653281,  0.270598,  0.707107,  1.0},
-		{0.768178,  0.318190,  0.555570,  1.0},
-        {0.853553,  0.353553,  0.382683,  1.0},
-		{0.906127,  0.375330,  0.195090,  1.0},
-        {0.923879,  0.382683,  0.000000,  1.0},
-		{0.906127,  0.375330,  -0.195090, 1.0},
-        {0.853553,  0.353553,  -0.382683, 1.0},
-		{0.768178,  0.318190,  -0.555570, 1.0},
-        {0.653281,  0.270598,  -0.707107, 1.0},
-		{0.513280,  0.212607,  -0.831470, 1.0},
-        {0.353553,  0.146447,  -0.923880, 1.0},
-		{0.180240,  0.074658,  -0.980785, 1.0},
-        {0.191342,  0.038060,  0.980785,  1.0},
-		{0.375330,  0.074658,  0.923880,  1.0},
-        {0.544895,  0.108386,  0.831470,  1.0},
-		{0.693520,  0.137950,  0.707107,  1.0},
-        {0.815493,  0.162212,  0.555570,  1.0},
-		{0.906127,  0.180240,  0.382683,  1.0},
-        {0.961940,  0.191342,  0.195090,  1.0},
-		{0.980785,  0.195090,  0.000000,  1.0},
-        {0.961940,  0.191342,  -0.195090, 1.0},
-		{0.906127,  0.180240,  -0.382683, 1.0},
-        {0.815493,  0.162212,  -0.555570, 1.0},
-		{0.693520,  0.137950,  -0.707107, 1.0},
-        {0.544895,  0.108386,  -0.831470, 1.0},
-		{0.375330,  0.074658,  -0.923880, 1.0},
-        {0.191342,  0.038060,  -0.980785, 1.0},
-		{0.195090,  -0.000000, 0.980785,  1.0},
-        {0.382683,  -0.000000, 0.923880,  1.0},
-		{0.555570,  -0.000000, 0.831470,  1.0},
-        {0.707107,  0.000000,  0.707107,  1.0},
-		{0.831469,  -0.000000, 0.555570,  1.0},
-        {0.923879,  0.000000,  0.382683,  1.0},
-		{0.980785,  -0.000000, 0.195090,  1.0},
-        {1.000000,  -0.000000, 0.000000,  1.0},
-		{0.980785,  -0.000000, -0.195090, 1.0},
-        {0.923879,  0.000000,  -0.382683, 1.0},
-		{0.831469,  -0.000000, -0.555570, 1.0},
-        {0.707107,  0.000000,  -0.707107, 1.0},
-		{0.555570,  -0.000000, -0.831470, 1.0},
-        {0.382683,  -0.000000, -0.923880, 1.0},
-		{0.195090,  -0.000000, -0.980785, 1.0},
-        {0.191342,  -0.038060, 0.980785,  1.0},
-		{0.375330,  -0.074658, 0.923880,  1.0},
-        {0.544895,  -0.108386, 0.831470,  1.0},
-		{0.693520,  -0.137950, 0.707107,  1.0},
-        {0.815493,  -0.162212, 0.555570,  1.0},
-		{0.906127,  -0.180240, 0.382683,  1.0},
-        {0.961940,  -0.191342, 0.195090,  1.0},
-		{0.980785,  -0.195090, 0.000000,  1.0},
-        {0.961940,  -0.191342, -0.195090, 1.0},
-		{0.906127,  -0.180240, -0.382683, 1.0},
-        {0.815493,  -0.162212, -0.555570, 1.0},
-		{0.693520,  -0.137950, -0.707107, 1.0},
-        {0.544895,  -0.108386, -0.831470, 1.0},
-		{0.375330,  -0.074658, -0.923880, 1.0},
-        {0.191342,  -0.038060, -0.980785, 1.0},
-		{0.180240,  -0.074658, 0.980785,  1.0},
-        {0.353553,  -0.146447, 0.923880,  1.0},
-		{0.513280,  -0.212608, 0.831470,  1.0},
-        {0.653281,  -0.270598, 0.707107,  1.0},
-		{0.768178,  -0.318190, 0.555570,  1.0},
-        {0.853553,  -0.353553, 0.382683,  1.0},
-		{0.906127,  -0.375330, 0.195090,  1.0},
-        {0.923879,  -0.382683, 0.000000,  1.0},
-		{0.906127,  -0.375330, -0.195090, 1.0},
-        {0.853553,  -0.353553, -0.382683, 1.0},
-		{0.768178,  -0.318190, -0.555570, 1.0},
-        {0.653281,  -0.270598, -0.707107, 1.0},
-		{0.513280,  -0.212608, -0.831470, 1.0},
-        {0.353553,  -0.146447, -0.923880, 1.0},
-		{0.180240,  -0.074658, -0.980785, 1.0},
-        {0.162212,  -0.108386, 0.980785,  1.0},
-		{0.318190,  -0.212608, 0.923880,  1.0},
-        {0.461940,  -0.308658, 0.831470,  1.0},
-		{0.587938,  -0.392847, 0.707107,  1.0},
-        {0.691341,  -0.461940, 0.555570,  1.0},
-		{0.768178,  -0.513280, 0.382683,  1.0},
-        {0.815493,  -0.544895, 0.195090,  1.0},
-		{0.831469,  -0.555570, 0.000000,  1.0},
-        {0.815493,  -0.544895, -0.195090, 1.0},
-		{0.768178,  -0.513280, -0.382683, 1.0},
-        {0.691341,  -0.461940, -0.555570, 1.0},
-		{0.587938,  -0.392847, -0.707107, 1.0},
-        {0.461940,  -0.308658, -0.831470, 1.0},
-		{0.318190,  -0.212608, -0.923880, 1.0},
-        {0.162212,  -0.108386, -0.980785, 1.0},
-		{0.137950,  -0.137950, 0.980785,  1.0},
-        {0.270598,  -0.270598, 0.923880,  1.0},
-		{0.392847,  -0.392847, 0.831470,  1.0},
-        {0.500000,  -0.500000, 0.707107,  1.0},
-		{0.587938,  -0.587938, 0.555570,  1.0},
-        {0.653281,  -0.653281, 0.382683,  1.0},
-		{0.693520,  -0.693520, 0.195090,  1.0},
-        {0.707106,  -0.707107, 0.000000,  1.0},
-		{0.693520,  -0.693520, -0.195090, 1.0},
-        {0.653281,  -0.653281, -0.382683, 1.0},
-		{0.587938,  -0.587938, -0.555570, 1.0},
-        {0.500000,  -0.500000, -0.707107, 1.0},
-		{0.392847,  -0.392847, -0.831470, 1.0},
-        {0.270598,  -0.270598, -0.923880, 1.0},
-		{0.137950,  -0.137950, -0.980785, 1.0},
-        {0.108386,  -0.162212, 0.980785,  1.0},
-		{0.212607,  -0.318190, 0.923880,  1.0},
-        {0.308658,  -0.461940, 0.831470,  1.0},
-		{0.392847,  -0.587938, 0.707107,  1.0},
-        {0.461940,  -0.691342, 0.555570,  1.0},
-		{0.513280,  -0.768178, 0.382683,  1.0},
-        {0.544895,  -0.815493, 0.195090,  1.0},
-		{0.555570,  -0.831469, 0.000000,  1.0},
-        {0.544895,  -0.815493, -0.195090, 1.0},
-		{0.513280,  -0.768178, -0.382683, 1.0},
-        {0.461940,  -0.691342, -0.555570, 1.0},
-		{0.392847,  -0.587938, -0.707107, 1.0},
-        {0.308658,  -0.461940, -0.831470, 1.0},
-		{0.212607,  -0.318190, -0.923880, 1.0},
-        {0.108386,  -0.162212, -0.980785, 1.0},
-		{0.074658,  -0.180240, 0.980785,  1.0},
-        {0.146447,  -0.353553, 0.923880,  1.0},
-		{0.212607,  -0.513280, 0.831470,  1.0},
-        {0.270598,  -0.653281, 0.707107,  1.0},
-		{0.318189,  -0.768178, 0.555570,  1.0},
-        {0.353553,  -0.853553, 0.382683,  1.0},
-		{0.375330,  -0.906127, 0.195090,  1.0},
-        {0.382683,  -0.923879, 0.000000,  1.0},
-		{0.375330,  -0.906127, -0.195090, 1.0},
-        {0.353553,  -0.853553, -0.382683, 1.0},
-		{0.318189,  -0.768178, -0.555570, 1.0},
-        {0.270598,  -0.653281, -0.707107, 1.0},
-		{0.212607,  -0.513280, -0.831470, 1.0},
-        {0.146447,  -0.353553, -0.923880, 1.0},
-		{0.074658,  -0.180240, -0.980785, 1.0},
-        {0.038060,  -0.191342, 0.980785,  1.0},
-		{0.074658,  -0.375330, 0.923880,  1.0},
-        {0.108386,  -0.544895, 0.831470,  1.0},
-		{0.137950,  -0.693520, 0.707107,  1.0},
-        {0.162212,  -0.815493, 0.555570,  1.0},
-		{0.180240,  -0.906127, 0.382683,  1.0},
-        {0.191342,  -0.961939, 0.195090,  1.0},
-		{0.195090,  -0.980785, 0.000000,  1.0},
-        {0.191342,  -0.961939, -0.195090, 1.0},
-		{0.180240,  -0.906127, -0.382683, 1.0},
-        {0.162212,  -0.815493, -0.555570, 1.0},
-		{0.137950,  -0.693520, -0.707107, 1.0},
-        {0.108386,  -0.544895, -0.831470, 1.0},
-		{0.074658,  -0.375330, -0.923880, 1.0},
-        {0.038060,  -0.191342, -0.980785, 1.0},
-		{-0.000000, -0.195090, 0.980785,  1.0},
-        {-0.000000, -0.382683, 0.923880,  1.0},
-		{-0.000000, -0.555570, 0.831470,  1.0},
-        {-0.000000, -0.707107, 0.707107,  1.0},
-		{-0.000000, -0.831469, 0.555570,  1.0},
-        {0.000000,  -0.923879, 0.382683,  1.0},
-		{-0.000000, -0.980785, 0.195090,  1.0},
-        {-0.000000, -0.999999, 0.000000,  1.0},
-		{-0.000000, -0.980785, -0.195090, 1.0},
-        {0.000000,  -0.923879, -0.382683, 1.0},
-		{-0.000000, -0.831469, -0.555570, 1.0},
-        {-0.000000, -0.707107, -0.707107, 1.0},
-		{-0.000000, -0.555570, -0.831470, 1.0},
-        {-0.000000, -0.382683, -0.923880, 1.0},
-		{-0.000000, -0.195090, -0.980785, 1.0},
-        {-0.038060, -0.191342, 0.980785,  1.0},
-		{-0.074658, -0.375330, 0.923880,  1.0},
-        {-0.108386, -0.544895, 0.831470,  1.0},
-		{-0.137950, -0.693520, 0.707107,  1.0},
-        {-0.162212, -0.815493, 0.555570,  1.0},
-		{-0.180240, -0.906127, 0.382683,  1.0},
-        {-0.191342, -0.961939, 0.195090,  1.0},
-		{-0.195091, -0.980785, 0.000000,  1.0},
-        {-0.191342, -0.961939, -0.195090, 1.0},
-		{-0.180240, -0.906127, -0.382683, 1.0},
-        {-0.162212, -0.815493, -0.555570, 1.0},
-		{-0.137950, -0.693520, -0.707107, 1.0},
-        {-0.108386, -0.544895, -0.831470, 1.0},
-		{-0.074658, -0.375330, -0.923880, 1.0},
-        {-0.038060, -0.191342, -0.980785, 1.0},
-		{-0.074658, -0.180240, 0.980785,  1.0},
-        {-0.146447, -0.353553, 0.923880,  1.0},
-		{-0.212608, -0.513280, 0.831470,  1.0},
-        {-0.270598, -0.653281, 0.707107,  1.0},
-		{-0.318190, -0.768177, 0.555570,  1.0},
-        {-0.353553, -0.853553, 0.382683,  1.0},
-		{-0.375330, -0.906127, 0.195090,  1.0},
-        {-0.382683, -0.923879, 0.000000,  1.0},
-		{-0.375330, -0.906127, -0.195090, 1.0},
-        {-0.353553, -0.853553, -0.382683, 1.0},
-		{-0.318190, -0.768177, -0.555570, 1.0},
-        {-0.270598, -0.653281, -0.707107, 1.0},
-		{-0.212608, -0.513280, -0.831470, 1.0},
-        {-0.146447, -0.353553, -0.923880, 1.0},
-		{-0.074658, -0.180240, -0.980785, 1.0},
-        {-0.108386, -0.162212, 0.980785,  1.0},
-		{-0.212608, -0.318190, 0.923880,  1.0},
-        {-0.308658, -0.461939, 0.831470,  1.0},
-		{-0.392847, -0.587938, 0.707107,  1.0},
-        {-0.461940, -0.691341, 0.555570,  1.0},
-		{-0.513280, -0.768178, 0.382683,  1.0},
-        {-0.544895, -0.815493, 0.195090,  1.0},
-		{-0.555570, -0.831469, 0.000000,  1.0},
-        {-0.544895, -0.815493, -0.195090, 1.0},
-		{-0.513280, -0.768178, -0.382683, 1.0},
-        {-0.461940, -0.691341, -0.555570, 1.0},
-		{-0.392847, -0.587938, -0.707107, 1.0},
-        {-0.308658, -0.461939, -0.831470, 1.0},
-		{-0.212608, -0.318190, -0.923880, 1.0},
-        {-0.108386, -0.162212, -0.980785, 1.0},
-		{-0.137950, -0.137950, 0.980785,  1.0},
-        {-0.270598, -0.270598, 0.923880,  1.0},
-		{-0.392847, -0.392847, 0.831470,  1.0},
-        {-0.500000, -0.500000, 0.707107,  1.0},
-		{-0.587938, -0.587937, 0.555570,  1.0},
-        {-0.653281, -0.653281, 0.382683,  1.0},
-		{-0.693520, -0.693520, 0.195090,  1.0},
-        {-0.707106, -0.707106, 0.000000,  1.0},
-		{-0.693520, -0.693520, -0.195090, 1.0},
-        {-0.653281, -0.653281, -0.382683, 1.0},
-		{-0.587938, -0.587937, -0.555570, 1.0},
-        {-0.500000, -0.500000, -0.707107, 1.0},
-		{-0.392847, -0.392847, -0.831470, 1.0},
-        {-0.270598, -0.270598, -0.923880, 1.0},
-		{-0.137950, -0.137950, -0.980785, 1.0},
-        {0.000000,  0.000000,  -1.000000, 1.0},
-		{-0.162212, -0.108386, 0.980785,  1.0},
-        {-0.318190, -0.212607, 0.923880,  1.0},
-		{-0.461940, -0.308658, 0.831470,  1.0},
-        {-0.587938, -0.392847, 0.707107,  1.0},
-		{-0.691341, -0.461939, 0.555570,  1.0},
-        {-0.768177, -0.513280, 0.382683,  1.0},
-		{-0.815493, -0.544895, 0.195090,  1.0},
-        {-0.831469, -0.555569, 0.000000,  1.0},
-		{-0.815493, -0.544895, -0.195090, 1.0},
-        {-0.768177, -0.513280, -0.382683, 1.0},
-		{-0.691341, -0.461939, -0.555570, 1.0},
-        {-0.587938, -0.392847, -0.707107, 1.0},
-		{-0.461940, -0.308658, -0.831470, 1.0},
-        {-0.318190, -0.212607, -0.923880, 1.0},
-		{-0.162212, -0.108386, -0.980785, 1.0},
-        {-0.180240, -0.074658, 0.980785,  1.0},
-		{-0.353553, -0.146447, 0.923880,  1.0},
-        {-0.513280, -0.212607, 0.831470,  1.0},
-		{-0.653281, -0.270598, 0.707107,  1.0},
-        {-0.768177, -0.318189, 0.555570,  1.0},
-		{-0.853553, -0.353553, 0.382683,  1.0},
-        {-0.906127, -0.375330, 0.195090,  1.0},
-		{-0.923879, -0.382683, 0.000000,  1.0},
-        {-0.906127, -0.375330, -0.195090, 1.0},
-		{-0.853553, -0.353553, -0.382683, 1.0},
-        {-0.768177, -0.318189, -0.555570, 1.0},
-		{-0.653281, -0.270598, -0.707107, 1.0},
-        {-0.513280, -0.212607, -0.831470, 1.0},
-		{-0.353553, -0.146447, -0.923880, 1.0},
-        {-0.180240, -0.074658, -0.980785, 1.0},
-		{-0.191342, -0.038060, 0.980785,  1.0},
-        {-0.375330, -0.074658, 0.923880,  1.0},
-		{-0.544895, -0.108386, 0.831470,  1.0},
-        {-0.693520, -0.137950, 0.707107,  1.0},
-		{-0.815493, -0.162211, 0.555570,  1.0},
-        {-0.906127, -0.180240, 0.382683,  1.0},
-		{-0.961939, -0.191341, 0.195090,  1.0},
-        {-0.980784, -0.195090, 0.000000,  1.0},
-		{-0.961939, -0.191341, -0.195090, 1.0},
-        {-0.906127, -0.180240, -0.382683, 1.0},
-		{-0.815493, -0.162211, -0.555570, 1.0},
-        {-0.693520, -0.137950, -0.707107, 1.0},
-		{-0.544895, -0.108386, -0.831470, 1.0},
-        {-0.375330, -0.074658, -0.923880, 1.0},
-		{-0.191342, -0.038060, -0.980785, 1.0},
-        {-0.195090, 0.000000,  0.980785,  1.0},
-		{-0.382683, 0.000000,  0.923880,  1.0},
-        {-0.555570, 0.000000,  0.831470,  1.0},
-		{-0.707107, 0.000000,  0.707107,  1.0},
-        {-0.831469, 0.000000,  0.555570,  1.0},
-		{-0.923879, 0.000000,  0.382683,  1.0},
-        {-0.980785, 0.000000,  0.195090,  1.0},
-		{-0.999999, 0.000000,  0.000000,  1.0},
-        {-0.980785, 0.000000,  -0.195090, 1.0},
-		{-0.923879, 0.000000,  -0.382683, 1.0},
-        {-0.831469, 0.000000,  -0.555570, 1.0},
-		{-0.707107, 0.000000,  -0.707107, 1.0},
-        {-0.555570, 0.000000,  -0.831470, 1.0},
-		{-0.382683, 0.000000,  -0.923880, 1.0},
-        {-0.195090, 0.000000,  -0.980785, 1.0},
-		{-0.191342, 0.038060,  0.980785,  1.0},
-        {-0.375330, 0.074658,  0.923880,  1.0},
-		{-0.544895, 0.108386,  0.831470,  1.0},
-        {-0.693520, 0.137950,  0.707107,  1.0},
-		{-0.815493, 0.162212,  0.555570,  1.0},
-        {-0.906127, 0.180240,  0.382683,  1.0},
-		{-0.961939, 0.191342,  0.195090,  1.0},
-        {-0.980784, 0.195091,  0.000000,  1.0},
-		{-0.961939, 0.191342,  -0.195090, 1.0},
-        {-0.906127, 0.180240,  -0.382683, 1.0},
-		{-0.815493, 0.162212,  -0.555570, 1.0},
-        {-0.693520, 0.137950,  -0.707107, 1.0},
-		{-0.544895, 0.108386,  -0.831470, 1.0},
-        {-0.375330, 0.074658,  -0.923880, 1.0},
-		{-0.191342, 0.038060,  -0.980785, 1.0},
-        {-0.180240, 0.074658,  0.980785,  1.0},
-		{-0.353553, 0.146447,  0.923880,  1.0},
-        {-0.513279, 0.212607,  0.831470,  1.0},
-		{-0.653281, 0.270598,  0.707107,  1.0},
-        {-0.768177, 0.318190,  0.555570,  1.0},
-		{-0.853553, 0.353553,  0.382683,  1.0},
-        {-0.906127, 0.375330,  0.195090,  1.0},
-		{-0.923878, 0.382683,  0.000000,  1.0},
-        {-0.906127, 0.375330,  -0.195090, 1.0},
-		{-0.853553, 0.353553,  -0.382683, 1.0},
-        {-0.768177, 0.318190,  -0.555570, 1.0},
-		{-0.653281, 0.270598,  -0.707107, 1.0},
-        {-0.513279, 0.212607,  -0.831470, 1.0},
-		{-0.353553, 0.146447,  -0.923880, 1.0},
-        {-0.180240, 0.074658,  -0.980785, 1.0},
-		{-0.162212, 0.108386,  0.980785,  1.0},
-        {-0.318189, 0.212607,  0.923880,  1.0},
-		{-0.461939, 0.308658,  0.831470,  1.0},
-        {-0.587938, 0.392847,  0.707107,  1.0},
-		{-0.691341, 0.461940,  0.555570,  1.0},
-        {-0.768177, 0.513280,  0.382683,  1.0},
-		{-0.815493, 0.544895,  0.195090,  1.0},
-        {-0.831468, 0.555570,  0.000000,  1.0},
-		{-0.815493, 0.544895,  -0.195090, 1.0},
-        {-0.768177, 0.513280,  -0.382683, 1.0},
-		{-0.691341, 0.461940,  -0.555570, 1.0},
-        {-0.587938, 0.392847,  -0.707107, 1.0},
-		{-0.461939, 0.308658,  -0.831470, 1.0},
-        {-0.318189, 0.212607,  -0.923880, 1.0},
-		{-0.162212, 0.108386,  -0.980785, 1.0},
-        {-0.137950, 0.137950,  0.980785,  1.0},
-		{-0.270598, 0.270598,  0.923880,  1.0},
-        {-0.392847, 0.392847,  0.831470,  1.0},
-		{-0.500000, 0.500000,  0.707107,  1.0},
-        {-0.587937, 0.587938,  0.555570,  1.0},
-		{-0.653281, 0.653281,  0.382683,  1.0},
-        {-0.693519, 0.693520,  0.195090,  1.0},
-		{-0.707106, 0.707106,  0.000000,  1.0},
-        {-0.693519, 0.693520,  -0.195090, 1.0},
-		{-0.653281, 0.653281,  -0.382683, 1.0},
-        {-0.587937, 0.587938,  -0.555570, 1.0},
-		{-0.500000, 0.500000,  -0.707107, 1.0},
-        {-0.392847, 0.392847,  -0.831470, 1.0},
-		{-0.270598, 0.270598,  -0.923880, 1.0},
-        {-0.137950, 0.137950,  -0.980785, 1.0},
-		{-0.108386, 0.162212,  0.980785,  1.0},
-        {-0.212607, 0.318190,  0.923880,  1.0},
-		{-0.308658, 0.461939,  0.831470,  1.0},
-        {-0.392847, 0.587938,  0.707107,  1.0},
-		{-0.461939, 0.691341,  0.555570,  1.0},
-        {-0.513280, 0.768177,  0.382683,  1.0},
-		{-0.544895, 0.815493,  0.195090,  1.0},
-        {-0.555569, 0.831469,  0.000000,  1.0},
-		{-0.544895, 0.815493,  -0.195090, 1.0},
-        {-0.513280, 0.768177,  -0.382683, 1.0},
-		{-0.461939, 0.691341,  -0.555570, 1.0},
-        {-0.392847, 0.587938,  -0.707107, 1.0},
-		{-0.308658, 0.461939,  -0.831470, 1.0},
-        {-0.212607, 0.318190,  -0.923880, 1.0},
-		{-0.108386, 0.162212,  -0.980785, 1.0},
-        {-0.074658, 0.180240,  0.980785,  1.0},
-		{-0.146446, 0.353553,  0.923880,  1.0},
-        {-0.212607, 0.513279,  0.831470,  1.0},
-		{-0.270598, 0.653281,  0.707107,  1.0},
-        {-0.318189, 0.768177,  0.555570,  1.0},
-		{-0.353553, 0.853553,  0.382683,  1.0},
-        {-0.375330, 0.906127,  0.195090,  1.0},
-		{-0.382683, 0.923879,  0.000000,  1.0},
-        {-0.375330, 0.906127,  -0.195090, 1.0},
-		{-0.353553, 0.853553,  -0.382683, 1.0},
-        {-0.318189, 0.768177,  -0.555570, 1.0},
-		{-0.270598, 0.653281,  -0.707107, 1.0},
-        {-0.212607, 0.513279,  -0.831470, 1.0},
-		{-0.146446, 0.353553,  -0.923880, 1.0},
-        {-0.074658, 0.180240,  -0.980785, 1.0},
-		{-0.038060, 0.191342,  0.980785,  1.0},
-        {-0.074658, 0.375330,  0.923880,  1.0},
-		{-0.108386, 0.544895,  0.831470,  1.0},
-        {-0.137950, 0.693520,  0.707107,  1.0},
-		{-0.162211, 0.815493,  0.555570,  1.0},
-        {-0.180240, 0.906127,  0.382683,  1.0},
-		{-0.191341, 0.961939,  0.195090,  1.0},
-        {-0.195090, 0.980784,  0.000000,  1.0},
-		{-0.191341, 0.961939,  -0.195090, 1.0},
-        {-0.180240, 0.906127,  -0.382683, 1.0},
-		{-0.162211, 0.815493,  -0.555570, 1.0},
-        {-0.137950, 0.693520,  -0.707107, 1.0},
-		{-0.108386, 0.544895,  -0.831470, 1.0},
-        {-0.074658, 0.375330,  -0.923880, 1.0},
-		{-0.038060, 0.191342,  -0.980785, 1.0},
-        {0.000000,  0.195090,  0.980785,  1.0},
-		{0.000000,  0.382683,  0.923880,  1.0},
-        {0.000000,  0.707107,  0.707107,  1.0},
-		{0.000000,  0.923879,  0.382683,  1.0},
-        {0.000000,  0.923879,  -0.382683, 1.0},
-		{0.000000,  0.707107,  -0.707107, 1.0},
-        {0.000000,  0.555570,  -0.831470, 1.0},
-		{0.000000,  0.382683,  -0.923880, 1.0},
-        {0.000000,  0.195090,  -0.980785, 1.0},
-	};
-
-	uint16_t sphere_indices[] {
-		480 - 1, 20 - 1,  481 - 1, 3 - 1,   12 - 1,  13 - 1,  481 - 1, 21 - 1,  482 - 1,
-		3 - 1,   14 - 1,  4 - 1,   474 - 1, 82 - 1,  7 - 1,   308 - 1, 482 - 1, 21 - 1,
-		4 - 1,   15 - 1,  5 - 1,   475 - 1, 7 - 1,   8 - 1,   5 - 1,   16 - 1,  478 - 1,
-		1 - 1,   8 - 1,   9 - 1,   478 - 1, 17 - 1,  6 - 1,   476 - 1, 9 - 1,   10 - 1,
-		6 - 1,   18 - 1,  479 - 1, 2 - 1,   10 - 1,  11 - 1,  479 - 1, 19 - 1,  480 - 1,
-		477 - 1, 11 - 1,  12 - 1,  19 - 1,  33 - 1,  34 - 1,  11 - 1,  27 - 1,  12 - 1,
-		20 - 1,  34 - 1,  35 - 1,  13 - 1,  27 - 1,  28 - 1,  20 - 1,  36 - 1,  21 - 1,
-		13 - 1,  29 - 1,  14 - 1,  7 - 1,   82 - 1,  22 - 1,  308 - 1, 21 - 1,  36 - 1,
-		14 - 1,  30 - 1,  15 - 1,  7 - 1,   23 - 1,  8 - 1,   15 - 1,  31 - 1,  16 - 1,
-		8 - 1,   24 - 1,  9 - 1,   16 - 1,  32 - 1,  17 - 1,  9 - 1,   25 - 1,  10 - 1,
-		17 - 1,  33 - 1,  18 - 1,  10 - 1,  26 - 1,  11 - 1,  22 - 1,  38 - 1,  23 - 1,
-		30 - 1,  46 - 1,  31 - 1,  23 - 1,  39 - 1,  24 - 1,  32 - 1,  46 - 1,  47 - 1,
-		24 - 1,  40 - 1,  25 - 1,  33 - 1,  47 - 1,  48 - 1,  25 - 1,  41 - 1,  26 - 1,
-		34 - 1,  48 - 1,  49 - 1,  26 - 1,  42 - 1,  27 - 1,  34 - 1,  50 - 1,  35 - 1,
-		27 - 1,  43 - 1,  28 - 1,  35 - 1,  51 - 1,  36 - 1,  28 - 1,  44 - 1,  29 - 1,
-		22 - 1,  82 - 1,  37 - 1,  308 - 1, 36 - 1,  51 - 1,  30 - 1,  44 - 1,  45 - 1,
-		41 - 1,  57 - 1,  42 - 1,  49 - 1,  65 - 1,  50 - 1,  43 - 1,  57 - 1,  58 - 1,
-		50 - 1,  66 - 1,  51 - 1,  44 - 1,  58 - 1,  59 - 1,  37 - 1,  82 - 1,  52 - 1,
-		308 - 1, 51 - 1,  66 - 1,  44 - 1,  60 - 1,  45 - 1,  37 - 1,  53 - 1,  38 - 1,
-		45 - 1,  61 - 1,  46 - 1,  38 - 1,  54 - 1,  39 - 1,  47 - 1,  61 - 1,  62 - 1,
-		39 - 1,  55 - 1,  40 - 1,  47 - 1,  63 - 1,  48 - 1,  40 - 1,  56 - 1,  41 - 1,
-		48 - 1,  64 - 1,  49 - 1,  60 - 1,  76 - 1,  61 - 1,  53 - 1,  69 - 1,  54 - 1,
-		62 - 1,  76 - 1,  77 - 1,  54 - 1,  70 - 1,  55 - 1,  62 - 1,  78 - 1,  63 - 1,
-		56 - 1,  70 - 1,  71 - 1,  63 - 1,  79 - 1,  64 - 1,  56 - 1,  72 - 1,  57 - 1,
-		65 - 1,  79 - 1,  80 - 1,  58 - 1,  72 - 1,  73 - 1,  65 - 1,  81 - 1,  66 - 1,
-		59 - 1,  73 - 1,  74 - 1,  52 - 1,  82 - 1,  67 - 1,  308 - 1, 66 - 1,  81 - 1,
-		59 - 1,  75 - 1,  60 - 1,  52 - 1,  68 - 1,  53 - 1,  79 - 1,  96 - 1,  80 - 1,
-		73 - 1,  88 - 1,  89 - 1,  81 - 1,  96 - 1,  97 - 1,  74 - 1,  89 - 1,  90 - 1,
-		67 - 1,  82 - 1,  83 - 1,  308 - 1, 81 - 1,  97 - 1,  74 - 1,  91 - 1,  75 - 1,
-		67 - 1,  84 - 1,  68 - 1,  75 - 1,  92 - 1,  76 - 1,  68 - 1,  85 - 1,  69 - 1,
-		77 - 1,  92 - 1,  93 - 1,  69 - 1,  86 - 1,  70 - 1,  77 - 1,  94 - 1,  78 - 1,
-		71 - 1,  86 - 1,  87 - 1,  78 - 1,  95 - 1,  79 - 1,  71 - 1,  88 - 1,  72 - 1,
-		93 - 1,  107 - 1, 108 - 1, 85 - 1,  101 - 1, 86 - 1,  93 - 1,  109 - 1, 94 - 1,
-		87 - 1,  101 - 1, 102 - 1, 95 - 1,  109 - 1, 110 - 1, 87 - 1,  103 - 1, 88 - 1,
-		96 - 1,  110 - 1, 111 - 1, 89 - 1,  103 - 1, 104 - 1, 96 - 1,  112 - 1, 97 - 1,
-		90 - 1,  104 - 1, 105 - 1, 83 - 1,  82 - 1,  98 - 1,  308 - 1, 97 - 1,  112 - 1,
-		90 - 1,  106 - 1, 91 - 1,  84 - 1,  98 - 1,  99 - 1,  91 - 1,  107 - 1, 92 - 1,
-		84 - 1,  100 - 1, 85 - 1,  111 - 1, 127 - 1, 112 - 1, 105 - 1, 119 - 1, 120 - 1,
-		98 - 1,  82 - 1,  113 - 1, 308 - 1, 112 - 1, 127 - 1, 105 - 1, 121 - 1, 106 - 1,
-		99 - 1,  113 - 1, 114 - 1, 106 - 1, 122 - 1, 107 - 1, 99 - 1,  115 - 1, 100 - 1,
-		108 - 1, 122 - 1, 123 - 1, 100 - 1, 116 - 1, 101 - 1, 108 - 1, 124 - 1, 109 - 1,
-		102 - 1, 116 - 1, 117 - 1, 110 - 1, 124 - 1, 125 - 1, 102 - 1, 118 - 1, 103 - 1,
-		110 - 1, 126 - 1, 111 - 1, 104 - 1, 118 - 1, 119 - 1, 115 - 1, 131 - 1, 116 - 1,
-		123 - 1, 139 - 1, 124 - 1, 117 - 1, 131 - 1, 132 - 1, 125 - 1, 139 - 1, 140 - 1,
-		117 - 1, 133 - 1, 118 - 1, 125 - 1, 141 - 1, 126 - 1, 119 - 1, 133 - 1, 134 - 1,
-		126 - 1, 142 - 1, 127 - 1, 120 - 1, 134 - 1, 135 - 1, 113 - 1, 82 - 1,  128 - 1,
-		308 - 1, 127 - 1, 142 - 1, 120 - 1, 136 - 1, 121 - 1, 113 - 1, 129 - 1, 114 - 1,
-		121 - 1, 137 - 1, 122 - 1, 114 - 1, 130 - 1, 115 - 1, 123 - 1, 137 - 1, 138 - 1,
-		135 - 1, 149 - 1, 150 - 1, 128 - 1, 82 - 1,  143 - 1, 308 - 1, 142 - 1, 157 - 1,
-		135 - 1, 151 - 1, 136 - 1, 128 - 1, 144 - 1, 129 - 1, 136 - 1, 152 - 1, 137 - 1,
-		130 - 1, 144 - 1, 145 - 1, 138 - 1, 152 - 1, 153 - 1, 130 - 1, 146 - 1, 131 - 1,
-		138 - 1, 154 - 1, 139 - 1, 132 - 1, 146 - 1, 147 - 1, 140 - 1, 154 - 1, 155 - 1,
-		132 - 1, 148 - 1, 133 - 1, 140 - 1, 156 - 1, 141 - 1, 134 - 1, 148 - 1, 149 - 1,
-		142 - 1, 156 - 1, 157 - 1, 153 - 1, 169 - 1, 154 - 1, 147 - 1, 161 - 1, 162 - 1,
-		155 - 1, 169 - 1, 170 - 1, 147 - 1, 163 - 1, 148 - 1, 155 - 1, 171 - 1, 156 - 1,
-		149 - 1, 163 - 1, 164 - 1, 156 - 1, 172 - 1, 157 - 1, 150 - 1, 164 - 1, 165 - 1,
-		143 - 1, 82 - 1,  158 - 1, 308 - 1, 157 - 1, 172 - 1, 150 - 1, 166 - 1, 151 - 1,
-		143 - 1, 159 - 1, 144 - 1, 151 - 1, 167 - 1, 152 - 1, 145 - 1, 159 - 1, 160 - 1,
-		153 - 1, 167 - 1, 168 - 1, 145 - 1, 161 - 1, 146 - 1, 158 - 1, 82 - 1,  173 - 1,
-		308 - 1, 172 - 1, 187 - 1, 165 - 1, 181 - 1, 166 - 1, 158 - 1, 174 - 1, 159 - 1,
-		166 - 1, 182 - 1, 167 - 1, 159 - 1, 175 - 1, 160 - 1, 168 - 1, 182 - 1, 183 - 1,
-		160 - 1, 176 - 1, 161 - 1, 168 - 1, 184 - 1, 169 - 1, 162 - 1, 176 - 1, 177 - 1,
-		169 - 1, 185 - 1, 170 - 1, 162 - 1, 178 - 1, 163 - 1, 171 - 1, 185 - 1, 186 - 1,
-		164 - 1, 178 - 1, 179 - 1, 172 - 1, 186 - 1, 187 - 1, 165 - 1, 179 - 1, 180 - 1,
-		177 - 1, 191 - 1, 192 - 1, 185 - 1, 199 - 1, 200 - 1, 177 - 1, 193 - 1, 178 - 1,
-		185 - 1, 201 - 1, 186 - 1, 179 - 1, 193 - 1, 194 - 1, 186 - 1, 202 - 1, 187 - 1,
-		180 - 1, 194 - 1, 195 - 1, 173 - 1, 82 - 1,  188 - 1, 308 - 1, 187 - 1, 202 - 1,
-		180 - 1, 196 - 1, 181 - 1, 174 - 1, 188 - 1, 189 - 1, 181 - 1, 197 - 1, 182 - 1,
-		175 - 1, 189 - 1, 190 - 1, 183 - 1, 197 - 1, 198 - 1, 175 - 1, 191 - 1, 176 - 1,
-		183 - 1, 199 - 1, 184 - 1, 195 - 1, 211 - 1, 196 - 1, 188 - 1, 204 - 1, 189 - 1,
-		196 - 1, 212 - 1, 197 - 1, 189 - 1, 205 - 1, 190 - 1, 198 - 1, 212 - 1, 213 - 1,
-		190 - 1, 206 - 1, 191 - 1, 198 - 1, 214 - 1, 199 - 1, 192 - 1, 206 - 1, 207 - 1,
-		200 - 1, 214 - 1, 215 - 1, 192 - 1, 208 - 1, 193 - 1, 200 - 1, 216 - 1, 201 - 1,
-		194 - 1, 208 - 1, 209 - 1, 201 - 1, 217 - 1, 202 - 1, 195 - 1, 209 - 1, 210 - 1,
-		188 - 1, 82 - 1,  203 - 1, 308 - 1, 202 - 1, 217 - 1, 215 - 1, 229 - 1, 230 - 1,
-		207 - 1, 223 - 1, 208 - 1, 215 - 1, 231 - 1, 216 - 1, 209 - 1, 223 - 1, 224 - 1,
-		216 - 1, 232 - 1, 217 - 1, 210 - 1, 224 - 1, 225 - 1, 203 - 1, 82 - 1,  218 - 1,
-		308 - 1, 217 - 1, 232 - 1, 210 - 1, 226 - 1, 211 - 1, 203 - 1, 219 - 1, 204 - 1,
-		211 - 1, 227 - 1, 212 - 1, 204 - 1, 220 - 1, 205 - 1, 213 - 1, 227 - 1, 228 - 1,
-		205 - 1, 221 - 1, 206 - 1, 213 - 1, 229 - 1, 214 - 1, 207 - 1, 221 - 1, 222 - 1,
-		226 - 1, 242 - 1, 227 - 1, 220 - 1, 234 - 1, 235 - 1, 228 - 1, 242 - 1, 243 - 1,
-		220 - 1, 236 - 1, 221 - 1, 228 - 1, 244 - 1, 229 - 1, 222 - 1, 236 - 1, 237 - 1,
-		230 - 1, 244 - 1, 245 - 1, 222 - 1, 238 - 1, 223 - 1, 230 - 1, 246 - 1, 231 - 1,
-		224 - 1, 238 - 1, 239 - 1, 232 - 1, 246 - 1, 247 - 1, 225 - 1, 239 - 1, 240 - 1,
-		218 - 1, 82 - 1,  233 - 1, 308 - 1, 232 - 1, 247 - 1, 225 - 1, 241 - 1, 226 - 1,
-		218 - 1, 234 - 1, 219 - 1, 245 - 1, 261 - 1, 246 - 1, 239 - 1, 253 - 1, 254 - 1,
-		246 - 1, 262 - 1, 247 - 1, 240 - 1, 254 - 1, 255 - 1, 233 - 1, 82 - 1,  248 - 1,
-		308 - 1, 247 - 1, 262 - 1, 240 - 1, 256 - 1, 241 - 1, 233 - 1, 249 - 1, 234 - 1,
-		241 - 1, 257 - 1, 242 - 1, 234 - 1, 250 - 1, 235 - 1, 243 - 1, 257 - 1, 258 - 1,
-		235 - 1, 251 - 1, 236 - 1, 243 - 1, 259 - 1, 244 - 1, 237 - 1, 251 - 1, 252 - 1,
-		245 - 1, 259 - 1, 260 - 1, 237 - 1, 253 - 1, 238 - 1, 249 - 1, 265 - 1, 250 - 1,
-		258 - 1, 272 - 1, 273 - 1, 250 - 1, 266 - 1, 251 - 1, 258 - 1, 274 - 1, 259 - 1,
-		252 - 1, 266 - 1, 267 - 1, 260 - 1, 274 - 1, 275 - 1, 252 - 1, 268 - 1, 253 - 1,
-		260 - 1, 276 - 1, 261 - 1, 254 - 1, 268 - 1, 269 - 1, 261 - 1, 277 - 1, 262 - 1,
-		255 - 1, 269 - 1, 270 - 1, 248 - 1, 82 - 1,  263 - 1, 308 - 1, 262 - 1, 277 - 1,
-		255 - 1, 271 - 1, 256 - 1, 249 - 1, 263 - 1, 264 - 1, 256 - 1, 272 - 1, 257 - 1,
-		269 - 1, 283 - 1, 284 - 1, 277 - 1, 291 - 1, 292 - 1, 270 - 1, 284 - 1, 285 - 1,
-		263 - 1, 82 - 1,  278 - 1, 308 - 1, 277 - 1, 292 - 1, 270 - 1, 286 - 1, 271 - 1,
-		264 - 1, 278 - 1, 279 - 1, 271 - 1, 287 - 1, 272 - 1, 264 - 1, 280 - 1, 265 - 1,
-		273 - 1, 287 - 1, 288 - 1, 265 - 1, 281 - 1, 266 - 1, 273 - 1, 289 - 1, 274 - 1,
-		267 - 1, 281 - 1, 282 - 1, 275 - 1, 289 - 1, 290 - 1, 267 - 1, 283 - 1, 268 - 1,
-		275 - 1, 291 - 1, 276 - 1, 288 - 1, 302 - 1, 303 - 1, 280 - 1, 296 - 1, 281 - 1,
-		288 - 1, 304 - 1, 289 - 1, 282 - 1, 296 - 1, 297 - 1, 290 - 1, 304 - 1, 305 - 1,
-		282 - 1, 298 - 1, 283 - 1, 290 - 1, 306 - 1, 291 - 1, 284 - 1, 298 - 1, 299 - 1,
-		292 - 1, 306 - 1, 307 - 1, 285 - 1, 299 - 1, 300 - 1, 278 - 1, 82 - 1,  293 - 1,
-		308 - 1, 292 - 1, 307 - 1, 285 - 1, 301 - 1, 286 - 1, 278 - 1, 294 - 1, 279 - 1,
-		286 - 1, 302 - 1, 287 - 1, 279 - 1, 295 - 1, 280 - 1, 306 - 1, 323 - 1, 307 - 1,
-		300 - 1, 315 - 1, 316 - 1, 293 - 1, 82 - 1,  309 - 1, 308 - 1, 307 - 1, 323 - 1,
-		300 - 1, 317 - 1, 301 - 1, 293 - 1, 310 - 1, 294 - 1, 301 - 1, 318 - 1, 302 - 1,
-		294 - 1, 311 - 1, 295 - 1, 303 - 1, 318 - 1, 319 - 1, 295 - 1, 312 - 1, 296 - 1,
-		303 - 1, 320 - 1, 304 - 1, 297 - 1, 312 - 1, 313 - 1, 305 - 1, 320 - 1, 321 - 1,
-		297 - 1, 314 - 1, 298 - 1, 305 - 1, 322 - 1, 306 - 1, 299 - 1, 314 - 1, 315 - 1,
-		311 - 1, 327 - 1, 312 - 1, 319 - 1, 335 - 1, 320 - 1, 312 - 1, 328 - 1, 313 - 1,
-		321 - 1, 335 - 1, 336 - 1, 313 - 1, 329 - 1, 314 - 1, 321 - 1, 337 - 1, 322 - 1,
-		315 - 1, 329 - 1, 330 - 1, 322 - 1, 338 - 1, 323 - 1, 316 - 1, 330 - 1, 331 - 1,
-		309 - 1, 82 - 1,  324 - 1, 308 - 1, 323 - 1, 338 - 1, 316 - 1, 332 - 1, 317 - 1,
-		309 - 1, 325 - 1, 310 - 1, 317 - 1, 333 - 1, 318 - 1, 310 - 1, 326 - 1, 311 - 1,
-		319 - 1, 333 - 1, 334 - 1, 331 - 1, 345 - 1, 346 - 1, 324 - 1, 82 - 1,  339 - 1,
-		308 - 1, 338 - 1, 353 - 1, 331 - 1, 347 - 1, 332 - 1, 324 - 1, 340 - 1, 325 - 1,
-		332 - 1, 348 - 1, 333 - 1, 325 - 1, 341 - 1, 326 - 1, 334 - 1, 348 - 1, 349 - 1,
-		326 - 1, 342 - 1, 327 - 1, 334 - 1, 350 - 1, 335 - 1, 328 - 1, 342 - 1, 343 - 1,
-		336 - 1, 350 - 1, 351 - 1, 328 - 1, 344 - 1, 329 - 1, 336 - 1, 352 - 1, 337 - 1,
-		330 - 1, 344 - 1, 345 - 1, 337 - 1, 353 - 1, 338 - 1, 349 - 1, 365 - 1, 350 - 1,
-		343 - 1, 357 - 1, 358 - 1, 351 - 1, 365 - 1, 366 - 1, 343 - 1, 359 - 1, 344 - 1,
-		351 - 1, 367 - 1, 352 - 1, 345 - 1, 359 - 1, 360 - 1, 352 - 1, 368 - 1, 353 - 1,
-		346 - 1, 360 - 1, 361 - 1, 339 - 1, 82 - 1,  354 - 1, 308 - 1, 353 - 1, 368 - 1,
-		346 - 1, 362 - 1, 347 - 1, 339 - 1, 355 - 1, 340 - 1, 347 - 1, 363 - 1, 348 - 1,
-		341 - 1, 355 - 1, 356 - 1, 349 - 1, 363 - 1, 364 - 1, 341 - 1, 357 - 1, 342 - 1,
-		308 - 1, 368 - 1, 383 - 1, 361 - 1, 377 - 1, 362 - 1, 354 - 1, 370 - 1, 355 - 1,
-		362 - 1, 378 - 1, 363 - 1, 356 - 1, 370 - 1, 371 - 1, 364 - 1, 378 - 1, 379 - 1,
-		356 - 1, 372 - 1, 357 - 1, 364 - 1, 380 - 1, 365 - 1, 358 - 1, 372 - 1, 373 - 1,
-		366 - 1, 380 - 1, 381 - 1, 358 - 1, 374 - 1, 359 - 1, 366 - 1, 382 - 1, 367 - 1,
-		360 - 1, 374 - 1, 375 - 1, 367 - 1, 383 - 1, 368 - 1, 361 - 1, 375 - 1, 376 - 1,
-		354 - 1, 82 - 1,  369 - 1, 381 - 1, 395 - 1, 396 - 1, 373 - 1, 389 - 1, 374 - 1,
-		381 - 1, 397 - 1, 382 - 1, 375 - 1, 389 - 1, 390 - 1, 382 - 1, 398 - 1, 383 - 1,
-		376 - 1, 390 - 1, 391 - 1, 369 - 1, 82 - 1,  384 - 1, 308 - 1, 383 - 1, 398 - 1,
-		376 - 1, 392 - 1, 377 - 1, 369 - 1, 385 - 1, 370 - 1, 377 - 1, 393 - 1, 378 - 1,
-		371 - 1, 385 - 1, 386 - 1, 379 - 1, 393 - 1, 394 - 1, 371 - 1, 387 - 1, 372 - 1,
-		379 - 1, 395 - 1, 380 - 1, 373 - 1, 387 - 1, 388 - 1, 385 - 1, 399 - 1, 400 - 1,
-		392 - 1, 408 - 1, 393 - 1, 385 - 1, 401 - 1, 386 - 1, 394 - 1, 408 - 1, 409 - 1,
-		386 - 1, 402 - 1, 387 - 1, 394 - 1, 410 - 1, 395 - 1, 388 - 1, 402 - 1, 403 - 1,
-		396 - 1, 410 - 1, 411 - 1, 388 - 1, 404 - 1, 389 - 1, 397 - 1, 411 - 1, 412 - 1,
-		390 - 1, 404 - 1, 405 - 1, 397 - 1, 413 - 1, 398 - 1, 391 - 1, 405 - 1, 406 - 1,
-		384 - 1, 82 - 1,  399 - 1, 308 - 1, 398 - 1, 413 - 1, 391 - 1, 407 - 1, 392 - 1,
-		403 - 1, 419 - 1, 404 - 1, 411 - 1, 427 - 1, 412 - 1, 405 - 1, 419 - 1, 420 - 1,
-		412 - 1, 428 - 1, 413 - 1, 406 - 1, 420 - 1, 421 - 1, 399 - 1, 82 - 1,  414 - 1,
-		308 - 1, 413 - 1, 428 - 1, 406 - 1, 422 - 1, 407 - 1, 399 - 1, 415 - 1, 400 - 1,
-		407 - 1, 423 - 1, 408 - 1, 401 - 1, 415 - 1, 416 - 1, 409 - 1, 423 - 1, 424 - 1,
-		401 - 1, 417 - 1, 402 - 1, 409 - 1, 425 - 1, 410 - 1, 403 - 1, 417 - 1, 418 - 1,
-		411 - 1, 425 - 1, 426 - 1, 422 - 1, 438 - 1, 423 - 1, 416 - 1, 430 - 1, 431 - 1,
-		424 - 1, 438 - 1, 439 - 1, 416 - 1, 432 - 1, 417 - 1, 424 - 1, 440 - 1, 425 - 1,
-		418 - 1, 432 - 1, 433 - 1, 426 - 1, 440 - 1, 441 - 1, 418 - 1, 434 - 1, 419 - 1,
-		426 - 1, 442 - 1, 427 - 1, 420 - 1, 434 - 1, 435 - 1, 427 - 1, 443 - 1, 428 - 1,
-		421 - 1, 435 - 1, 436 - 1, 414 - 1, 82 - 1,  429 - 1, 308 - 1, 428 - 1, 443 - 1,
-		421 - 1, 437 - 1, 422 - 1, 414 - 1, 430 - 1, 415 - 1, 441 - 1, 457 - 1, 442 - 1,
-		435 - 1, 449 - 1, 450 - 1, 442 - 1, 458 - 1, 443 - 1, 436 - 1, 450 - 1, 451 - 1,
-		429 - 1, 82 - 1,  444 - 1, 308 - 1, 443 - 1, 458 - 1, 436 - 1, 452 - 1, 437 - 1,
-		430 - 1, 444 - 1, 445 - 1, 437 - 1, 453 - 1, 438 - 1, 430 - 1, 446 - 1, 431 - 1,
-		439 - 1, 453 - 1, 454 - 1, 431 - 1, 447 - 1, 432 - 1, 439 - 1, 455 - 1, 440 - 1,
-		433 - 1, 447 - 1, 448 - 1, 441 - 1, 455 - 1, 456 - 1, 433 - 1, 449 - 1, 434 - 1,
-		446 - 1, 460 - 1, 461 - 1, 454 - 1, 468 - 1, 469 - 1, 446 - 1, 462 - 1, 447 - 1,
-		454 - 1, 470 - 1, 455 - 1, 448 - 1, 462 - 1, 463 - 1, 456 - 1, 470 - 1, 471 - 1,
-		448 - 1, 464 - 1, 449 - 1, 456 - 1, 472 - 1, 457 - 1, 450 - 1, 464 - 1, 465 - 1,
-		458 - 1, 472 - 1, 473 - 1, 451 - 1, 465 - 1, 466 - 1, 444 - 1, 82 - 1,  459 - 1,
-		308 - 1, 458 - 1, 473 - 1, 451 - 1, 467 - 1, 452 - 1, 444 - 1, 460 - 1, 445 - 1,
-		452 - 1, 468 - 1, 453 - 1, 465 - 1, 477 - 1, 3 - 1,   472 - 1, 482 - 1, 473 - 1,
-		466 - 1, 3 - 1,   4 - 1,   459 - 1, 82 - 1,  474 - 1, 308 - 1, 473 - 1, 482 - 1,
-		466 - 1, 5 - 1,   467 - 1, 460 - 1, 474 - 1, 475 - 1, 467 - 1, 478 - 1, 468 - 1,
-		461 - 1, 475 - 1, 1 - 1,   468 - 1, 6 - 1,   469 - 1, 462 - 1, 1 - 1,   476 - 1,
-		469 - 1, 479 - 1, 470 - 1, 463 - 1, 476 - 1, 2 - 1,   471 - 1, 479 - 1, 480 - 1,
-		464 - 1, 2 - 1,   477 - 1, 471 - 1, 481 - 1, 472 - 1, 480 - 1, 19 - 1,  20 - 1,
-		3 - 1,   477 - 1, 12 - 1,  481 - 1, 20 - 1,  21 - 1,  3 - 1,   13 - 1,  14 - 1,
-		4 - 1,   14 - 1,  15 - 1,  475 - 1, 474 - 1, 7 - 1,   5 - 1,   15 - 1,  16 - 1,
-		1 - 1,   475 - 1, 8 - 1,   478 - 1, 16 - 1,  17 - 1,  476 - 1, 1 - 1,   9 - 1,
-		6 - 1,   17 - 1,  18 - 1,  2 - 1,   476 - 1, 10 - 1,  479 - 1, 18 - 1,  19 - 1,
-		477 - 1, 2 - 1,   11 - 1,  19 - 1,  18 - 1,  33 - 1,  11 - 1,  26 - 1,  27 - 1,
-		20 - 1,  19 - 1,  34 - 1,  13 - 1,  12 - 1,  27 - 1,  20 - 1,  35 - 1,  36 - 1,
-		13 - 1,  28 - 1,  29 - 1,  14 - 1,  29 - 1,  30 - 1,  7 - 1,   22 - 1,  23 - 1,
-		15 - 1,  30 - 1,  31 - 1,  8 - 1,   23 - 1,  24 - 1,  16 - 1,  31 - 1,  32 - 1,
-		9 - 1,   24 - 1,  25 - 1,  17 - 1,  32 - 1,  33 - 1,  10 - 1,  25 - 1,  26 - 1,
-		22 - 1,  37 - 1,  38 - 1,  30 - 1,  45 - 1,  46 - 1,  23 - 1,  38 - 1,  39 - 1,
-		32 - 1,  31 - 1,  46 - 1,  24 - 1,  39 - 1,  40 - 1,  33 - 1,  32 - 1,  47 - 1,
-		25 - 1,  40 - 1,  41 - 1,  34 - 1,  33 - 1,  48 - 1,  26 - 1,  41 - 1,  42 - 1,
-		34 - 1,  49 - 1,  50 - 1,  27 - 1,  42 - 1,  43 - 1,  35 - 1,  50 - 1,  51 - 1,
-		28 - 1,  43 - 1,  44 - 1,  30 - 1,  29 - 1,  44 - 1,  41 - 1,  56 - 1,  57 - 1,
-		49 - 1,  64 - 1,  65 - 1,  43 - 1,  42 - 1,  57 - 1,  50 - 1,  65 - 1,  66 - 1,
-		44 - 1,  43 - 1,  58 - 1,  44 - 1,  59 - 1,  60 - 1,  37 - 1,  52 - 1,  53 - 1,
-		45 - 1,  60 - 1,  61 - 1,  38 - 1,  53 - 1,  54 - 1,  47 - 1,  46 - 1,  61 - 1,
-		39 - 1,  54 - 1,  55 - 1,  47 - 1,  62 - 1,  63 - 1,  40 - 1,  55 - 1,  56 - 1,
-		48 - 1,  63 - 1,  64 - 1,  60 - 1,  75 - 1,  76 - 1,  53 - 1,  68 - 1,  69 - 1,
-		62 - 1,  61 - 1,  76 - 1,  54 - 1,  69 - 1,  70 - 1,  62 - 1,  77 - 1,  78 - 1,
-		56 - 1,  55 - 1,  70 - 1,  63 - 1,  78 - 1,  79 - 1,  56 - 1,  71 - 1,  72 - 1,
-		65 - 1,  64 - 1,  79 - 1,  58 - 1,  57 - 1,  72 - 1,  65 - 1,  80 - 1,  81 - 1,
-		59 - 1,  58 - 1,  73 - 1,  59 - 1,  74 - 1,  75 - 1,  52 - 1,  67 - 1,  68 - 1,
-		79 - 1,  95 - 1,  96 - 1,  73 - 1,  72 - 1,  88 - 1,  81 - 1,  80 - 1,  96 - 1,
-		74 - 1,  73 - 1,  89 - 1,  74 - 1,  90 - 1,  91 - 1,  67 - 1,  83 - 1,  84 - 1,
-		75 - 1,  91 - 1,  92 - 1,  68 - 1,  84 - 1,  85 - 1,  77 - 1,  76 - 1,  92 - 1,
-		69 - 1,  85 - 1,  86 - 1,  77 - 1,  93 - 1,  94 - 1,  71 - 1,  70 - 1,  86 - 1,
-		78 - 1,  94 - 1,  95 - 1,  71 - 1,  87 - 1,  88 - 1,  93 - 1,  92 - 1,  107 - 1,
-		85 - 1,  100 - 1, 101 - 1, 93 - 1,  108 - 1, 109 - 1, 87 - 1,  86 - 1,  101 - 1,
-		95 - 1,  94 - 1,  109 - 1, 87 - 1,  102 - 1, 103 - 1, 96 - 1,  95 - 1,  110 - 1,
-		89 - 1,  88 - 1,  103 - 1, 96 - 1,  111 - 1, 112 - 1, 90 - 1,  89 - 1,  104 - 1,
-		90 - 1,  105 - 1, 106 - 1, 84 - 1,  83 - 1,  98 - 1,  91 - 1,  106 - 1, 107 - 1,
-		84 - 1,  99 - 1,  100 - 1, 111 - 1, 126 - 1, 127 - 1, 105 - 1, 104 - 1, 119 - 1,
-		105 - 1, 120 - 1, 121 - 1, 99 - 1,  98 - 1,  113 - 1, 106 - 1, 121 - 1, 122 - 1,
-		99 - 1,  114 - 1, 115 - 1, 108 - 1, 107 - 1, 122 - 1, 100 - 1, 115 - 1, 116 - 1,
-		108 - 1, 123 - 1, 124 - 1, 102 - 1, 101 - 1, 116 - 1, 110 - 1, 109 - 1, 124 - 1,
-		102 - 1, 117 - 1, 118 - 1, 110 - 1, 125 - 1, 126 - 1, 104 - 1, 103 - 1, 118 - 1,
-		115 - 1, 130 - 1, 131 - 1, 123 - 1, 138 - 1, 139 - 1, 117 - 1, 116 - 1, 131 - 1,
-		125 - 1, 124 - 1, 139 - 1, 117 - 1, 132 - 1, 133 - 1, 125 - 1, 140 - 1, 141 - 1,
-		119 - 1, 118 - 1, 133 - 1, 126 - 1, 141 - 1, 142 - 1, 120 - 1, 119 - 1, 134 - 1,
-		120 - 1, 135 - 1, 136 - 1, 113 - 1, 128 - 1, 129 - 1, 121 - 1, 136 - 1, 137 - 1,
-		114 - 1, 129 - 1, 130 - 1, 123 - 1, 122 - 1, 137 - 1, 135 - 1, 134 - 1, 149 - 1,
-		135 - 1, 150 - 1, 151 - 1, 128 - 1, 143 - 1, 144 - 1, 136 - 1, 151 - 1, 152 - 1,
-		130 - 1, 129 - 1, 144 - 1, 138 - 1, 137 - 1, 152 - 1, 130 - 1, 145 - 1, 146 - 1,
-		138 - 1, 153 - 1, 154 - 1, 132 - 1, 131 - 1, 146 - 1, 140 - 1, 139 - 1, 154 - 1,
-		132 - 1, 147 - 1, 148 - 1, 140 - 1, 155 - 1, 156 - 1, 134 - 1, 133 - 1, 148 - 1,
-		142 - 1, 141 - 1, 156 - 1, 153 - 1, 168 - 1, 169 - 1, 147 - 1, 146 - 1, 161 - 1,
-		155 - 1, 154 - 1, 169 - 1, 147 - 1, 162 - 1, 163 - 1, 155 - 1, 170 - 1, 171 - 1,
-		149 - 1, 148 - 1, 163 - 1, 156 - 1, 171 - 1, 172 - 1, 150 - 1, 149 - 1, 164 - 1,
-		150 - 1, 165 - 1, 166 - 1, 143 - 1, 158 - 1, 159 - 1, 151 - 1, 166 - 1, 167 - 1,
-		145 - 1, 144 - 1, 159 - 1, 153 - 1, 152 - 1, 167 - 1, 145 - 1, 160 - 1, 161 - 1,
-		165 - 1, 180 - 1, 181 - 1, 158 - 1, 173 - 1, 174 - 1, 166 - 1, 181 - 1, 182 - 1,
-		159 - 1, 174 - 1, 175 - 1, 168 - 1, 167 - 1, 182 - 1, 160 - 1, 175 - 1, 176 - 1,
-		168 - 1, 183 - 1, 184 - 1, 162 - 1, 161 - 1, 176 - 1, 169 - 1, 184 - 1, 185 - 1,
-		162 - 1, 177 - 1, 178 - 1, 171 - 1, 170 - 1, 185 - 1, 164 - 1, 163 - 1, 178 - 1,
-		172 - 1, 171 - 1, 186 - 1, 165 - 1, 164 - 1, 179 - 1, 177 - 1, 176 - 1, 191 - 1,
-		185 - 1, 184 - 1, 199 - 1, 177 - 1, 192 - 1, 193 - 1, 185 - 1, 200 - 1, 201 - 1,
-		179 - 1, 178 - 1, 193 - 1, 186 - 1, 201 - 1, 202 - 1, 180 - 1, 179 - 1, 194 - 1,
-		180 - 1, 195 - 1, 196 - 1, 174 - 1, 173 - 1, 188 - 1, 181 - 1, 196 - 1, 197 - 1,
-		175 - 1, 174 - 1, 189 - 1, 183 - 1, 182 - 1, 197 - 1, 175 - 1, 190 - 1, 191 - 1,
-		183 - 1, 198 - 1, 199 - 1, 195 - 1, 210 - 1, 211 - 1, 188 - 1, 203 - 1, 204 - 1,
-		196 - 1, 211 - 1, 212 - 1, 189 - 1, 204 - 1, 205 - 1, 198 - 1, 197 - 1, 212 - 1,
-		190 - 1, 205 - 1, 206 - 1, 198 - 1, 213 - 1, 214 - 1, 192 - 1, 191 - 1, 206 - 1,
-		200 - 1, 199 - 1, 214 - 1, 192 - 1, 207 - 1, 208 - 1, 200 - 1, 215 - 1, 216 - 1,
-		194 - 1, 193 - 1, 208 - 1, 201 - 1, 216 - 1, 217 - 1, 195 - 1, 194 - 1, 209 - 1,
-		215 - 1, 214 - 1, 229 - 1, 207 - 1, 222 - 1, 223 - 1, 215 - 1, 230 - 1, 231 - 1,
-		209 - 1, 208 - 1, 223 - 1, 216 - 1, 231 - 1, 232 - 1, 210 - 1, 209 - 1, 224 - 1,
-		210 - 1, 225 - 1, 226 - 1, 203 - 1, 218 - 1, 219 - 1, 211 - 1, 226 - 1, 227 - 1,
-		204 - 1, 219 - 1, 220 - 1, 213 - 1, 212 - 1, 227 - 1, 205 - 1, 220 - 1, 221 - 1,
-		213 - 1, 228 - 1, 229 - 1, 207 - 1, 206 - 1, 221 - 1, 226 - 1, 241 - 1, 242 - 1,
-		220 - 1, 219 - 1, 234 - 1, 228 - 1, 227 - 1, 242 - 1, 220 - 1, 235 - 1, 236 - 1,
-		228 - 1, 243 - 1, 244 - 1, 222 - 1, 221 - 1, 236 - 1, 230 - 1, 229 - 1, 244 - 1,
-		222 - 1, 237 - 1, 238 - 1, 230 - 1, 245 - 1, 246 - 1, 224 - 1, 223 - 1, 238 - 1,
-		232 - 1, 231 - 1, 246 - 1, 225 - 1, 224 - 1, 239 - 1, 225 - 1, 240 - 1, 241 - 1,
-		218 - 1, 233 - 1, 234 - 1, 245 - 1, 260 - 1, 261 - 1, 239 - 1, 238 - 1, 253 - 1,
-		246 - 1, 261 - 1, 262 - 1, 240 - 1, 239 - 1, 254 - 1, 240 - 1, 255 - 1, 256 - 1,
-		233 - 1, 248 - 1, 249 - 1, 241 - 1, 256 - 1, 257 - 1, 234 - 1, 249 - 1, 250 - 1,
-		243 - 1, 242 - 1, 257 - 1, 235 - 1, 250 - 1, 251 - 1, 243 - 1, 258 - 1, 259 - 1,
-		237 - 1, 236 - 1, 251 - 1, 245 - 1, 244 - 1, 259 - 1, 237 - 1, 252 - 1, 253 - 1,
-		249 - 1, 264 - 1, 265 - 1, 258 - 1, 257 - 1, 272 - 1, 250 - 1, 265 - 1, 266 - 1,
-		258 - 1, 273 - 1, 274 - 1, 252 - 1, 251 - 1, 266 - 1, 260 - 1, 259 - 1, 274 - 1,
-		252 - 1, 267 - 1, 268 - 1, 260 - 1, 275 - 1, 276 - 1, 254 - 1, 253 - 1, 268 - 1,
-		261 - 1, 276 - 1, 277 - 1, 255 - 1, 254 - 1, 269 - 1, 255 - 1, 270 - 1, 271 - 1,
-		249 - 1, 248 - 1, 263 - 1, 256 - 1, 271 - 1, 272 - 1, 269 - 1, 268 - 1, 283 - 1,
-		277 - 1, 276 - 1, 291 - 1, 270 - 1, 269 - 1, 284 - 1, 270 - 1, 285 - 1, 286 - 1,
-		264 - 1, 263 - 1, 278 - 1, 271 - 1, 286 - 1, 287 - 1, 264 - 1, 279 - 1, 280 - 1,
-		273 - 1, 272 - 1, 287 - 1, 265 - 1, 280 - 1, 281 - 1, 273 - 1, 288 - 1, 289 - 1,
-		267 - 1, 266 - 1, 281 - 1, 275 - 1, 274 - 1, 289 - 1, 267 - 1, 282 - 1, 283 - 1,
-		275 - 1, 290 - 1, 291 - 1, 288 - 1, 287 - 1, 302 - 1, 280 - 1, 295 - 1, 296 - 1,
-		288 - 1, 303 - 1, 304 - 1, 282 - 1, 281 - 1, 296 - 1, 290 - 1, 289 - 1, 304 - 1,
-		282 - 1, 297 - 1, 298 - 1, 290 - 1, 305 - 1, 306 - 1, 284 - 1, 283 - 1, 298 - 1,
-		292 - 1, 291 - 1, 306 - 1, 285 - 1, 284 - 1, 299 - 1, 285 - 1, 300 - 1, 301 - 1,
-		278 - 1, 293 - 1, 294 - 1, 286 - 1, 301 - 1, 302 - 1, 279 - 1, 294 - 1, 295 - 1,
-		306 - 1, 322 - 1, 323 - 1, 300 - 1, 299 - 1, 315 - 1, 300 - 1, 316 - 1, 317 - 1,
-		293 - 1, 309 - 1, 310 - 1, 301 - 1, 317 - 1, 318 - 1, 294 - 1, 310 - 1, 311 - 1,
-		303 - 1, 302 - 1, 318 - 1, 295 - 1, 311 - 1, 312 - 1, 303 - 1, 319 - 1, 320 - 1,
-		297 - 1, 296 - 1, 312 - 1, 305 - 1, 304 - 1, 320 - 1, 297 - 1, 313 - 1, 314 - 1,
-		305 - 1, 321 - 1, 322 - 1, 299 - 1, 298 - 1, 314 - 1, 311 - 1, 326 - 1, 327 - 1,
-		319 - 1, 334 - 1, 335 - 1, 312 - 1, 327 - 1, 328 - 1, 321 - 1, 320 - 1, 335 - 1,
-		313 - 1, 328 - 1, 329 - 1, 321 - 1, 336 - 1, 337 - 1, 315 - 1, 314 - 1, 329 - 1,
-		322 - 1, 337 - 1, 338 - 1, 316 - 1, 315 - 1, 330 - 1, 316 - 1, 331 - 1, 332 - 1,
-		309 - 1, 324 - 1, 325 - 1, 317 - 1, 332 - 1, 333 - 1, 310 - 1, 325 - 1, 326 - 1,
-		319 - 1, 318 - 1, 333 - 1, 331 - 1, 330 - 1, 345 - 1, 331 - 1, 346 - 1, 347 - 1,
-		324 - 1, 339 - 1, 340 - 1, 332 - 1, 347 - 1, 348 - 1, 325 - 1, 340 - 1, 341 - 1,
-		334 - 1, 333 - 1, 348 - 1, 326 - 1, 341 - 1, 342 - 1, 334 - 1, 349 - 1, 350 - 1,
-		328 - 1, 327 - 1, 342 - 1, 336 - 1, 335 - 1, 350 - 1, 328 - 1, 343 - 1, 344 - 1,
-		336 - 1, 351 - 1, 352 - 1, 330 - 1, 329 - 1, 344 - 1, 337 - 1, 352 - 1, 353 - 1,
-		349 - 1, 364 - 1, 365 - 1, 343 - 1, 342 - 1, 357 - 1, 351 - 1, 350 - 1, 365 - 1,
-		343 - 1, 358 - 1, 359 - 1, 351 - 1, 366 - 1, 367 - 1, 345 - 1, 344 - 1, 359 - 1,
-		352 - 1, 367 - 1, 368 - 1, 346 - 1, 345 - 1, 360 - 1, 346 - 1, 361 - 1, 362 - 1,
-		339 - 1, 354 - 1, 355 - 1, 347 - 1, 362 - 1, 363 - 1, 341 - 1, 340 - 1, 355 - 1,
-		349 - 1, 348 - 1, 363 - 1, 341 - 1, 356 - 1, 357 - 1, 361 - 1, 376 - 1, 377 - 1,
-		354 - 1, 369 - 1, 370 - 1, 362 - 1, 377 - 1, 378 - 1, 356 - 1, 355 - 1, 370 - 1,
-		364 - 1, 363 - 1, 378 - 1, 356 - 1, 371 - 1, 372 - 1, 364 - 1, 379 - 1, 380 - 1,
-		358 - 1, 357 - 1, 372 - 1, 366 - 1, 365 - 1, 380 - 1, 358 - 1, 373 - 1, 374 - 1,
-		366 - 1, 381 - 1, 382 - 1, 360 - 1, 359 - 1, 374 - 1, 367 - 1, 382 - 1, 383 - 1,
-		361 - 1, 360 - 1, 375 - 1, 381 - 1, 380 - 1, 395 - 1, 373 - 1, 388 - 1, 389 - 1,
-		381 - 1, 396 - 1, 397 - 1, 375 - 1, 374 - 1, 389 - 1, 382 - 1, 397 - 1, 398 - 1,
-		376 - 1, 375 - 1, 390 - 1, 376 - 1, 391 - 1, 392 - 1, 369 - 1, 384 - 1, 385 - 1,
-		377 - 1, 392 - 1, 393 - 1, 371 - 1, 370 - 1, 385 - 1, 379 - 1, 378 - 1, 393 - 1,
-		371 - 1, 386 - 1, 387 - 1, 379 - 1, 394 - 1, 395 - 1, 373 - 1, 372 - 1, 387 - 1,
-		385 - 1, 384 - 1, 399 - 1, 392 - 1, 407 - 1, 408 - 1, 385 - 1, 400 - 1, 401 - 1,
-		394 - 1, 393 - 1, 408 - 1, 386 - 1, 401 - 1, 402 - 1, 394 - 1, 409 - 1, 410 - 1,
-		388 - 1, 387 - 1, 402 - 1, 396 - 1, 395 - 1, 410 - 1, 388 - 1, 403 - 1, 404 - 1,
-		397 - 1, 396 - 1, 411 - 1, 390 - 1, 389 - 1, 404 - 1, 397 - 1, 412 - 1, 413 - 1,
-		391 - 1, 390 - 1, 405 - 1, 391 - 1, 406 - 1, 407 - 1, 403 - 1, 418 - 1, 419 - 1,
-		411 - 1, 426 - 1, 427 - 1, 405 - 1, 404 - 1, 419 - 1, 412 - 1, 427 - 1, 428 - 1,
-		406 - 1, 405 - 1, 420 - 1, 406 - 1, 421 - 1, 422 - 1, 399 - 1, 414 - 1, 415 - 1,
-		407 - 1, 422 - 1, 423 - 1, 401 - 1, 400 - 1, 415 - 1, 409 - 1, 408 - 1, 423 - 1,
-		401 - 1, 416 - 1, 417 - 1, 409 - 1, 424 - 1, 425 - 1, 403 - 1, 402 - 1, 417 - 1,
-		411 - 1, 410 - 1, 425 - 1, 422 - 1, 437 - 1, 438 - 1, 416 - 1, 415 - 1, 430 - 1,
-		424 - 1, 423 - 1, 438 - 1, 416 - 1, 431 - 1, 432 - 1, 424 - 1, 439 - 1, 440 - 1,
-		418 - 1, 417 - 1, 432 - 1, 426 - 1, 425 - 1, 440 - 1, 418 - 1, 433 - 1, 434 - 1,
-		426 - 1, 441 - 1, 442 - 1, 420 - 1, 419 - 1, 434 - 1, 427 - 1, 442 - 1, 443 - 1,
-		421 - 1, 420 - 1, 435 - 1, 421 - 1, 436 - 1, 437 - 1, 414 - 1, 429 - 1, 430 - 1,
-		441 - 1, 456 - 1, 457 - 1, 435 - 1, 434 - 1, 449 - 1, 442 - 1, 457 - 1, 458 - 1,
-		436 - 1, 435 - 1, 450 - 1, 436 - 1, 451 - 1, 452 - 1, 430 - 1, 429 - 1, 444 - 1,
-		437 - 1, 452 - 1, 453 - 1, 430 - 1, 445 - 1, 446 - 1, 439 - 1, 438 - 1, 453 - 1,
-		431 - 1, 446 - 1, 447 - 1, 439 - 1, 454 - 1, 455 - 1, 433 - 1, 432 - 1, 447 - 1,
-		441 - 1, 440 - 1, 455 - 1, 433 - 1, 448 - 1, 449 - 1, 446 - 1, 445 - 1, 460 - 1,
-		454 - 1, 453 - 1, 468 - 1, 446 - 1, 461 - 1, 462 - 1, 454 - 1, 469 - 1, 470 - 1,
-		448 - 1, 447 - 1, 462 - 1, 456 - 1, 455 - 1, 470 - 1, 448 - 1, 463 - 1, 464 - 1,
-		456 - 1, 471 - 1, 472 - 1, 450 - 1, 449 - 1, 464 - 1, 458 - 1, 457 - 1, 472 - 1,
-		451 - 1, 450 - 1, 465 - 1, 451 - 1, 466 - 1, 467 - 1, 444 - 1, 459 - 1, 460 - 1,
-		452 - 1, 467 - 1, 468 - 1, 465 - 1, 464 - 1, 477 - 1, 472 - 1, 481 - 1, 482 - 1,
-		466 - 1, 465 - 1, 3 - 1,   466 - 1, 4 - 1,   5 - 1,   460 - 1, 459 - 1, 474 - 1,
-		467 - 1, 5 - 1,   478 - 1, 461 - 1, 460 - 1, 475 - 1, 468 - 1, 478 - 1, 6 - 1,
-		462 - 1, 461 - 1, 1 - 1,   469 - 1, 6 - 1,   479 - 1, 463 - 1, 462 - 1, 476 - 1,
-		471 - 1, 470 - 1, 479 - 1, 464 - 1, 463 - 1, 2 - 1,   471 - 1, 480 - 1, 481 - 1,
-	};
-}
\ No newline at end of file
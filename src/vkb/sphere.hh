@@ -1,10 +0,0 @@
-#pragma once
-
-#include "math/vec4.hh"
-#include <stdint.h>
-
-namespace vkb
-{
-	extern vec4     sphere_vertices[482];
-	extern uint16_t sphere_indices[2880];
-}
\ No newline at end of file
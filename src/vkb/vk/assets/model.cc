@@ -1,36 +1,68 @@
 #include "model.hh"
 
+#include <stddef.h>
+
 namespace vkb::vk
 {
+	namespace
+	{
+		struct attribute
+		{
+			uint32_t offset;
+			VkFormat format;
+		};
+
+		// Attributes of model::packed_vert, by location
+		constexpr attribute packed_attributes[] {
+			{offsetof(model::packed_vert, pos),    VK_FORMAT_R16G16B16A16_SNORM},
+			{offsetof(model::packed_vert, col),    VK_FORMAT_R8G8B8A8_UNORM    },
+			{offsetof(model::packed_vert, uv),     VK_FORMAT_R16G16_SFLOAT     },
+			{offsetof(model::packed_vert, normal), VK_FORMAT_R16G16_SNORM      },
+		};
+
+		static_assert(sizeof(packed_attributes) / sizeof(attribute) ==
+		                  model::attribute_count,
+		              "Every attribute of packed_vert has a format");
+	}
+
+	model::packed_vert model::pack(vert const& v, mesh::quant_bounds const& bounds)
+	{
+		packed_vert res {};
+		mesh::quantize_position(&v.pos.x, bounds, res.pos);
+		res.col[0] = mesh::quantize_unorm8(v.col.x);
+		res.col[1] = mesh::quantize_unorm8(v.col.y);
+		res.col[2] = mesh::quantize_unorm8(v.col.z);
+		res.col[3] = mesh::quantize_unorm8(v.col.w);
+		res.uv[0] = mesh::quantize_half(v.uv.x);
+		res.uv[1] = mesh::quantize_half(v.uv.y);
+		mesh::encode_octahedral(&v.normal.x, res.normal);
+
+		return res;
+	}
+
 	VkVertexInputBindingDescription model::binding_desc()
 	{
 		VkVertexInputBindingDescription res {};
 		res.binding = 0;
-		res.stride = sizeof(vert);
+		res.stride = sizeof(packed_vert);
 		res.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
 
 		return res;
 	}
 
-	mc::array<VkVertexInputAttributeDescription, 3> model::attribute_descs()
+	mc::array<VkVertexInputAttributeDescription, model::attribute_count>
+	model::attribute_descs()
 	{
-		mc::array<VkVertexInputAttributeDescription, 3> res {};
-
-		res[0].binding = 0;
-		res[0].location = 0;
-		res[0].format = VK_FORMAT_R32G32B32A32_SFLOAT;
-		res[0].offset = offsetof(vert, pos);
-
-		res[1].binding = 0;
-		res[1].location = 1;
-		res[1].format = VK_FORMAT_R32G32B32A32_SFLOAT;
-		res[1].offset = offsetof(vert, col);
+		mc::array<VkVertexInputAttributeDescription, attribute_count> res {};
 
-		res[2].binding = 0;
-		res[2].location = 2;
-		res[2].format = VK_FORMAT_R32G32_SFLOAT;
-		res[2].offset = offsetof(vert, uv);
+		for (uint32_t i {0}; i < attribute_count; ++i)
+		{
+			res[i].binding = 0;
+			res[i].location = i;
+			res[i].format = packed_attributes[i].format;
+			res[i].offset = packed_attributes[i].offset;
+		}
 
 		return res;
 	}
-}
\ No newline at end of file
+}
@@ -2,30 +2,68 @@
 
 #include "../../math/vec2.hh"
 #include "../../math/vec4.hh"
+#include "../../mesh/meshlet.hh"
+#include "../../mesh/quantize.hh"
 
 #include "../vma/vma.hh"
 #include <volk/volk.h>
 
-#include "../buffer.hh"
 #include <array.hh>
 
+#include <stdint.h>
+
 namespace vkb::vk
 {
+	class geometry_arena;
+
 	struct model
 	{
+		// Imported vertex, see context::init_model. Normals are optional, zero when
+		// missing.
 		struct vert
 		{
 			vec4 pos;
 			vec4 col;
 			vec2 uv;
+			vec4 normal {0.f, 0.f, 0.f, 0.f};
 		};
 
-		static VkVertexInputBindingDescription                 binding_desc();
-		static mc::array<VkVertexInputAttributeDescription, 3> attribute_descs();
+		// Uploaded vertex, 20 bytes instead of 56. The vertex input converts each
+		// attribute to floats, positions then need `bounds_` to be dequantized, as
+		// center + pos * extent.
+		struct packed_vert
+		{
+			// snorm16 within the mesh bounds, w is 1
+			int16_t  pos[4];
+			// unorm8
+			uint8_t  col[4];
+			// float16
+			uint16_t uv[2];
+			// Octahedral snorm16
+			int16_t  normal[2];
+		};
+
+		static_assert(sizeof(packed_vert) == 20, "Layout read by gpu_driven_mesh.slang");
+
+		// Locations follow the attributes of vert
+		constexpr static uint32_t attribute_count {4};
+
+		static packed_vert pack(vert const& v, mesh::quant_bounds const& bounds);
 
-		buffer vertex_;
-		buffer index_;
+		// Descriptions of packed_vert, generated from the formats of its attributes
+		static VkVertexInputBindingDescription binding_desc();
+		static mc::array<VkVertexInputAttributeDescription, attribute_count>
+			attribute_descs();
 
-		uint32_t idcs_size_ {0};
+		// Mesh range in the geometry arena of the context, see context::init_model
+		geometry_arena* arena_ {nullptr};
+		uint32_t        mesh_ {UINT32_MAX};
+		// Distance to the source mesh in model units when this is a simplified LOD, see
+		// context::init_model_lods
+		float error_ {0.f};
+		// Clusters of the uploaded indices, for cluster culling (see gpu_driven)
+		mesh::meshlet_set meshlets_;
+		// Dequantization of the uploaded positions
+		mesh::quant_bounds bounds_;
 	};
 }
\ No newline at end of file
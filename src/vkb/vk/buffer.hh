@@ -7,7 +7,22 @@ namespace vkb::vk
 {
 	struct buffer
 	{
-		VkBuffer      buffer {nullptr};
-		VmaAllocation memory {nullptr};
+		VkBuffer           buffer {nullptr};
+		VmaAllocation      memory {nullptr};
+		VkDeviceSize       size {0};
+		VkBufferUsageFlags usage {0};
+		// Persistent mapping, only set when the buffer memory is host visible
+		void* mapped {nullptr};
 	};
-}
\ No newline at end of file
+
+	// Buffer rewritten by the host (per-frame uniforms, dynamic data...). When device
+	// local memory is host visible (ReBAR, UMA), `device` is written directly and no
+	// staging buffer exists. Otherwise, data goes through `staging`.
+	struct dynamic_buffer
+	{
+		buffer device;
+		buffer staging;
+		// Frame index of the last update, 0 before the first one
+		uint32_t frame {0};
+	};
+}
@@ -1,9 +1,15 @@
 #include "context.hh"
 #include "instance.hh"
+#include "staging_ring.hh"
+#include "timeline.hh"
 
 #include "../cam/free.hh"
 #include "../log.hh"
 #include "../math/trig.hh"
+#include "../mesh/meshlet.hh"
+#include "../mesh/optimize.hh"
+#include "../mesh/quantize.hh"
+#include "../mesh/simplify.hh"
 #include "../win/window.hh"
 
 #include <imgui/backends/imgui_impl_vulkan.h>
@@ -26,11 +32,79 @@
 namespace vkb::vk
 {
 	namespace
-	{}
+	{
+		// Reorders the mesh for the post transform cache, then for overdraw, then
+		// renumbers the vertices it uses in fetch order, and splits the result in
+		// meshlets. `remap` gives the new index of each source vertex.
+		void optimize_mesh(mc::array_view<model::vert> verts,
+		                   mc::array_view<uint16_t>    idcs,
+		                   mc::vector<model::vert>&    out_verts,
+		                   mc::vector<uint16_t>&       out_idcs,
+		                   mesh::meshlet_set&          meshlets,
+		                   mc::vector<uint32_t>&       remap)
+		{
+			float const* positions = &verts[0].pos.x;
+
+			mc::vector<uint16_t> cache_idcs;
+			mc::vector<uint16_t> overdraw_idcs;
+			mesh::optimize_vertex_cache(idcs, verts.size(), cache_idcs);
+			mesh::optimize_overdraw(positions, sizeof(model::vert), verts.size(),
+			                        cache_idcs, overdraw_idcs);
+			uint32_t kept = mesh::optimize_vertex_fetch(overdraw_idcs, verts.size(),
+			                                            out_idcs, remap);
+
+			out_verts.resize(kept);
+			for (uint32_t v {0}; v < verts.size(); ++v)
+			{
+				if (remap[v] != UINT32_MAX)
+					out_verts[remap[v]] = verts[v];
+			}
+
+			mesh::build_meshlets(&out_verts[0].pos.x, sizeof(model::vert), kept, out_idcs,
+			                     meshlets);
+
+			uint32_t const    vert_count = verts.size();
+			mesh::cache_stats in = mesh::analyze_vertex_cache(idcs, vert_count);
+			mesh::cache_stats cache = mesh::analyze_vertex_cache(cache_idcs, vert_count);
+			mesh::cache_stats out = mesh::analyze_vertex_cache(out_idcs, kept);
+			log::debug("Optimized mesh of %u triangles: ACMR %.3f, %.3f after vertex "
+			           "cache, %.3f after overdraw; ATVR %.3f, %.3f, %.3f",
+			           idcs.size() / 3, in.acmr, cache.acmr, out.acmr, in.atvr,
+			           cache.atvr, out.atvr);
+		}
+
+		// Same without touching the vertices, for meshes drawing the ones of another
+		void optimize_indices(mc::array_view<model::vert> verts,
+		                      mc::array_view<uint16_t>    idcs,
+		                      mc::vector<uint16_t>&       out_idcs,
+		                      mesh::meshlet_set&          meshlets)
+		{
+			float const* positions = &verts[0].pos.x;
+
+			mc::vector<uint16_t> cache_idcs;
+			mesh::optimize_vertex_cache(idcs, verts.size(), cache_idcs);
+			mesh::optimize_overdraw(positions, sizeof(model::vert), verts.size(),
+			                        cache_idcs, out_idcs);
+			mesh::build_meshlets(positions, sizeof(model::vert), verts.size(), out_idcs,
+			                     meshlets);
+		}
+
+		// Quantizes vertices for the upload, see model::packed_vert
+		void pack_verts(mc::array_view<model::vert>     verts,
+		                mesh::quant_bounds const&       bounds,
+		                mc::vector<model::packed_vert>& out)
+		{
+			out.resize(verts.size());
+			for (uint32_t v {0}; v < verts.size(); ++v)
+				out[v] = model::pack(verts[v], bounds);
+		}
+	}
 
 	context::context(window const& win, surface& surface)
 	: win_ {win}
 	, surface_ {surface}
+	, geometry_ {sizeof(model::packed_vert), geometry_vertex_capacity,
+	             geometry_index_capacity}
 	{
 		// auto [w, h] = win_.size();
 		auto [w, h] = surface_.get_extent();
@@ -87,112 +161,148 @@ namespace vkb::vk
 	{
 		instance& inst = instance::get();
 
-		uint64_t vert_size {sizeof(model::vert) * verts.size()};
-		uint64_t idcs_size {sizeof(uint16_t) * idcs.size()};
-
-		buffer staging_vert = inst.create_buffer(
-			vert_size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-		buffer staging_idcs = inst.create_buffer(
-			idcs_size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-
-		void* buff_mem;
-		vmaMapMemory(inst.get_allocator(), staging_vert.memory, &buff_mem);
-		memcpy(buff_mem, verts.data(), vert_size);
-		vmaUnmapMemory(inst.get_allocator(), staging_vert.memory);
-		vmaMapMemory(inst.get_allocator(), staging_idcs.memory, &buff_mem);
-		memcpy(buff_mem, idcs.data(), idcs_size);
-		vmaUnmapMemory(inst.get_allocator(), staging_idcs.memory);
-
-		model.vertex_ = inst.create_buffer(vert_size,
-		                                   VK_BUFFER_USAGE_TRANSFER_DST_BIT |
-		                                       VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
-		                                   VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-		model.index_ = inst.create_buffer(idcs_size,
-		                                  VK_BUFFER_USAGE_TRANSFER_DST_BIT |
-		                                      VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
-		                                  VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-
-		VkCommandBuffer cmd = inst.begin_commands();
-		inst.copy_buffer(cmd, staging_vert, model.vertex_, vert_size);
-		inst.copy_buffer(cmd, staging_idcs, model.index_, idcs_size);
-		inst.end_commands(cmd);
-
-		inst.destroy_buffer(staging_vert);
-		inst.destroy_buffer(staging_idcs);
-
-		model.idcs_size_ = idcs.size();
+		mc::vector<model::vert> opt_verts;
+		mc::vector<uint16_t>    opt_idcs;
+		mc::vector<uint32_t>    remap;
+		optimize_mesh(verts, idcs, opt_verts, opt_idcs, model.meshlets_, remap);
+
+		mc::vector<model::packed_vert> packed;
+		model.bounds_ = mesh::position_bounds(&verts[0].pos.x, sizeof(model::vert),
+		                                      verts.size());
+		pack_verts(opt_verts, model.bounds_, packed);
+
+		model.arena_ = &geometry_;
+		model.mesh_ = geometry_.add_mesh(packed.data(), packed.size(), opt_idcs);
+
+		inst.get_staging().flush();
 	}
 
-	void context::destroy_model(model& model)
+	uint32_t context::init_model_lods(model* lods, uint32_t max_lods,
+	                                  mc::array_view<model::vert> verts,
+	                                  mc::array_view<uint16_t>    idcs)
 	{
 		instance& inst = instance::get();
 
-		inst.destroy_buffer(model.index_);
-		inst.destroy_buffer(model.vertex_);
+		mc::vector<mesh::lod> chain = mesh::build_lods(
+			&verts[0].pos.x, sizeof(model::vert), verts.size(), idcs, max_lods);
+
+		// Levels share the bounds of the source, so that objects dequantize any of them
+		mesh::quant_bounds const bounds = mesh::position_bounds(
+			&verts[0].pos.x, sizeof(model::vert), verts.size());
+
+		// Simplified levels collapse onto source vertices, so the vertices of the first
+		// level are uploaded once and the others only add their indices
+		mc::vector<model::vert>        opt_verts;
+		mc::vector<uint32_t>           remap;
+		mc::vector<uint16_t>           lod_idcs;
+		mc::vector<model::packed_vert> packed;
+		optimize_mesh(verts, chain[0].idcs, opt_verts, lod_idcs, lods[0].meshlets_,
+		              remap);
+		pack_verts(opt_verts, bounds, packed);
+		lods[0].mesh_ = geometry_.add_mesh(packed.data(), packed.size(), lod_idcs);
+
+		mc::vector<uint16_t> remapped;
+		for (uint32_t lvl {1}; lvl < chain.size(); ++lvl)
+		{
+			remapped.clear();
+			for (uint16_t idx : chain[lvl].idcs)
+				remapped.emplace_back(static_cast<uint16_t>(remap[idx]));
+
+			optimize_indices(opt_verts, remapped, lod_idcs, lods[lvl].meshlets_);
+			lods[lvl].mesh_ = geometry_.add_shared_mesh(lods[0].mesh_, lod_idcs);
+		}
+
+		for (uint32_t lvl {0}; lvl < chain.size(); ++lvl)
+		{
+			lods[lvl].arena_ = &geometry_;
+			lods[lvl].error_ = chain[lvl].error;
+			lods[lvl].bounds_ = bounds;
+		}
+
+		inst.get_staging().flush();
+
+		return chain.size();
 	}
 
-	void context::init_texture(texture& tex, mc::string_view path)
+	void context::destroy_model(model& model)
 	{
-		instance& inst = instance::get();
+		geometry_.remove_mesh(model.mesh_);
+		model.arena_ = nullptr;
+		model.mesh_ = UINT32_MAX;
+		model.meshlets_ = {};
+		model.bounds_ = {};
+	}
+
+	geometry_arena& context::get_geometry()
+	{
+		return geometry_;
+	}
 
+	void context::init_texture(texture& tex, mc::string_view path)
+	{
 		int32_t  w, h, c;
 		uint8_t* pix = stbi_load(path.data(), &w, &h, &c, STBI_rgb_alpha);
 		if (!pix)
 			return;
 
-		tex.mip_lvl = floor(log2(w > h ? w : h));
-		uint64_t size = w * h * 4;
+		create_texture(tex, pix, w, h);
+		stbi_image_free(pix);
+		instance::get().get_staging().flush();
+	}
 
-		buffer staging = inst.create_buffer(size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-		                                    VK_MEMORY_PROPERTY_HOST_COHERENT_BIT |
-		                                        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT);
+	async::task<bool> context::load_texture(texture& tex, mc::string path)
+	{
+		mc::vector<uint8_t> file = co_await async::read_file(path);
+		if (file.empty())
+			co_return false;
 
-		void* data;
-		vmaMapMemory(inst.get_allocator(), staging.memory, &data);
-		memcpy(data, pix, size);
-		vmaUnmapMemory(inst.get_allocator(), staging.memory);
+		// Decoding is the expensive part, kept off the main thread. Inline when still on
+		// the worker which read the file.
+		co_await async::resume_on_worker();
+		int32_t  w, h, c;
+		uint8_t* pix = stbi_load_from_memory(file.data(), file.size(), &w, &h, &c,
+		                                     STBI_rgb_alpha);
+		if (!pix)
+		{
+			log::error("Failed to decode %s", path.data());
+			co_return false;
+		}
 
+		// Vulkan objects and the staging ring belong to the render thread
+		co_await async::resume_on_render();
+		create_texture(tex, pix, w, h);
 		stbi_image_free(pix);
 
+		co_await timeline_wait {instance::get().get_staging().submit_async()};
+		co_return true;
+	}
+
+	void context::create_texture(texture& tex, uint8_t const* pix, int32_t w, int32_t h)
+	{
+		instance& inst = instance::get();
+
+		tex.mip_lvl = floor(log2(w > h ? w : h));
+		uint64_t size = w * h * 4;
+
 		tex.img = inst.create_image(
 			w, h, tex.mip_lvl, VK_FORMAT_R8G8B8A8_SRGB, VK_IMAGE_TILING_OPTIMAL,
 			VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT |
 				VK_IMAGE_USAGE_SAMPLED_BIT,
 			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
 
-		VkCommandBuffer cmd = inst.begin_commands();
+		staging_ring& staging = inst.get_staging();
 
 		inst.transition_image_layout(
-			cmd, tex.img.image, VK_IMAGE_LAYOUT_UNDEFINED,
+			staging.commands(), tex.img.image, VK_IMAGE_LAYOUT_UNDEFINED,
 			VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 0, VK_ACCESS_TRANSFER_WRITE_BIT,
 			VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
 			VK_IMAGE_ASPECT_COLOR_BIT, tex.mip_lvl);
 
-		VkBufferImageCopy2 copy {};
-		copy.sType = VK_STRUCTURE_TYPE_BUFFER_IMAGE_COPY_2;
-		copy.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-		copy.imageSubresource.layerCount = 1;
-		copy.imageExtent.width = w;
-		copy.imageExtent.height = h;
-		copy.imageExtent.depth = 1;
-
-		VkCopyBufferToImageInfo2 info {};
-		info.sType = VK_STRUCTURE_TYPE_COPY_BUFFER_TO_IMAGE_INFO_2;
-		info.srcBuffer = staging.buffer;
-		info.dstImage = tex.img.image;
-		info.regionCount = 1;
-		info.pRegions = &copy;
-		info.dstImageLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-
-		vkCmdCopyBufferToImage2(cmd, &info);
-		// inst.end_commands(cmd);
-		// cmd = inst.begin_commands();
-		generate_mips(cmd, tex.img, VK_FORMAT_R8G8B8A8_SRGB, w, h, tex.mip_lvl);
-		inst.end_commands(cmd);
-
-		inst.destroy_buffer(staging);
+		// Image bigger than the staging ring are streamed in chunks
+		staging.upload_image(tex.img, w, h, 4, pix);
+
+		generate_mips(staging.commands(), tex.img, VK_FORMAT_R8G8B8A8_SRGB, w, h,
+		              tex.mip_lvl);
 
 		tex.img_view = inst.create_image_view(tex.img.image, VK_FORMAT_R8G8B8A8_SRGB,
 		                                      VK_IMAGE_ASPECT_COLOR_BIT, tex.mip_lvl);
@@ -225,14 +335,12 @@ namespace vkb::vk
 
 	void context::destroy_texture(texture& tex)
 	{
-		instance& inst = instance::get();
+		deletion_queue& deletion = instance::get().get_deletion_queue();
 
-		if (tex.sampler)
-			vkDestroySampler(inst.get_device(), tex.sampler, nullptr);
-		if (tex.img_view)
-			vkDestroyImageView(inst.get_device(), tex.img_view, nullptr);
-		if (tex.img.image && tex.img.memory)
-			vmaDestroyImage(inst.get_allocator(), tex.img.image, tex.img.memory);
+		deletion.push(tex.sampler);
+		deletion.push(tex.img_view);
+		deletion.push(tex.img);
+		tex = {};
 	}
 
 	bool context::prepare_draw()
@@ -268,6 +376,9 @@ namespace vkb::vk
 		                UINT64_MAX);
 		vkResetFences(inst.get_device(), 1, &in_flight_fences_[img_idx_]);
 
+		inst.next_frame();
+		inst.get_deletion_queue().collect(inst.get_completed_timeline_value());
+
 		vkResetCommandBuffer(command_buffers_[img_idx_], 0);
 
 		VkSemaphore old_semaphore = img_avail_semaphores_[img_idx_];
@@ -369,12 +480,21 @@ namespace vkb::vk
 		submit_info.commandBufferCount = 1;
 		submit_info.pCommandBuffers = &command_buffers_[img_idx_];
 
-		VkSemaphore sem_signal[] {draw_end_semaphores_[img_idx_]};
-		submit_info.signalSemaphoreCount = 1;
+		uint64_t    timeline_value = inst.next_frame_timeline_value();
+		VkSemaphore sem_signal[] {draw_end_semaphores_[img_idx_], inst.get_timeline()};
+		uint64_t    signal_values[] {0, timeline_value};
+		submit_info.signalSemaphoreCount = 2;
 		submit_info.pSignalSemaphores = sem_signal;
 
+		VkTimelineSemaphoreSubmitInfo timeline_info {};
+		timeline_info.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+		timeline_info.signalSemaphoreValueCount = 2;
+		timeline_info.pSignalSemaphoreValues = signal_values;
+		submit_info.pNext = &timeline_info;
+
 		vkQueueSubmit(inst.get_graphics_queue(), 1, &submit_info,
 		              in_flight_fences_[img_idx_]);
+		inst.get_deletion_queue().stamp(timeline_value);
 
 		VkPresentInfoKHR present_info {};
 		present_info.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
@@ -395,6 +515,8 @@ namespace vkb::vk
 		if (need_swapchain_update)
 			recreate_swapchain();
 
+		inst.defragment(defrag_budget_ms);
+
 		cur_frame_ = (cur_frame_ + 1) % context::max_frames_in_flight;
 
 		return need_swapchain_update;
@@ -566,10 +688,7 @@ namespace vkb::vk
 
 	void context::recreate_swapchain()
 	{
-		vkDeviceWaitIdle(instance::get().get_device());
-
-		surface_.destroy_swapchain();
-		surface_.create_swapchain();
+		surface_.recreate_swapchain();
 
 		auto [w, h] = surface_.get_extent();
 		proj_ = mat4::persp_proj(near_, far_, w / (float)h, rad(fov_deg_));
@@ -1,12 +1,16 @@
 #pragma once
 
+#include "../core/async.hh"
 #include "../math/mat4.hh"
-#include "object.hh"
+#include "assets/model.hh"
+#include "assets/texture.hh"
 
+#include "geometry_arena.hh"
 #include "material.hh"
 #include "surface.hh"
 
 #include <array_view.hh>
+#include <string.hh>
 #include <string_view.hh>
 #include <vector.hh>
 
@@ -46,12 +50,26 @@ namespace vkb::vk
 
 		void set_proj(float near, float far, float fov_deg);
 
-		void init_model(model& model, mc::array_view<model::vert> verts,
-		                mc::array_view<uint16_t> idcs);
-		void destroy_model(model& model);
-
-		void init_texture(texture& tex, mc::string_view path);
-		void destroy_texture(texture& tex);
+		// Meshes are reordered for the vertex cache, overdraw and vertex fetch, then
+		// quantized in their bounds before being uploaded, see mesh/optimize.hh and
+		// model::packed_vert
+		void     init_model(model& model, mc::array_view<model::vert> verts,
+		                    mc::array_view<uint16_t> idcs);
+		// Simplifies the mesh into up to `max_lods` models, from the source one to the
+		// coarsest, each with its error. Returns the number of LODs created. Every LOD
+		// draws the vertices of the first one, which is destroyed last.
+		uint32_t init_model_lods(model* lods, uint32_t max_lods,
+		                         mc::array_view<model::vert> verts,
+		                         mc::array_view<uint16_t>    idcs);
+		void     destroy_model(model& model);
+
+		geometry_arena& get_geometry();
+
+		void              init_texture(texture& tex, mc::string_view path);
+		// Reads and decodes the image on workers, then uploads it and completes on the
+		// render thread
+		async::task<bool> load_texture(texture& tex, mc::string path);
+		void              destroy_texture(texture& tex);
 
 		bool prepare_draw();
 		void begin_draw();
@@ -67,10 +85,16 @@ namespace vkb::vk
 		mat4 get_proj();
 
 	private:
-		constexpr static uint8_t max_frames_in_flight {3};
-		uint8_t                  cur_frame_ {0};
-		uint32_t                 img_idx_ {0};
-
+		constexpr static uint8_t  max_frames_in_flight {3};
+		constexpr static uint32_t geometry_vertex_capacity {64 * 1024};
+		constexpr static uint32_t geometry_index_capacity {256 * 1024};
+		// Time given to defragmentation after each present
+		constexpr static double defrag_budget_ms {0.5};
+		uint8_t                   cur_frame_ {0};
+		uint32_t                  img_idx_ {0};
+
+		// Records the upload of RGBA8 pixels, without waiting for it
+		void create_texture(texture& tex, uint8_t const* pix, int32_t w, int32_t h);
 		void generate_mips(VkCommandBuffer cmd, image const& img, VkFormat format,
 		                   uint32_t w, uint32_t h, uint32_t mip_lvl);
 
@@ -85,6 +109,10 @@ namespace vkb::vk
 
 		VkFormat surface_format_;
 
+		// Every model shares the same vertex format, model::packed_vert, and then the
+		// same buffers
+		geometry_arena geometry_;
+
 		VkCommandBuffer command_buffers_[context::max_frames_in_flight] {nullptr};
 
 		mc::vector<VkSemaphore> recycled_semaphores_;
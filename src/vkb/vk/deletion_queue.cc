@@ -0,0 +1,177 @@
+#include "deletion_queue.hh"
+
+#include "../log.hh"
+#include "instance.hh"
+
+namespace vkb::vk
+{
+	void deletion_queue::push(buffer const& buf)
+	{
+		push(VK_OBJECT_TYPE_BUFFER, reinterpret_cast<uint64_t>(buf.buffer), buf.memory);
+	}
+
+	void deletion_queue::push(dynamic_buffer const& buf)
+	{
+		push(buf.staging);
+		push(buf.device);
+	}
+
+	void deletion_queue::push(image const& img)
+	{
+		push(VK_OBJECT_TYPE_IMAGE, reinterpret_cast<uint64_t>(img.image), img.memory);
+	}
+
+	void deletion_queue::push(VkImageView view)
+	{
+		push(VK_OBJECT_TYPE_IMAGE_VIEW, reinterpret_cast<uint64_t>(view), nullptr);
+	}
+
+	void deletion_queue::push(VkSampler sampler)
+	{
+		push(VK_OBJECT_TYPE_SAMPLER, reinterpret_cast<uint64_t>(sampler), nullptr);
+	}
+
+	void deletion_queue::push(VkPipeline pipe)
+	{
+		push(VK_OBJECT_TYPE_PIPELINE, reinterpret_cast<uint64_t>(pipe), nullptr);
+	}
+
+	void deletion_queue::push(VkPipelineLayout layout)
+	{
+		push(VK_OBJECT_TYPE_PIPELINE_LAYOUT, reinterpret_cast<uint64_t>(layout), nullptr);
+	}
+
+	void deletion_queue::push(VkDescriptorSetLayout layout)
+	{
+		push(VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT, reinterpret_cast<uint64_t>(layout),
+		     nullptr);
+	}
+
+	void deletion_queue::push(VkDescriptorPool pool)
+	{
+		push(VK_OBJECT_TYPE_DESCRIPTOR_POOL, reinterpret_cast<uint64_t>(pool), nullptr);
+	}
+
+	void deletion_queue::push(VkSwapchainKHR swapchain)
+	{
+		push(VK_OBJECT_TYPE_SWAPCHAIN_KHR, reinterpret_cast<uint64_t>(swapchain),
+		     nullptr);
+	}
+
+	void deletion_queue::push(VmaVirtualBlock block, VmaVirtualAllocation alloc)
+	{
+		push(VK_OBJECT_TYPE_UNKNOWN, reinterpret_cast<uint64_t>(alloc), nullptr, block);
+	}
+
+	void deletion_queue::push(VmaVirtualBlock block)
+	{
+		push(VK_OBJECT_TYPE_UNKNOWN, reinterpret_cast<uint64_t>(block), nullptr);
+	}
+
+	void deletion_queue::stamp(uint64_t value)
+	{
+		// Unstamped objects are always at the end
+		for (uint32_t i = entries_.size(); i > 0 && !entries_[i - 1].value; --i)
+			entries_[i - 1].value = value;
+	}
+
+	void deletion_queue::collect(uint64_t completed)
+	{
+		// Entries are pushed, then stamped, in timeline order
+		uint32_t cnt {0};
+		while (cnt < entries_.size() && entries_[cnt].value &&
+		       entries_[cnt].value <= completed)
+			destroy(entries_[cnt++]);
+
+		if (!cnt)
+			return;
+
+		for (uint32_t i {cnt}; i < entries_.size(); ++i)
+			entries_[i - cnt] = entries_[i];
+		entries_.resize(entries_.size() - cnt);
+	}
+
+	void deletion_queue::flush()
+	{
+		for (uint32_t i {0}; i < entries_.size(); ++i)
+			destroy(entries_[i]);
+		entries_.clear();
+	}
+
+	void deletion_queue::push(VkObjectType type, uint64_t handle, VmaAllocation memory,
+	                          VmaVirtualBlock block)
+	{
+		// Entries are stamped by the submission of the thread recording GPU work
+		instance::get().assert_owner_thread();
+
+		if (!handle)
+			return;
+
+		entry e {};
+		e.type = type;
+		e.handle = handle;
+		e.memory = memory;
+		e.block = block;
+		entries_.emplace_back(e);
+	}
+
+	void deletion_queue::destroy(entry const& e)
+	{
+		instance& inst = instance::get();
+		VkDevice  device = inst.get_device();
+
+		switch (e.type)
+		{
+			case VK_OBJECT_TYPE_BUFFER:
+				vmaDestroyBuffer(inst.get_allocator(),
+				                 reinterpret_cast<VkBuffer>(e.handle), e.memory);
+				break;
+			case VK_OBJECT_TYPE_IMAGE:
+				vmaDestroyImage(inst.get_allocator(), reinterpret_cast<VkImage>(e.handle),
+				                e.memory);
+				break;
+			case VK_OBJECT_TYPE_IMAGE_VIEW:
+				vkDestroyImageView(device, reinterpret_cast<VkImageView>(e.handle),
+				                   nullptr);
+				break;
+			case VK_OBJECT_TYPE_SAMPLER:
+				vkDestroySampler(device, reinterpret_cast<VkSampler>(e.handle), nullptr);
+				break;
+			case VK_OBJECT_TYPE_PIPELINE:
+				vkDestroyPipeline(device, reinterpret_cast<VkPipeline>(e.handle),
+				                  nullptr);
+				break;
+			case VK_OBJECT_TYPE_PIPELINE_LAYOUT:
+				vkDestroyPipelineLayout(
+					device, reinterpret_cast<VkPipelineLayout>(e.handle), nullptr);
+				break;
+			case VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT:
+				vkDestroyDescriptorSetLayout(
+					device, reinterpret_cast<VkDescriptorSetLayout>(e.handle), nullptr);
+				break;
+			case VK_OBJECT_TYPE_DESCRIPTOR_POOL:
+				vkDestroyDescriptorPool(
+					device, reinterpret_cast<VkDescriptorPool>(e.handle), nullptr);
+				break;
+			case VK_OBJECT_TYPE_SWAPCHAIN_KHR:
+				vkDestroySwapchainKHR(device, reinterpret_cast<VkSwapchainKHR>(e.handle),
+				                      nullptr);
+				break;
+			case VK_OBJECT_TYPE_UNKNOWN:
+				if (e.block)
+				{
+					vmaVirtualFree(e.block,
+					               reinterpret_cast<VmaVirtualAllocation>(e.handle));
+				}
+				else
+				{
+					VmaVirtualBlock block = reinterpret_cast<VmaVirtualBlock>(e.handle);
+					vmaClearVirtualBlock(block);
+					vmaDestroyVirtualBlock(block);
+				}
+				break;
+
+			default: log::error("Unsupported deferred object type %u", e.type); break;
+		}
+	}
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "buffer.hh"
+#include "image.hh"
+
+#include <vector.hh>
+
+#include "vma/vma.hh"
+#include <volk/volk.h>
+
+#include <stdint.h>
+
+namespace vkb::vk
+{
+	// Objects which may still be used by the GPU, destroyed once the frame timeline
+	// passed their last use. Pushed objects are stamped with the value of the next
+	// submitted frame, as it is the last one which may record them.
+	class deletion_queue
+	{
+	public:
+		void push(buffer const& buf);
+		void push(dynamic_buffer const& buf);
+		void push(image const& img);
+		void push(VkImageView view);
+		void push(VkSampler sampler);
+		void push(VkPipeline pipe);
+		void push(VkPipelineLayout layout);
+		void push(VkDescriptorSetLayout layout);
+		void push(VkDescriptorPool pool);
+		void push(VkSwapchainKHR swapchain);
+		// Ranges of a virtual block, which the GPU may still access
+		void push(VmaVirtualBlock block, VmaVirtualAllocation alloc);
+		// Virtual block, cleared of its remaining allocations
+		void push(VmaVirtualBlock block);
+
+		// Assigns the timeline value of a submitted frame to the unstamped objects
+		void stamp(uint64_t value);
+		// Destroys objects whose frame is completed
+		void collect(uint64_t completed);
+		// Destroys every object, the device must be idle
+		void flush();
+
+	private:
+		struct entry
+		{
+			// 0 until the frame which may use the object is submitted
+			uint64_t        value {0};
+			VkObjectType    type {VK_OBJECT_TYPE_UNKNOWN};
+			uint64_t        handle {0};
+			VmaAllocation   memory {nullptr};
+			// Virtual allocations are VK_OBJECT_TYPE_UNKNOWN, freed from this block
+			VmaVirtualBlock block {nullptr};
+		};
+
+		void push(VkObjectType type, uint64_t handle, VmaAllocation memory,
+		          VmaVirtualBlock block = nullptr);
+		void destroy(entry const& e);
+
+		mc::vector<entry> entries_;
+	};
+}
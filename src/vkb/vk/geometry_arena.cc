@@ -0,0 +1,349 @@
+#include "geometry_arena.hh"
+
+#include "../log.hh"
+#include "enum_string_helper.hh"
+#include "instance.hh"
+#include "staging_ring.hh"
+
+namespace vkb::vk
+{
+	geometry_arena::geometry_arena(uint32_t vertex_stride, uint32_t vertex_capacity,
+	                               uint32_t index_capacity)
+	: stride_ {vertex_stride}
+	, movable_ {!instance::get().has_mesh_shader()}
+	{
+		rebuild(vertex_capacity, index_capacity);
+	}
+
+	geometry_arena::~geometry_arena()
+	{
+		instance& inst = instance::get();
+
+		// As in rebuild, frames in flight may still read the buffers. Blocks go after
+		// the frees of removed meshes still in the queue.
+		inst.clear_movable(indices_);
+		inst.clear_movable(vertices_);
+		inst.get_deletion_queue().push(indices_);
+		inst.get_deletion_queue().push(vertices_);
+		inst.get_deletion_queue().push(index_block_);
+		inst.get_deletion_queue().push(vertex_block_);
+	}
+
+	uint32_t geometry_arena::add_mesh(void const* verts, uint32_t vert_count,
+	                                  mc::array_view<uint16_t> idcs)
+	{
+		log::assert(vert_count > 0 && idcs.size() > 0, "Empty mesh");
+
+		slot s {};
+		s.range.vertex_count = vert_count;
+		s.range.index_count = idcs.size();
+		uint32_t mesh = add_slot(s, vert_count, idcs.size());
+
+		staging_ring& staging = instance::get().get_staging();
+		staging.upload_buffer(vertices_,
+		                      static_cast<VkDeviceSize>(s.range.vertex_offset) * stride_,
+		                      verts, static_cast<VkDeviceSize>(vert_count) * stride_);
+		staging.upload_buffer(indices_,
+		                      static_cast<VkDeviceSize>(s.range.first_index) *
+		                          sizeof(uint16_t),
+		                      idcs.data(), idcs.size() * sizeof(uint16_t));
+
+		return mesh;
+	}
+
+	uint32_t geometry_arena::add_shared_mesh(uint32_t                 vertex_mesh,
+	                                         mc::array_view<uint16_t> idcs)
+	{
+		log::assert(vertex_mesh < slots_.size() && slots_[vertex_mesh].vertex_alloc,
+		            "Invalid vertex mesh handle %u", vertex_mesh);
+		log::assert(idcs.size() > 0, "Empty mesh");
+
+		slot s {};
+		s.range.vertex_count = slots_[vertex_mesh].range.vertex_count;
+		s.range.index_count = idcs.size();
+		s.vertex_mesh = vertex_mesh;
+		uint32_t mesh = add_slot(s, 0, idcs.size());
+		++slots_[vertex_mesh].sharing;
+
+		instance::get().get_staging().upload_buffer(
+			indices_, static_cast<VkDeviceSize>(s.range.first_index) * sizeof(uint16_t),
+			idcs.data(), idcs.size() * sizeof(uint16_t));
+
+		return mesh;
+	}
+
+	void geometry_arena::remove_mesh(uint32_t mesh)
+	{
+		log::assert(mesh < slots_.size() && slots_[mesh].index_alloc,
+		            "Invalid mesh handle %u", mesh);
+
+		// Frames in flight may still draw the mesh, so its ranges are only reused
+		// once they complete. Holes left by a removal are seen by the next ones.
+		slot&           s = slots_[mesh];
+		deletion_queue& deletion = instance::get().get_deletion_queue();
+		if (s.vertex_mesh != UINT32_MAX)
+			--slots_[s.vertex_mesh].sharing;
+		else
+		{
+			log::assert(s.sharing == 0, "Mesh %u vertices still drawn by %u meshes", mesh,
+			            s.sharing);
+			deletion.push(vertex_block_, s.vertex_alloc);
+		}
+		deletion.push(index_block_, s.index_alloc);
+		s = {};
+		free_slots_.emplace_back(mesh);
+
+		if (fragmented(vertex_block_) || fragmented(index_block_))
+			defragment();
+	}
+
+	geometry_arena::mesh_range const& geometry_arena::get_range(uint32_t mesh) const
+	{
+		log::assert(mesh < slots_.size() && slots_[mesh].index_alloc,
+		            "Invalid mesh handle %u", mesh);
+
+		return slots_[mesh].range;
+	}
+
+	void geometry_arena::bind(VkCommandBuffer cmd) const
+	{
+		VkDeviceSize offset {0};
+		vkCmdBindVertexBuffers(cmd, 0, 1, &vertices_.buffer, &offset);
+		vkCmdBindIndexBuffer(cmd, indices_.buffer, 0, VK_INDEX_TYPE_UINT16);
+	}
+
+	VkBuffer geometry_arena::get_vertex_buffer() const
+	{
+		return vertices_.buffer;
+	}
+
+	uint32_t geometry_arena::get_generation() const
+	{
+		return generation_;
+	}
+
+	void geometry_arena::defragment()
+	{
+		rebuild(vertex_capacity_, index_capacity_);
+	}
+
+	uint32_t geometry_arena::add_slot(slot& s, uint32_t vert_count, uint32_t idx_count)
+	{
+		if (!allocate(s))
+		{
+			// Compaction leaves all the free space at the end of the new buffers
+			uint32_t vertex_capacity = vertex_capacity_ * 2;
+			if (vertex_capacity < vertex_capacity_ + vert_count)
+				vertex_capacity = vertex_capacity_ + vert_count;
+			uint32_t index_capacity = index_capacity_ * 2;
+			if (index_capacity < index_capacity_ + idx_count)
+				index_capacity = index_capacity_ + idx_count;
+
+			log::info("Growing geometry arena to %u vertices, %u indices",
+			          vertex_capacity, index_capacity);
+			rebuild(vertex_capacity, index_capacity);
+
+			bool allocated = allocate(s);
+			log::assert(allocated, "Failed to allocate mesh in geometry arena");
+		}
+
+		uint32_t mesh;
+		if (!free_slots_.empty())
+		{
+			mesh = free_slots_.back();
+			free_slots_.pop_back();
+			slots_[mesh] = s;
+		}
+		else
+		{
+			mesh = slots_.size();
+			slots_.emplace_back(s);
+		}
+
+		return mesh;
+	}
+
+	bool geometry_arena::allocate(slot& s)
+	{
+		VmaVirtualAllocationCreateInfo alloc_info {};
+		VkDeviceSize                   offset {0};
+
+		// Shared vertices follow their mesh, including through rebuilds
+		if (s.vertex_mesh != UINT32_MAX)
+			s.range.vertex_offset = slots_[s.vertex_mesh].range.vertex_offset;
+		else
+		{
+			alloc_info.size = s.range.vertex_count;
+			if (vmaVirtualAllocate(vertex_block_, &alloc_info, &s.vertex_alloc,
+			                       &offset) != VK_SUCCESS)
+				return false;
+			s.range.vertex_offset = offset;
+		}
+
+		alloc_info.size = s.range.index_count;
+		if (vmaVirtualAllocate(index_block_, &alloc_info, &s.index_alloc, &offset) !=
+		    VK_SUCCESS)
+		{
+			if (s.vertex_alloc)
+				vmaVirtualFree(vertex_block_, s.vertex_alloc);
+			s.vertex_alloc = nullptr;
+			return false;
+		}
+		s.range.first_index = offset;
+
+		return true;
+	}
+
+	bool geometry_arena::fragmented(VmaVirtualBlock block)
+	{
+		VmaDetailedStatistics stats {};
+		vmaCalculateVirtualBlockStatistics(block, &stats);
+
+		// Free space is considered lost once it is mostly made of holes between meshes
+		VmaStatistics const& total = stats.statistics;
+		VkDeviceSize         free = total.blockBytes - total.allocationBytes;
+		return stats.unusedRangeCount > 1 && stats.unusedRangeSizeMax < free / 2;
+	}
+
+	void geometry_arena::rebuild(uint32_t vertex_capacity, uint32_t index_capacity)
+	{
+		instance& inst = instance::get();
+
+		buffer vertices = inst.create_buffer(
+			static_cast<VkDeviceSize>(vertex_capacity) * stride_,
+			VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+				VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+		buffer indices = inst.create_buffer(
+			static_cast<VkDeviceSize>(index_capacity) * sizeof(uint16_t),
+			VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+				VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+		VmaVirtualBlock           vertex_block {nullptr};
+		VmaVirtualBlock           index_block {nullptr};
+		VmaVirtualBlockCreateInfo block_info {};
+		block_info.size = vertex_capacity;
+		VkResult res = vmaCreateVirtualBlock(&block_info, &vertex_block);
+		log::assert(res == VK_SUCCESS, "Failed to create vertex virtual block (%s)",
+		            string_VkResult(res));
+		block_info.size = index_capacity;
+		res = vmaCreateVirtualBlock(&block_info, &index_block);
+		log::assert(res == VK_SUCCESS, "Failed to create index virtual block (%s)",
+		            string_VkResult(res));
+
+		if (vertices_.buffer)
+		{
+			mc::vector<VkBufferCopy2> vertex_copies;
+			mc::vector<VkBufferCopy2> index_copies;
+
+			for (uint32_t i {0}; i < slots_.size(); ++i)
+			{
+				slot& s = slots_[i];
+				if (!s.index_alloc)
+					continue;
+
+				VkBufferCopy2 region {};
+				region.sType = VK_STRUCTURE_TYPE_BUFFER_COPY_2;
+
+				VmaVirtualAllocationCreateInfo alloc_info {};
+				VkDeviceSize                   offset {0};
+
+				if (s.vertex_alloc)
+				{
+					alloc_info.size = s.range.vertex_count;
+					res = vmaVirtualAllocate(vertex_block, &alloc_info, &s.vertex_alloc,
+					                         &offset);
+					log::assert(res == VK_SUCCESS, "Failed to move mesh vertices (%s)",
+					            string_VkResult(res));
+					region.srcOffset =
+						static_cast<VkDeviceSize>(s.range.vertex_offset) * stride_;
+					region.dstOffset = offset * stride_;
+					region.size =
+						static_cast<VkDeviceSize>(s.range.vertex_count) * stride_;
+					vertex_copies.emplace_back(region);
+					s.range.vertex_offset = offset;
+				}
+
+				alloc_info.size = s.range.index_count;
+				res =
+					vmaVirtualAllocate(index_block, &alloc_info, &s.index_alloc, &offset);
+				log::assert(res == VK_SUCCESS, "Failed to move mesh indices (%s)",
+				            string_VkResult(res));
+				region.srcOffset = s.range.first_index * sizeof(uint16_t);
+				region.dstOffset = offset * sizeof(uint16_t);
+				region.size = s.range.index_count * sizeof(uint16_t);
+				index_copies.emplace_back(region);
+				s.range.first_index = offset;
+			}
+
+			// Once every owner moved
+			for (slot& s : slots_)
+			{
+				if (s.index_alloc && s.vertex_mesh != UINT32_MAX)
+					s.range.vertex_offset = slots_[s.vertex_mesh].range.vertex_offset;
+			}
+
+			if (!index_copies.empty())
+			{
+				staging_ring&   staging = inst.get_staging();
+				VkCommandBuffer cmd = staging.commands();
+
+				// Pending uploads may still target the old buffers
+				VkMemoryBarrier barrier {};
+				barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+				barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+				barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+				vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT,
+				                     VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &barrier, 0,
+				                     nullptr, 0, nullptr);
+
+				VkCopyBufferInfo2 copy {};
+				copy.sType = VK_STRUCTURE_TYPE_COPY_BUFFER_INFO_2;
+				copy.srcBuffer = vertices_.buffer;
+				copy.dstBuffer = vertices.buffer;
+				copy.regionCount = vertex_copies.size();
+				copy.pRegions = vertex_copies.data();
+				vkCmdCopyBuffer2(cmd, &copy);
+
+				copy.srcBuffer = indices_.buffer;
+				copy.dstBuffer = indices.buffer;
+				copy.regionCount = index_copies.size();
+				copy.pRegions = index_copies.data();
+				vkCmdCopyBuffer2(cmd, &copy);
+
+				// Submitted ahead of the next frame, which draws from the new buffers
+				barrier.dstAccessMask =
+					VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+				vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT,
+				                     VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 1, &barrier,
+				                     0, nullptr, 0, nullptr);
+				staging.submit_async();
+			}
+
+			// Frames in flight and the copies may still read the old buffers, until
+			// the next frame completes. Defragmentation must not move them anymore.
+			inst.clear_movable(indices_);
+			inst.clear_movable(vertices_);
+			inst.get_deletion_queue().push(indices_);
+			inst.get_deletion_queue().push(vertices_);
+			// Blocks may still have removed meshes queued for freeing
+			inst.get_deletion_queue().push(index_block_);
+			inst.get_deletion_queue().push(vertex_block_);
+		}
+
+		vertices_ = vertices;
+		indices_ = indices;
+		vertex_block_ = vertex_block;
+		index_block_ = index_block;
+		vertex_capacity_ = vertex_capacity;
+		index_capacity_ = index_capacity;
+		++generation_;
+
+		if (movable_)
+		{
+			inst.set_movable(vertices_);
+			inst.set_movable(indices_);
+		}
+	}
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "buffer.hh"
+
+#include <array_view.hh>
+#include <vector.hh>
+
+#include "vma/vma.hh"
+#include <volk/volk.h>
+
+#include <stdint.h>
+
+namespace vkb::vk
+{
+	// Device local vertex and index buffers shared by every mesh of a vertex format.
+	// Meshes are ranges sub-allocated from VMA virtual blocks counting elements
+	// (vertices and indices) instead of bytes, so all of them are drawn after a single
+	// bind, with their vertex offset and first index.
+	// Buffers grow when full, and are compacted when freed meshes leave too many holes.
+	class geometry_arena
+	{
+	public:
+		struct mesh_range
+		{
+			uint32_t vertex_offset {0};
+			uint32_t vertex_count {0};
+			uint32_t first_index {0};
+			uint32_t index_count {0};
+		};
+
+		geometry_arena(uint32_t vertex_stride, uint32_t vertex_capacity,
+		               uint32_t index_capacity);
+		geometry_arena(geometry_arena const&) = delete;
+		geometry_arena(geometry_arena&&) = delete;
+		~geometry_arena();
+
+		geometry_arena& operator=(geometry_arena const&) = delete;
+		geometry_arena& operator=(geometry_arena&&) = delete;
+
+		// Uploads are recorded on the staging ring, which must be flushed before the
+		// mesh is drawn. Returned handle stays valid across compaction.
+		uint32_t add_mesh(void const* verts, uint32_t vert_count,
+		                  mc::array_view<uint16_t> idcs);
+		// Mesh drawing the vertices of `vertex_mesh` with its own indices, such as a
+		// LOD. `vertex_mesh` must outlive it.
+		uint32_t add_shared_mesh(uint32_t vertex_mesh, mc::array_view<uint16_t> idcs);
+		void     remove_mesh(uint32_t mesh);
+
+		mesh_range const& get_range(uint32_t mesh) const;
+
+		void bind(VkCommandBuffer cmd) const;
+		// Vertex buffer as a storage buffer, for mesh shaders. Changes when the arena
+		// grows or compacts, never through defragmentation when mesh shaders are
+		// supported since descriptors reference it.
+		VkBuffer get_vertex_buffer() const;
+		// Bumped each time the buffers are replaced
+		uint32_t get_generation() const;
+
+		// Packs every mesh at the start of new buffers
+		void defragment();
+
+	private:
+		struct slot
+		{
+			mesh_range           range;
+			VmaVirtualAllocation vertex_alloc {nullptr};
+			VmaVirtualAllocation index_alloc {nullptr};
+			// Mesh owning the vertices, UINT32_MAX when they are its own
+			uint32_t             vertex_mesh {UINT32_MAX};
+			// Meshes drawing the vertices of this one
+			uint32_t             sharing {0};
+		};
+
+		uint32_t add_slot(slot& s, uint32_t vert_count, uint32_t idx_count);
+		bool     allocate(slot& s);
+		bool fragmented(VmaVirtualBlock block);
+		void rebuild(uint32_t vertex_capacity, uint32_t index_capacity);
+
+		uint32_t stride_ {0};
+		uint32_t vertex_capacity_ {0};
+		uint32_t index_capacity_ {0};
+		uint32_t generation_ {0};
+		// Whether defragmentation may move the buffers
+		bool     movable_ {false};
+
+		buffer          vertices_;
+		buffer          indices_;
+		VmaVirtualBlock vertex_block_ {nullptr};
+		VmaVirtualBlock index_block_ {nullptr};
+
+		mc::vector<slot>     slots_;
+		mc::vector<uint32_t> free_slots_;
+	};
+}
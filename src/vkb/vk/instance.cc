@@ -1,12 +1,16 @@
 #include "instance.hh"
 
+#include "../core/thread.hh"
+#include "../core/time.hh"
 #include "../log.hh"
 #include <array.hh>
+#include <stdio.h>
 #include <string.h>
 #include <string_view.hh>
 #include <vector.hh>
 
 #include "enum_string_helper.hh"
+#include "staging_ring.hh"
 #include "surface.hh"
 
 namespace vkb::vk
@@ -47,6 +51,7 @@ namespace vkb::vk
 	}
 
 	instance::instance(bool enable_validation)
+	: owner_thread_ {thread::current_id()}
 	{
 		instance_ = this;
 
@@ -61,8 +66,27 @@ namespace vkb::vk
 
 	instance::~instance()
 	{
+		// Staging ring needs the instance to flush its uploads
+		if (staging_)
+			delete staging_;
+
+		if (device_)
+			vkDeviceWaitIdle(device_);
+
+		if (defrag_ctx_)
+		{
+			if (defrag_pass_pending_)
+				vmaEndDefragmentationPass(allocator_, defrag_ctx_, &defrag_pass_);
+			end_defragmentation();
+		}
+
+		deletion_.flush();
+
 		instance_ = nullptr;
 
+		if (timeline_)
+			vkDestroySemaphore(device_, timeline_, nullptr);
+
 		// if (transient_command_pool_)
 		// 	vkDestroyCommandPool(device_, transient_command_pool_, nullptr);
 		if (command_pool_)
@@ -86,7 +110,7 @@ namespace vkb::vk
 		volkFinalize();
 	}
 
-	void instance::create_device(surface const& surface)
+	void instance::create_device(surface const& surface, VkDeviceSize staging_size)
 	{
 		bool created = select_physical_device(surface);
 		log::assert(created, "Failed to find suitable physical device");
@@ -99,6 +123,11 @@ namespace vkb::vk
 
 		created = create_command_pools();
 		log::assert(created, "Failed to create command pools");
+
+		created = create_timeline();
+		log::assert(created, "Failed to create timeline semaphore");
+
+		staging_ = new staging_ring(staging_size);
 	}
 
 	VkInstance instance::get_instance()
@@ -121,11 +150,199 @@ namespace vkb::vk
 		return phys_device_;
 	}
 
+	bool instance::has_mesh_shader()
+	{
+		return mesh_shader_;
+	}
+
 	VmaAllocator instance::get_allocator()
 	{
 		return allocator_;
 	}
 
+	void instance::next_frame()
+	{
+		++frame_index_;
+		vmaSetCurrentFrameIndex(allocator_, frame_index_);
+	}
+
+	bool instance::has_memory_budget()
+	{
+		return memory_budget_;
+	}
+
+	mc::vector<VmaBudget> instance::get_memory_budgets()
+	{
+		VkPhysicalDeviceMemoryProperties const* mem_props;
+		vmaGetMemoryProperties(allocator_, &mem_props);
+
+		mc::vector<VmaBudget> budgets(mem_props->memoryHeapCount);
+		vmaGetHeapBudgets(allocator_, budgets.data());
+		return budgets;
+	}
+
+	bool instance::dump_memory_stats(mc::string_view path)
+	{
+		FILE* file = fopen(path.data(), "wb");
+		if (!file)
+		{
+			log::error("Failed to open %s to dump memory stats", path.data());
+			return false;
+		}
+
+		char* stats {nullptr};
+		vmaBuildStatsString(allocator_, &stats, VK_TRUE);
+		fputs(stats, file);
+		vmaFreeStatsString(allocator_, stats);
+
+		fclose(file);
+		return true;
+	}
+
+	void instance::set_movable(buffer& buf)
+	{
+		vmaSetAllocationUserData(allocator_, buf.memory, &buf);
+	}
+
+	void instance::clear_movable(buffer const& buf)
+	{
+		vmaSetAllocationUserData(allocator_, buf.memory, nullptr);
+	}
+
+	void instance::defragment(double budget_ms)
+	{
+		if (!defrag_ctx_)
+		{
+			if (frame_index_ - last_defrag_frame_ < defrag_interval)
+				return;
+			last_defrag_frame_ = frame_index_;
+
+			// Only worth it when a quarter of the allocated blocks is unused
+			VmaTotalStatistics stats {};
+			vmaCalculateStatistics(allocator_, &stats);
+			VmaStatistics const& total = stats.total.statistics;
+			if (total.blockBytes - total.allocationBytes < total.blockBytes / 4)
+				return;
+
+			VmaDefragmentationInfo info {};
+			info.flags = VMA_DEFRAGMENTATION_FLAG_ALGORITHM_FAST_BIT;
+			info.maxBytesPerPass = defrag_max_bytes_per_pass;
+			info.maxAllocationsPerPass = defrag_max_moves_per_pass;
+			VkResult res = vmaBeginDefragmentation(allocator_, &info, &defrag_ctx_);
+			if (res != VK_SUCCESS)
+			{
+				log::error("Failed to begin defragmentation (%s)", string_VkResult(res));
+				defrag_ctx_ = nullptr;
+				return;
+			}
+		}
+
+		if (defrag_pass_pending_)
+		{
+			if (get_completed_timeline_value() < defrag_pass_value_)
+				return;
+
+			defrag_pass_pending_ = false;
+			if (vmaEndDefragmentationPass(allocator_, defrag_ctx_, &defrag_pass_) ==
+			    VK_SUCCESS)
+			{
+				end_defragmentation();
+				return;
+			}
+		}
+
+		time::stamp start = time::now();
+		do
+		{
+			VkResult res = vmaBeginDefragmentationPass(allocator_, defrag_ctx_,
+			                                           &defrag_pass_);
+			if (res == VK_SUCCESS)
+			{
+				end_defragmentation();
+				return;
+			}
+
+			// Submitted frames may still read the moved allocations. The copies are
+			// submitted after them, so the pass ends once the copies completed.
+			if (move_allocations(defrag_pass_))
+			{
+				defrag_pass_pending_ = true;
+				defrag_pass_value_ = staging_->submit_async();
+				return;
+			}
+
+			res = vmaEndDefragmentationPass(allocator_, defrag_ctx_, &defrag_pass_);
+			if (res == VK_SUCCESS)
+			{
+				end_defragmentation();
+				return;
+			}
+		}
+		while (time::elapsed_ms(start, time::now()) < budget_ms);
+	}
+
+	staging_ring& instance::get_staging()
+	{
+		return *staging_;
+	}
+
+	deletion_queue& instance::get_deletion_queue()
+	{
+		return deletion_;
+	}
+
+	VkSemaphore instance::get_timeline()
+	{
+		return timeline_;
+	}
+
+	void instance::set_owner_thread()
+	{
+		// Read by other threads only when they wrongly record work
+		__atomic_store_n(&owner_thread_, thread::current_id(), __ATOMIC_RELAXED);
+	}
+
+	void instance::assert_owner_thread()
+	{
+		log::assert(thread::current_id() ==
+		                __atomic_load_n(&owner_thread_, __ATOMIC_RELAXED),
+		            "GPU work recorded outside of the owner thread");
+	}
+
+	uint64_t instance::next_timeline_value()
+	{
+		assert_owner_thread();
+		return ++timeline_value_;
+	}
+
+	uint64_t instance::next_frame_timeline_value()
+	{
+		frame_values_[frame_index_ % frame_history] = next_timeline_value();
+		return timeline_value_;
+	}
+
+	uint64_t instance::get_timeline_value()
+	{
+		return timeline_value_;
+	}
+
+	uint64_t instance::get_completed_timeline_value()
+	{
+		uint64_t value {0};
+		vkGetSemaphoreCounterValue(device_, timeline_, &value);
+		return value;
+	}
+
+	void instance::wait_timeline_value(uint64_t value)
+	{
+		VkSemaphoreWaitInfo info {};
+		info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+		info.semaphoreCount = 1;
+		info.pSemaphores = &timeline_;
+		info.pValues = &value;
+		vkWaitSemaphores(device_, &info, UINT64_MAX);
+	}
+
 	VkQueue instance::get_graphics_queue()
 	{
 		return graphics_queue_;
@@ -158,16 +375,18 @@ namespace vkb::vk
 	image instance::create_image(uint32_t w, uint32_t h, uint32_t mip_lvl,
 	                             VkFormat format, VkImageTiling tiling,
 	                             VkImageUsageFlags                      usage,
-	                             [[maybe_unused]] VkMemoryPropertyFlags props)
+	                             [[maybe_unused]] VkMemoryPropertyFlags props,
+	                             uint32_t layers, VkImageCreateFlags flags)
 	{
 		VkImageCreateInfo img_info {};
 		img_info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+		img_info.flags = flags;
 		img_info.imageType = VK_IMAGE_TYPE_2D;
 		img_info.extent.width = w;
 		img_info.extent.height = h;
 		img_info.extent.depth = 1;
 		img_info.mipLevels = 1;
-		img_info.arrayLayers = 1;
+		img_info.arrayLayers = layers;
 		img_info.format = format;
 		img_info.tiling = tiling;
 		img_info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
@@ -196,11 +415,12 @@ namespace vkb::vk
 	}
 
 	VkImageView instance::create_image_view(VkImage img, VkFormat format,
-	                                        VkImageAspectFlags flags, uint32_t mip_lvl)
+	                                        VkImageAspectFlags flags, uint32_t mip_lvl,
+	                                        VkImageViewType type, uint32_t layers)
 	{
 		VkImageViewCreateInfo create_info {};
 		create_info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-		create_info.viewType = VK_IMAGE_VIEW_TYPE_2D;
+		create_info.viewType = type;
 		create_info.image = img;
 		create_info.format = format;
 		create_info.components.r = VK_COMPONENT_SWIZZLE_IDENTITY;
@@ -211,7 +431,7 @@ namespace vkb::vk
 		create_info.subresourceRange.baseMipLevel = 0;
 		create_info.subresourceRange.levelCount = 1;
 		create_info.subresourceRange.baseArrayLayer = 0;
-		create_info.subresourceRange.layerCount = 1;
+		create_info.subresourceRange.layerCount = layers;
 		create_info.subresourceRange.levelCount = mip_lvl;
 
 		VkImageView img_view {nullptr};
@@ -226,7 +446,8 @@ namespace vkb::vk
 		VkCommandBuffer cmd, VkImage img, VkImageLayout old_layout,
 		VkImageLayout new_layout, VkAccessFlags src_access_mask,
 		VkAccessFlags dst_access_mask, VkPipelineStageFlags src_stage,
-		VkPipelineStageFlags dst_stage, VkImageAspectFlags aspect, uint32_t mip_lvl)
+		VkPipelineStageFlags dst_stage, VkImageAspectFlags aspect, uint32_t mip_lvl,
+		uint32_t layers)
 	{
 		// TODO VK_KHR_synchronization2
 		VkImageMemoryBarrier barrier {};
@@ -240,7 +461,7 @@ namespace vkb::vk
 		barrier.subresourceRange.baseMipLevel = 0;
 		barrier.subresourceRange.levelCount = mip_lvl;
 		barrier.subresourceRange.baseArrayLayer = 0;
-		barrier.subresourceRange.layerCount = 1;
+		barrier.subresourceRange.layerCount = layers;
 		barrier.srcAccessMask = src_access_mask;
 		barrier.dstAccessMask = dst_access_mask;
 
@@ -272,6 +493,31 @@ namespace vkb::vk
 		                               &result.buffer, &result.memory, nullptr);
 		log::assert(res == VK_SUCCESS, "Failed to create buffer (%s)",
 		            string_VkResult(res));
+		result.size = size;
+		result.usage = usage;
+		return result;
+	}
+
+	buffer instance::create_staging_buffer(VkDeviceSize size)
+	{
+		VkBufferCreateInfo create_info {};
+		create_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+		create_info.size = size;
+		create_info.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+		create_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+		VmaAllocationCreateInfo alloc_info {};
+		alloc_info.usage = VMA_MEMORY_USAGE_AUTO_PREFER_HOST;
+		alloc_info.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT |
+		                   VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+		buffer            result {};
+		VmaAllocationInfo result_info {};
+		VkResult res = vmaCreateBuffer(allocator_, &create_info, &alloc_info,
+		                               &result.buffer, &result.memory, &result_info);
+		log::assert(res == VK_SUCCESS, "Failed to create staging buffer (%s)",
+		            string_VkResult(res));
+		result.mapped = result_info.pMappedData;
 		return result;
 	}
 
@@ -280,6 +526,93 @@ namespace vkb::vk
 		vmaDestroyBuffer(allocator_, buf.buffer, buf.memory);
 	}
 
+	bool instance::has_host_visible_vram()
+	{
+		return host_visible_vram_;
+	}
+
+	dynamic_buffer instance::create_dynamic_buffer(VkDeviceSize       size,
+	                                               VkBufferUsageFlags usage)
+	{
+		VkBufferCreateInfo create_info {};
+		create_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+		create_info.size = size;
+		create_info.usage = usage | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+		create_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+		// Let VMA pick a DEVICE_LOCAL | HOST_VISIBLE memory type when one exists, and
+		// fall back to plain device local memory (fed through a staging buffer)
+		// otherwise.
+		VmaAllocationCreateInfo alloc_info {};
+		alloc_info.usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
+		alloc_info.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT |
+		                   VMA_ALLOCATION_CREATE_HOST_ACCESS_ALLOW_TRANSFER_INSTEAD_BIT |
+		                   VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+		dynamic_buffer    result {};
+		VmaAllocationInfo result_info {};
+		VkResult res = vmaCreateBuffer(allocator_, &create_info, &alloc_info,
+		                               &result.device.buffer, &result.device.memory,
+		                               &result_info);
+		log::assert(res == VK_SUCCESS, "Failed to create dynamic buffer (%s)",
+		            string_VkResult(res));
+
+		VkMemoryPropertyFlags mem_flags {0};
+		vmaGetAllocationMemoryProperties(allocator_, result.device.memory, &mem_flags);
+		if (mem_flags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)
+			result.device.mapped = result_info.pMappedData;
+		else
+			result.staging = create_staging_buffer(size);
+
+		return result;
+	}
+
+	void instance::update_dynamic_buffer(VkCommandBuffer cmd, dynamic_buffer& buf,
+	                                     void const* data, VkDeviceSize size,
+	                                     VkPipelineStageFlags dst_stage,
+	                                     VkAccessFlags        dst_access)
+	{
+		// In flight fences are waited by swapchain image, which does not guarantee the
+		// previous frame reading the buffer retired. When its history slot was reused,
+		// the wait is for a newer frame and only conservative.
+		if (buf.frame && buf.frame != frame_index_)
+		{
+			uint64_t value = frame_values_[buf.frame % frame_history];
+			if (get_completed_timeline_value() < value)
+				wait_timeline_value(value);
+		}
+		buf.frame = frame_index_;
+
+		if (buf.device.mapped)
+		{
+			memcpy(buf.device.mapped, data, size);
+			vmaFlushAllocation(allocator_, buf.device.memory, 0, size);
+			return;
+		}
+
+		memcpy(buf.staging.mapped, data, size);
+		vmaFlushAllocation(allocator_, buf.staging.memory, 0, size);
+		copy_buffer(cmd, buf.staging, buf.device, size);
+
+		VkBufferMemoryBarrier barrier {};
+		barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+		barrier.buffer = buf.device.buffer;
+		barrier.size = size;
+		barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		barrier.dstAccessMask = dst_access;
+		barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, dst_stage, 0, 0,
+		                     nullptr, 1, &barrier, 0, nullptr);
+	}
+
+	void instance::destroy_dynamic_buffer(dynamic_buffer const& buf)
+	{
+		if (buf.staging.buffer)
+			destroy_buffer(buf.staging);
+		destroy_buffer(buf.device);
+	}
+
 	void instance::copy_buffer(VkCommandBuffer cmd, buffer const& from, buffer const& to,
 	                           uint32_t size)
 	{
@@ -678,14 +1011,22 @@ namespace vkb::vk
 		VkPhysicalDeviceFeatures feats {};
 		feats.samplerAnisotropy = VK_TRUE;
 		feats.wideLines = VK_TRUE;
+		feats.multiDrawIndirect = VK_TRUE;
+		feats.drawIndirectFirstInstance = VK_TRUE;
 
 		VkPhysicalDeviceMultiDrawFeaturesEXT multiDraw_feats {};
 		multiDraw_feats.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MULTI_DRAW_FEATURES_EXT;
 		multiDraw_feats.multiDraw = VK_TRUE;
 
+		VkPhysicalDeviceVulkan12Features vulkan12_feats {};
+		vulkan12_feats.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+		vulkan12_feats.pNext = &multiDraw_feats;
+		vulkan12_feats.timelineSemaphore = true;
+		vulkan12_feats.drawIndirectCount = true;
+
 		VkPhysicalDeviceVulkan13Features vulkan13_feats {};
 		vulkan13_feats.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
-		vulkan13_feats.pNext = &multiDraw_feats;
+		vulkan13_feats.pNext = &vulkan12_feats;
 		vulkan13_feats.dynamicRendering = true;
 
 		VkDeviceCreateInfo create_info {};
@@ -695,13 +1036,55 @@ namespace vkb::vk
 		create_info.pQueueCreateInfos = queues.data();
 		create_info.pEnabledFeatures = &feats;
 
-		mc::array<char const*, 3> required_exts {
+		mc::vector<char const*> exts {
 			VK_KHR_SWAPCHAIN_EXTENSION_NAME,
 			VK_EXT_MULTI_DRAW_EXTENSION_NAME,
 			VK_KHR_SHADER_DRAW_PARAMETERS_EXTENSION_NAME,
 		};
-		create_info.enabledExtensionCount = required_exts.size();
-		create_info.ppEnabledExtensionNames = required_exts.data();
+
+		uint32_t ext_cnt {0};
+		vkEnumerateDeviceExtensionProperties(phys_device_, nullptr, &ext_cnt, nullptr);
+		mc::vector<VkExtensionProperties> avail_exts(ext_cnt);
+		vkEnumerateDeviceExtensionProperties(phys_device_, nullptr, &ext_cnt,
+		                                     avail_exts.data());
+		bool mesh_shader_ext {false};
+		for (uint32_t i {0}; i < avail_exts.size(); ++i)
+		{
+			char const* name = avail_exts[i].extensionName;
+			if (strcmp(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME, name) == 0)
+			{
+				exts.emplace_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+				memory_budget_ = true;
+			}
+			else if (strcmp(VK_EXT_MESH_SHADER_EXTENSION_NAME, name) == 0)
+				mesh_shader_ext = true;
+		}
+
+		// Mesh shaders are optional, gpu_driven falls back to indexed draws of meshlets
+		VkPhysicalDeviceMeshShaderFeaturesEXT mesh_feats {};
+		mesh_feats.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MESH_SHADER_FEATURES_EXT;
+		if (mesh_shader_ext)
+		{
+			VkPhysicalDeviceFeatures2 avail_feats {};
+			avail_feats.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+			avail_feats.pNext = &mesh_feats;
+			vkGetPhysicalDeviceFeatures2(phys_device_, &avail_feats);
+			mesh_shader_ = mesh_feats.taskShader && mesh_feats.meshShader;
+		}
+		if (mesh_shader_)
+		{
+			// Only the stages, the other features depend on extensions not enabled
+			mesh_feats.pNext = create_info.pNext;
+			mesh_feats.multiviewMeshShader = VK_FALSE;
+			mesh_feats.primitiveFragmentShadingRateMeshShader = VK_FALSE;
+			mesh_feats.meshShaderQueries = VK_FALSE;
+			create_info.pNext = &mesh_feats;
+			exts.emplace_back(VK_EXT_MESH_SHADER_EXTENSION_NAME);
+		}
+		log::info("Mesh shaders: %s", mesh_shader_ ? "available" : "unavailable");
+
+		create_info.enabledExtensionCount = exts.size();
+		create_info.ppEnabledExtensionNames = exts.data();
 
 		VkResult res = vkCreateDevice(phys_device_, &create_info, nullptr, &device_);
 		if (res == VK_SUCCESS)
@@ -725,10 +1108,124 @@ namespace vkb::vk
 		create_info.instance = inst_;
 		create_info.vulkanApiVersion = VK_API_VERSION_1_4;
 		create_info.pVulkanFunctions = &funcs;
+		// Without the extension, budgets are estimated from heap sizes
+		if (memory_budget_)
+			create_info.flags |= VMA_ALLOCATOR_CREATE_EXT_MEMORY_BUDGET_BIT;
 
 		VkResult res = vmaCreateAllocator(&create_info, &allocator_);
+		if (res != VK_SUCCESS)
+			return false;
 
-		return res == VK_SUCCESS;
+		constexpr VkMemoryPropertyFlags vram_flags {VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT |
+		                                            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT};
+		VkPhysicalDeviceMemoryProperties const* mem_props;
+		vmaGetMemoryProperties(allocator_, &mem_props);
+		for (uint32_t i {0}; i < mem_props->memoryTypeCount; ++i)
+		{
+			if ((mem_props->memoryTypes[i].propertyFlags & vram_flags) == vram_flags)
+			{
+				host_visible_vram_ = true;
+				break;
+			}
+		}
+		log::info("Host visible device local memory: %s",
+		          host_visible_vram_ ? "available" : "unavailable, using staging");
+
+		mc::vector<VmaBudget> budgets = get_memory_budgets();
+		for (uint32_t i {0}; i < budgets.size(); ++i)
+		{
+			log::info("Memory heap %u: %llu MiB budget%s", i,
+			          static_cast<unsigned long long>(budgets[i].budget / (1024 * 1024)),
+			          memory_budget_ ? "" : " (estimated)");
+		}
+
+		return true;
+	}
+
+	bool instance::move_allocations(VmaDefragmentationPassMoveInfo& pass)
+	{
+		VkCommandBuffer cmd {nullptr};
+		VkMemoryBarrier barrier {};
+		barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+
+		for (uint32_t i {0}; i < pass.moveCount; ++i)
+		{
+			VmaDefragmentationMove& move = pass.pMoves[i];
+
+			VmaAllocationInfo info {};
+			vmaGetAllocationInfo(allocator_, move.srcAllocation, &info);
+			buffer* owner = static_cast<buffer*>(info.pUserData);
+			if (!owner)
+			{
+				move.operation = VMA_DEFRAGMENTATION_MOVE_OPERATION_IGNORE;
+				continue;
+			}
+
+			VkBufferCreateInfo create_info {};
+			create_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+			create_info.size = owner->size;
+			create_info.usage = owner->usage;
+			create_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+			VkBuffer moved {nullptr};
+			VkResult res = vkCreateBuffer(device_, &create_info, nullptr, &moved);
+			if (res == VK_SUCCESS)
+				res = vmaBindBufferMemory(allocator_, move.dstTmpAllocation, moved);
+			if (res != VK_SUCCESS)
+			{
+				log::error("Failed to move buffer (%s)", string_VkResult(res));
+				if (moved)
+					vkDestroyBuffer(device_, moved, nullptr);
+				move.operation = VMA_DEFRAGMENTATION_MOVE_OPERATION_IGNORE;
+				continue;
+			}
+
+			if (!cmd)
+			{
+				// Pending uploads may target moved buffers
+				cmd = staging_->commands();
+				barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+				barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+				vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT,
+				                     VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &barrier, 0,
+				                     nullptr, 0, nullptr);
+			}
+
+			buffer to {};
+			to.buffer = moved;
+			copy_buffer(cmd, *owner, to, owner->size);
+
+			// Memory stays owned by the allocation, only the old buffer is destroyed
+			buffer old {};
+			old.buffer = owner->buffer;
+			deletion_.push(old);
+
+			owner->buffer = moved;
+		}
+
+		if (!cmd)
+			return false;
+
+		// Frames and uploads submitted after the copies use the moved buffers
+		barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+		vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT,
+		                     VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 1, &barrier, 0,
+		                     nullptr, 0, nullptr);
+
+		return true;
+	}
+
+	void instance::end_defragmentation()
+	{
+		VmaDefragmentationStats stats {};
+		vmaEndDefragmentation(allocator_, defrag_ctx_, &stats);
+		defrag_ctx_ = nullptr;
+
+		log::info("Defragmentation moved %u allocations (%llu bytes), freed %u blocks",
+		          stats.allocationsMoved,
+		          static_cast<unsigned long long>(stats.bytesMoved),
+		          stats.deviceMemoryBlocksFreed);
 	}
 
 	bool instance::create_command_pools()
@@ -746,4 +1243,19 @@ namespace vkb::vk
 
 		return res == VK_SUCCESS;
 	}
+
+	bool instance::create_timeline()
+	{
+		VkSemaphoreTypeCreateInfo type_info {};
+		type_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+		type_info.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+		type_info.initialValue = 0;
+
+		VkSemaphoreCreateInfo create_info {};
+		create_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+		create_info.pNext = &type_info;
+
+		VkResult res = vkCreateSemaphore(device_, &create_info, nullptr, &timeline_);
+		return res == VK_SUCCESS;
+	}
 } // namespace vkb::vk
\ No newline at end of file
@@ -1,17 +1,20 @@
 #pragma once
 
 #include <array_view.hh>
+#include <string_view.hh>
 #include <vector.hh>
 
 #include "vma/vma.hh"
 #include <volk/volk.h>
 
 #include "buffer.hh"
+#include "deletion_queue.hh"
 #include "image.hh"
 
 namespace vkb::vk
 {
 	class surface;
+	class staging_ring;
 
 	class instance
 	{
@@ -23,6 +26,11 @@ namespace vkb::vk
 			uint32_t present = UINT32_MAX;
 		};
 
+		constexpr static VkDeviceSize default_staging_size {16 * 1024 * 1024};
+		constexpr static uint32_t     defrag_interval {600};
+		constexpr static VkDeviceSize defrag_max_bytes_per_pass {16 * 1024 * 1024};
+		constexpr static uint32_t     defrag_max_moves_per_pass {64};
+
 		static instance& get();
 
 		instance(bool enable_validation);
@@ -33,7 +41,8 @@ namespace vkb::vk
 		instance& operator=(instance const&) = delete;
 		instance& operator=(instance&&) = delete;
 
-		void create_device(surface const& surface);
+		void create_device(surface const& surface,
+		                   VkDeviceSize   staging_size = default_staging_size);
 
 		VkInstance get_instance();
 
@@ -41,9 +50,51 @@ namespace vkb::vk
 
 		VkDevice         get_device();
 		VkPhysicalDevice get_physical_device();
+		// VK_EXT_mesh_shader with task shaders, enabled when the device supports it
+		bool             has_mesh_shader();
 
 		VmaAllocator get_allocator();
 
+		// Advances VMA frame index, which refreshes memory budgets
+		void next_frame();
+
+		bool                  has_memory_budget();
+		mc::vector<VmaBudget> get_memory_budgets();
+		bool                  dump_memory_stats(mc::string_view path);
+
+		// Lets defragmentation move the buffer. Owner must keep `buf` at the same
+		// address, and must not reference `buf.buffer` in descriptors.
+		void set_movable(buffer& buf);
+		// Must be called before a movable buffer is retired or destroyed
+		void clear_movable(buffer const& buf);
+		// Runs defragmentation passes until `budget_ms` is spent. A new
+		// defragmentation starts every `defrag_interval` frames, when enough memory is
+		// lost in allocated blocks.
+		void defragment(double budget_ms);
+
+		staging_ring& get_staging();
+
+		// Objects still used by frames in flight are destroyed through this queue
+		deletion_queue& get_deletion_queue();
+
+		// GPU work is recorded and submitted by a single thread, the one creating the
+		// instance until another one takes over, such as the render thread of a
+		// frame_pipeline. Checked where work is recorded and submitted.
+		void set_owner_thread();
+		void assert_owner_thread();
+
+		// Timeline semaphore signaled by each frame submission
+		VkSemaphore get_timeline();
+		// Value to signal with the next submission
+		uint64_t next_timeline_value();
+		// Value to signal with the submission of the current frame, kept to know when
+		// the dynamic buffers it updated can be rewritten
+		uint64_t next_frame_timeline_value();
+		uint64_t get_timeline_value();
+		uint64_t get_completed_timeline_value();
+		// Blocks until the GPU reached `value`
+		void     wait_timeline_value(uint64_t value);
+
 		VkQueue get_graphics_queue();
 		VkQueue get_compute_queue();
 		VkQueue get_present_queue();
@@ -51,24 +102,41 @@ namespace vkb::vk
 		VkFormat find_supported_format(mc::array_view<VkFormat> formats,
 		                               VkImageTiling tiling, VkFormatFeatureFlags feats);
 
+		// Cubemaps are 6 layers with VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT
 		image create_image(uint32_t w, uint32_t h, uint32_t mip_lvl, VkFormat format,
 		                   VkImageTiling tiling, VkImageUsageFlags usage,
-		                   VkMemoryPropertyFlags props);
+		                   VkMemoryPropertyFlags props, uint32_t layers = 1,
+		                   VkImageCreateFlags flags = 0);
 
 		VkImageView create_image_view(VkImage img, VkFormat format,
-		                              VkImageAspectFlags flags, uint32_t mip_lvl);
+		                              VkImageAspectFlags flags, uint32_t mip_lvl,
+		                              VkImageViewType type = VK_IMAGE_VIEW_TYPE_2D,
+		                              uint32_t        layers = 1);
 
 		void transition_image_layout(
 			VkCommandBuffer cmd, VkImage img, VkImageLayout old_layout,
 			VkImageLayout new_layout, VkAccessFlags src_access_mask,
 			VkAccessFlags dst_access_mask, VkPipelineStageFlags src_stage,
 			VkPipelineStageFlags dst_stage,
-			VkImageAspectFlags aspect = VK_IMAGE_ASPECT_COLOR_BIT, uint32_t mip_lvl = 1);
+			VkImageAspectFlags aspect = VK_IMAGE_ASPECT_COLOR_BIT, uint32_t mip_lvl = 1,
+			uint32_t layers = 1);
 
 		buffer create_buffer(VkDeviceSize size, VkBufferUsageFlags usage,
 		                     VkMemoryPropertyFlags props);
+		buffer create_staging_buffer(VkDeviceSize size);
 		void   destroy_buffer(buffer const& buf);
 
+		bool           has_host_visible_vram();
+		dynamic_buffer create_dynamic_buffer(VkDeviceSize size, VkBufferUsageFlags usage);
+		void           destroy_dynamic_buffer(dynamic_buffer const& buf);
+
+		// Waits for the frame which last updated `buf` to complete, as its buffers may
+		// be indexed by swapchain image rather than by frame in flight
+		void update_dynamic_buffer(VkCommandBuffer cmd, dynamic_buffer& buf,
+		                           void const* data, VkDeviceSize size,
+		                           VkPipelineStageFlags dst_stage,
+		                           VkAccessFlags        dst_access);
+
 		void copy_buffer(VkCommandBuffer cmd, buffer const& from, buffer const& to,
 		                 uint32_t size);
 
@@ -97,6 +165,10 @@ namespace vkb::vk
 		bool create_allocator();
 
 		bool create_command_pools();
+		bool create_timeline();
+
+		bool move_allocations(VmaDefragmentationPassMoveInfo& pass);
+		void end_defragmentation();
 
 		VkInstance               inst_ {nullptr};
 		VkDebugUtilsMessengerEXT debug_messenger_ {nullptr};
@@ -107,6 +179,17 @@ namespace vkb::vk
 		VkDevice         device_ {nullptr};
 
 		VmaAllocator allocator_ {nullptr};
+		bool         host_visible_vram_ {false};
+		bool         memory_budget_ {false};
+		bool         mesh_shader_ {false};
+		uint32_t     frame_index_ {0};
+
+		VmaDefragmentationContext      defrag_ctx_ {nullptr};
+		uint32_t                       last_defrag_frame_ {0};
+		VmaDefragmentationPassMoveInfo defrag_pass_ {};
+		// Pass ends once frames using the moved allocations are completed
+		bool     defrag_pass_pending_ {false};
+		uint64_t defrag_pass_value_ {0};
 
 		VkQueue graphics_queue_ {nullptr};
 		VkQueue compute_queue_ {nullptr};
@@ -114,5 +197,16 @@ namespace vkb::vk
 
 		VkCommandPool command_pool_ {nullptr};
 		// VkCommandPool transient_command_pool_ {nullptr};
+
+		staging_ring*  staging_ {nullptr};
+		deletion_queue deletion_;
+
+		uint64_t owner_thread_ {0};
+
+		VkSemaphore timeline_ {nullptr};
+		uint64_t    timeline_value_ {0};
+		// Timeline values of the last submitted frames, by frame index
+		constexpr static uint32_t frame_history {8};
+		uint64_t                  frame_values_[frame_history] {};
 	};
 }
\ No newline at end of file
@@ -283,18 +283,13 @@ namespace vkb::vk
 
 	material::~material()
 	{
-		instance& inst = instance::get();
+		deletion_queue& deletion = instance::get().get_deletion_queue();
 
-		if (pipe_)
-			vkDestroyPipeline(inst.get_device(), pipe_, nullptr);
-		if (pipe_layout_)
-			vkDestroyPipelineLayout(inst.get_device(), pipe_layout_, nullptr);
+		deletion.push(pipe_);
+		deletion.push(pipe_layout_);
 
 		for (uint32_t i {0}; i < desc_set_layouts_.size(); ++i)
-		{
-			vkDestroyDescriptorSetLayout(inst.get_device(), desc_set_layouts_[i],
-			                             nullptr);
-		}
+			deletion.push(desc_set_layouts_[i]);
 	}
 
 	bool material::create_pipeline_state()
@@ -337,7 +332,7 @@ namespace vkb::vk
 		// TODO either hardcode it, like vertex input, either retrieve it from slang
 		// reflection
 		VkPushConstantRange cst_range {};
-		cst_range.size = sizeof(mat4);
+		cst_range.size = sizeof(draw_constants);
 		cst_range.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
 
 		VkPipelineLayoutCreateInfo pipe_layout_info {};
@@ -412,28 +407,9 @@ namespace vkb::vk
 		}
 
 		// TODO explore batch/instantiated rendering
-		VkVertexInputBindingDescription input_binding {};
-		input_binding.binding = 0;
-		input_binding.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
-		input_binding.stride = sizeof(model::vert);
-
-		// TODO hardcode this in a better place, to use it more globally
-		// TODO use pos/normal/uv format when importing models
-		mc::array<VkVertexInputAttributeDescription, 3> input_attributes;
-		input_attributes[0].binding = 0;
-		input_attributes[0].location = 0;
-		input_attributes[0].format = VK_FORMAT_R32G32B32A32_SFLOAT;
-		input_attributes[0].offset = offsetof(model::vert, pos);
-
-		input_attributes[1].binding = 0;
-		input_attributes[1].location = 1;
-		input_attributes[1].format = VK_FORMAT_R32G32B32A32_SFLOAT;
-		input_attributes[1].offset = offsetof(model::vert, col);
-
-		input_attributes[2].binding = 0;
-		input_attributes[2].location = 2;
-		input_attributes[2].format = VK_FORMAT_R32G32_SFLOAT;
-		input_attributes[2].offset = offsetof(model::vert, uv);
+		VkVertexInputBindingDescription input_binding = model::binding_desc();
+		mc::array<VkVertexInputAttributeDescription, model::attribute_count>
+			input_attributes = model::attribute_descs();
 
 		VkPipelineVertexInputStateCreateInfo vert_input_info {};
 		vert_input_info.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "../math/mat4.hh"
+#include "../math/vec4.hh"
 #include "material_layout.hh"
 
 #include <string.hh>
@@ -14,6 +16,16 @@ namespace vkb::vk
 	class material
 	{
 	public:
+		// Vertex stage push constants, the `model` and `bounds` parameters of the
+		// shaders' v_main
+		struct draw_constants
+		{
+			mat4 model;
+			// Dequantization of the drawn model's positions, as mesh::quant_bounds
+			vec4 bounds_center;
+			vec4 bounds_extent;
+		};
+
 		material(mc::string_view shader);
 		~material();
 
@@ -3,11 +3,11 @@
 #include "../../cam/base.hh"
 #include "../../log.hh"
 #include "../../math/mat4.hh"
-#include "../../math/math.hh"
 #include "../assets/model.hh"
 #include "../assets/texture.hh"
 #include "../enum_string_helper.hh"
 #include "../instance.hh"
+#include "../staging_ring.hh"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -69,18 +69,11 @@ namespace vkb::vk
 			{
 				constexpr uint32_t set_size {sizeof(mat4) * 2 + 16};
 				dynamic_sets_[i] = sets[i];
-				staging_uniforms_[i] =
-					inst.create_buffer(set_size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-				                       VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-				                           VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-
-				uniforms_[i] = inst.create_buffer(set_size,
-				                                  VK_BUFFER_USAGE_TRANSFER_DST_BIT |
-				                                      VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-				                                  VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+				uniforms_[i] = inst.create_dynamic_buffer(
+					set_size, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT);
 
 				VkDescriptorBufferInfo buf_info {};
-				buf_info.buffer = uniforms_[i].buffer;
+				buf_info.buffer = uniforms_[i].device.buffer;
 				buf_info.offset = 0;
 				buf_info.range = set_size;
 
@@ -269,24 +262,6 @@ namespace vkb::vk
 
 			constexpr uint16_t indices[] {0, 1, 0, 2, 0, 3};
 
-			buffer vertices_staging =
-				inst.create_buffer(sizeof(vertices), VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-			                       VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-			                           VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-			buffer indices_staging =
-				inst.create_buffer(sizeof(indices), VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-			                       VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-			                           VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-
-			void* buf_mem;
-			vmaMapMemory(inst.get_allocator(), vertices_staging.memory, &buf_mem);
-			memcpy(buf_mem, &vertices, sizeof(vertices));
-			vmaUnmapMemory(inst.get_allocator(), vertices_staging.memory);
-
-			vmaMapMemory(inst.get_allocator(), indices_staging.memory, &buf_mem);
-			memcpy(buf_mem, &indices, sizeof(indices));
-			vmaUnmapMemory(inst.get_allocator(), indices_staging.memory);
-
 			vertices_ = inst.create_buffer(sizeof(vertices),
 			                               VK_BUFFER_USAGE_TRANSFER_DST_BIT |
 			                                   VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
@@ -297,49 +272,28 @@ namespace vkb::vk
 			                                  VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
 			                              VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
 
-			VkCommandBuffer cmd = inst.begin_commands();
-
-			VkBufferCopy2 region {};
-			region.sType = VK_STRUCTURE_TYPE_BUFFER_COPY_2;
-			region.size = sizeof(vertices);
-			VkCopyBufferInfo2 copy {};
-			copy.sType = VK_STRUCTURE_TYPE_COPY_BUFFER_INFO_2;
-			copy.srcBuffer = vertices_staging.buffer;
-			copy.dstBuffer = vertices_.buffer;
-			copy.regionCount = 1;
-			copy.pRegions = &region;
-			vkCmdCopyBuffer2(cmd, &copy);
-
-			region.size = sizeof(indices);
-			copy.srcBuffer = indices_staging.buffer;
-			copy.dstBuffer = indices_.buffer;
-			vkCmdCopyBuffer2(cmd, &copy);
-
-			inst.end_commands(cmd);
-
-			inst.destroy_buffer(vertices_staging);
-			inst.destroy_buffer(indices_staging);
+			staging_ring& staging = inst.get_staging();
+			staging.upload_buffer(vertices_, 0, &vertices, sizeof(vertices));
+			staging.upload_buffer(indices_, 0, &indices, sizeof(indices));
+			staging.flush();
 		}
 	}
 
 	coordinates::~coordinates()
 	{
-		instance& inst = instance::get();
+		deletion_queue& deletion = instance::get().get_deletion_queue();
 
-		inst.destroy_buffer(indices_);
-		inst.destroy_buffer(vertices_);
+		deletion.push(indices_);
+		deletion.push(vertices_);
 
-		vkDestroyPipeline(inst.get_device(), pipe_, nullptr);
-		vkDestroyPipelineLayout(inst.get_device(), pipe_layout_, nullptr);
+		deletion.push(pipe_);
+		deletion.push(pipe_layout_);
 
 		for (uint32_t i {0}; i < 3; ++i)
-		{
-			inst.destroy_buffer(staging_uniforms_[i]);
-			inst.destroy_buffer(uniforms_[i]);
-		}
+			deletion.push(uniforms_[i]);
 
-		vkDestroyDescriptorPool(inst.get_device(), desc_pool_, nullptr);
-		vkDestroyDescriptorSetLayout(inst.get_device(), dynamic_set_layout_, nullptr);
+		deletion.push(desc_pool_);
+		deletion.push(dynamic_set_layout_);
 	}
 
 	void coordinates::prepare_draw(VkCommandBuffer cmd, uint32_t const img_idx,
@@ -356,31 +310,9 @@ namespace vkb::vk
 
 		set_data data {cam.rot_mat(), proj, translate};
 
-		void* buf_mem;
-		vmaMapMemory(inst.get_allocator(), staging_uniforms_[img_idx].memory, &buf_mem);
-		memcpy(buf_mem, &data, sizeof(set_data));
-		vmaUnmapMemory(inst.get_allocator(), staging_uniforms_[img_idx].memory);
-
-		VkBufferCopy2 region {};
-		region.sType = VK_STRUCTURE_TYPE_BUFFER_COPY_2;
-		region.size = sizeof(set_data);
-		VkCopyBufferInfo2 copy {};
-		copy.sType = VK_STRUCTURE_TYPE_COPY_BUFFER_INFO_2;
-		copy.srcBuffer = staging_uniforms_[img_idx].buffer;
-		copy.dstBuffer = uniforms_[img_idx].buffer;
-		copy.regionCount = 1;
-		copy.pRegions = &region;
-		vkCmdCopyBuffer2(cmd, &copy);
-
-		VkBufferMemoryBarrier barrier {};
-		barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
-		barrier.buffer = uniforms_[img_idx].buffer;
-		barrier.size = sizeof(set_data);
-		barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-		barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-		vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT,
-		                     VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, 0, 0, nullptr, 1,
-		                     &barrier, 0, nullptr);
+		inst.update_dynamic_buffer(cmd, uniforms_[img_idx], &data, sizeof(set_data),
+		                           VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
+		                           VK_ACCESS_UNIFORM_READ_BIT);
 	}
 
 	void coordinates::draw(VkCommandBuffer cmd, uint32_t const img_idx)
@@ -38,8 +38,7 @@ namespace vkb::vk
 		VkDescriptorPool desc_pool_ {nullptr};
 
 		VkDescriptorSet dynamic_sets_[3] {nullptr};
-		buffer          staging_uniforms_[3];
-		buffer          uniforms_[3];
+		dynamic_buffer  uniforms_[3];
 
 		VkPipelineLayout pipe_layout_ {nullptr};
 		VkPipeline       pipe_ {nullptr};
@@ -0,0 +1,846 @@
+#include "gpu_driven.hh"
+
+#include "../../cam/base.hh"
+#include "../../log.hh"
+#include "../assets/model.hh"
+#include "../assets/texture.hh"
+#include "../enum_string_helper.hh"
+#include "../geometry_arena.hh"
+#include "../instance.hh"
+#include "../staging_ring.hh"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace vkb::vk
+{
+	namespace
+	{
+		struct alignas(16) cull_uniform
+		{
+			mat4     view;
+			mat4     view_proj;
+			vec4     eye;
+			uint32_t object_count;
+			// Projected LOD errors, in multiples of the threshold, at distance 1
+			float    lod_scale;
+			uint32_t max_batches;
+			uint32_t max_draws;
+		};
+
+		struct alignas(16) cam_uniform
+		{
+			mat4 view;
+			mat4 proj;
+		};
+
+		VkShaderModule load_shader(char const* path)
+		{
+			uint32_t* shader_buf {nullptr};
+			uint32_t  shader_size {0};
+			FILE*     shader_file {fopen(path, "rb")};
+
+			log::assert(shader_file, "Failed to open %s", path);
+
+			fseek(shader_file, 0, SEEK_END);
+			shader_size = ftell(shader_file);
+
+			fseek(shader_file, 0, SEEK_SET);
+			shader_buf = new uint32_t[shader_size / 4];
+			fread(shader_buf, shader_size, 1, shader_file);
+			fclose(shader_file);
+
+			VkShaderModule           shader;
+			VkShaderModuleCreateInfo shader_create_info {};
+			shader_create_info.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+			shader_create_info.codeSize = shader_size;
+			shader_create_info.pCode = shader_buf;
+			VkResult res = vkCreateShaderModule(instance::get().get_device(),
+			                                    &shader_create_info, nullptr, &shader);
+
+			delete[] shader_buf;
+			log::assert(res == VK_SUCCESS, "Failed to create shader module (%s)",
+			            string_VkResult(res));
+
+			return shader;
+		}
+
+		VkDescriptorSetLayoutBinding make_binding(uint32_t binding, VkDescriptorType type,
+		                                          VkShaderStageFlags stages)
+		{
+			VkDescriptorSetLayoutBinding layout_binding {};
+			layout_binding.binding = binding;
+			layout_binding.descriptorType = type;
+			layout_binding.descriptorCount = 1;
+			layout_binding.stageFlags = stages;
+			return layout_binding;
+		}
+
+		void write_buffer(VkDescriptorSet set, uint32_t binding, VkDescriptorType type,
+		                  VkBuffer buf, VkDeviceSize range)
+		{
+			VkDescriptorBufferInfo buf_info {};
+			buf_info.buffer = buf;
+			buf_info.offset = 0;
+			buf_info.range = range;
+
+			VkWriteDescriptorSet write {};
+			write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+			write.dstSet = set;
+			write.dstBinding = binding;
+			write.dstArrayElement = 0;
+			write.descriptorType = type;
+			write.descriptorCount = 1;
+			write.pBufferInfo = &buf_info;
+			vkUpdateDescriptorSets(instance::get().get_device(), 1, &write, 0, nullptr);
+		}
+	}
+
+	gpu_driven::gpu_driven(texture const& tex, geometry_arena const& arena,
+	                       uint32_t max_objects)
+	: arena_ {arena}
+	, max_objects_ {max_objects}
+	{
+		instance& inst = instance::get();
+
+		mesh_shading_ = inst.has_mesh_shader();
+		if (mesh_shading_)
+			draw_stages_ = VK_PIPELINE_STAGE_TASK_SHADER_BIT_EXT |
+			               VK_PIPELINE_STAGE_MESH_SHADER_BIT_EXT;
+
+		objects_.reserve(max_objects_);
+
+		objects_buf_ = inst.create_buffer(
+			sizeof(object_data) * max_objects_,
+			VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+		lods_buf_ = inst.create_buffer(
+			sizeof(lod_data) * max_lods,
+			VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+		meshlets_buf_ = inst.create_buffer(
+			sizeof(meshlet_data) * max_meshlets,
+			VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+		if (mesh_shading_)
+		{
+			meshlet_verts_buf_ = inst.create_buffer(
+				sizeof(uint32_t) * max_meshlets * mesh::max_meshlet_verts,
+				VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+				VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+			meshlet_tris_buf_ = inst.create_buffer(
+				sizeof(uint32_t) * max_meshlets * mesh::max_meshlet_tris,
+				VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+				VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+		}
+
+		for (uint32_t i {0}; i < 3; ++i)
+		{
+			batches_[i] = inst.create_buffer(sizeof(cluster_batch) * max_batches,
+			                                 VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+			                                 VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+			batch_args_[i] = inst.create_buffer(
+				sizeof(VkDispatchIndirectCommand),
+				VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT |
+					VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+				VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+			draws_[i] = inst.create_buffer(
+				sizeof(VkDrawIndexedIndirectCommand) * max_draws,
+				VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+				VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+			draw_count_[i] = inst.create_buffer(
+				sizeof(uint32_t),
+				VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT |
+					VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+				VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+			cull_uniforms_[i] = inst.create_dynamic_buffer(
+				sizeof(cull_uniform), VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT);
+			uniforms_[i] = inst.create_dynamic_buffer(sizeof(cam_uniform),
+			                                          VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT);
+		}
+
+		create_descriptors(tex);
+		create_cull_pipeline();
+		create_draw_pipeline();
+	}
+
+	gpu_driven::~gpu_driven()
+	{
+		deletion_queue& deletion = instance::get().get_deletion_queue();
+
+		deletion.push(pipe_);
+		deletion.push(pipe_layout_);
+		deletion.push(cluster_pipe_);
+		deletion.push(cull_pipe_);
+		deletion.push(cull_pipe_layout_);
+
+		for (uint32_t i {0}; i < 3; ++i)
+		{
+			deletion.push(uniforms_[i]);
+			deletion.push(cull_uniforms_[i]);
+			deletion.push(draw_count_[i]);
+			deletion.push(draws_[i]);
+			deletion.push(batch_args_[i]);
+			deletion.push(batches_[i]);
+		}
+
+		if (mesh_shading_)
+		{
+			deletion.push(meshlet_tris_buf_);
+			deletion.push(meshlet_verts_buf_);
+		}
+		deletion.push(meshlets_buf_);
+		deletion.push(lods_buf_);
+		deletion.push(objects_buf_);
+
+		deletion.push(desc_pool_);
+		if (mesh_shading_)
+			deletion.push(mesh_set_layout_);
+		deletion.push(dynamic_set_layout_);
+		deletion.push(static_set_layout_);
+		deletion.push(cull_set_layout_);
+	}
+
+	uint32_t gpu_driven::add_lod(model const& mdl)
+	{
+		log::assert(mdl.arena_ == &arena_, "LOD mesh is not in the renderer's arena");
+		log::assert(lods_.size() < max_lods, "Too many LODs (max %u)", max_lods);
+
+		geometry_arena::mesh_range const& range = arena_.get_range(mdl.mesh_);
+
+		lod_data lod {};
+		lod.index_count = range.index_count;
+		lod.first_index = range.first_index;
+		lod.vertex_offset = static_cast<int32_t>(range.vertex_offset);
+		lod.error = mdl.error_;
+
+		mesh::meshlet_set const& meshlets = mdl.meshlets_;
+		log::assert(meshlets.meshlets.size() > 0, "LOD mesh has no meshlets");
+		log::assert(meshlet_count_ + meshlets.meshlets.size() <= max_meshlets,
+		            "Too many meshlets (max %u)", max_meshlets);
+
+		lod.first_meshlet = meshlet_count_;
+		lod.meshlet_count = meshlets.meshlets.size();
+		lod.meshlet_vert_base = meshlet_vert_count_;
+		lod.meshlet_tri_base = meshlet_tri_count_;
+
+		mc::vector<meshlet_data> data;
+		data.reserve(meshlets.meshlets.size());
+		for (uint32_t i {0}; i < meshlets.meshlets.size(); ++i)
+		{
+			mesh::meshlet const&        m = meshlets.meshlets[i];
+			mesh::meshlet_bounds const& b = meshlets.bounds[i];
+
+			meshlet_data d {};
+			d.first_vert = m.first_vert;
+			d.vert_count = m.vert_count;
+			d.first_tri = m.first_tri;
+			d.tri_count = m.tri_count;
+			d.sphere = {b.center[0], b.center[1], b.center[2], b.radius};
+			d.cone = {b.cone_axis[0], b.cone_axis[1], b.cone_axis[2], b.cone_cutoff};
+			data.emplace_back(d);
+		}
+
+		staging_ring& staging = instance::get().get_staging();
+		staging.upload_buffer(meshlets_buf_, sizeof(meshlet_data) * meshlet_count_,
+		                      data.data(), sizeof(meshlet_data) * data.size());
+		meshlet_count_ += data.size();
+
+		// Every meshlet fits the mesh shader buffers, sized for full meshlets
+		if (mesh_shading_)
+		{
+			staging.upload_buffer(meshlet_verts_buf_,
+			                      sizeof(uint32_t) * meshlet_vert_count_,
+			                      meshlets.verts.data(),
+			                      sizeof(uint32_t) * meshlets.verts.size());
+			staging.upload_buffer(meshlet_tris_buf_,
+			                      sizeof(uint32_t) * meshlet_tri_count_,
+			                      meshlets.tris.data(),
+			                      sizeof(uint32_t) * meshlets.tris.size());
+		}
+		meshlet_vert_count_ += meshlets.verts.size();
+		meshlet_tri_count_ += meshlets.tris.size();
+
+		staging.flush();
+
+		lods_.emplace_back(lod);
+		lod_meshes_.emplace_back(mdl.mesh_);
+		lod_bounds_.emplace_back(mdl.bounds_);
+		lods_dirty_ = true;
+
+		return lods_.size() - 1;
+	}
+
+	uint32_t gpu_driven::add_object(xform const& transform, vec4 sphere,
+	                                uint32_t first_lod, uint32_t lod_count)
+	{
+		log::assert(objects_.size() < max_objects_, "Too many objects (max %u)",
+		            max_objects_);
+		log::assert(lod_count > 0 && first_lod + lod_count <= lods_.size(),
+		            "Invalid LOD range [%u, %u)", first_lod, first_lod + lod_count);
+
+		// Vertices are dequantized per object
+		mesh::quant_bounds const& b = lod_bounds_[first_lod];
+		for (uint32_t i {1}; i < lod_count; ++i)
+		{
+			log::assert(memcmp(&lod_bounds_[first_lod + i], &b, sizeof(b)) == 0,
+			            "LODs [%u, %u) were not quantized in the same bounds", first_lod,
+			            first_lod + lod_count);
+		}
+
+		object_data obj {};
+		obj.transform = transform;
+		obj.sphere = sphere;
+		obj.bounds_center = {b.center[0], b.center[1], b.center[2], 0.f};
+		obj.bounds_extent = {b.extent[0], b.extent[1], b.extent[2], 0.f};
+		obj.first_lod = first_lod;
+		obj.lod_count = lod_count;
+		objects_.emplace_back(obj);
+		dirty_objects_.emplace_back(objects_.size() - 1);
+
+		return objects_.size() - 1;
+	}
+
+	void gpu_driven::set_transform(uint32_t object, xform const& transform)
+	{
+		log::assert(object < objects_.size(), "Invalid object %u", object);
+
+		objects_[object].transform = transform;
+		dirty_objects_.emplace_back(object);
+	}
+
+	void gpu_driven::set_max_lod_error(float pixels)
+	{
+		log::assert(pixels > 0.f, "LOD error threshold must be positive");
+		max_lod_error_px_ = pixels;
+	}
+
+	void gpu_driven::cull(VkCommandBuffer cmd, uint32_t const img_idx,
+	                      cam::base const& cam, mat4 const& proj,
+	                      uint32_t viewport_height)
+	{
+		instance& inst = instance::get();
+
+		// The arena moves meshes when it compacts
+		for (uint32_t i {0}; i < lods_.size(); ++i)
+		{
+			geometry_arena::mesh_range const& range = arena_.get_range(lod_meshes_[i]);
+			if (lods_[i].first_index != range.first_index ||
+			    lods_[i].vertex_offset != static_cast<int32_t>(range.vertex_offset))
+			{
+				lods_[i].first_index = range.first_index;
+				lods_[i].vertex_offset = static_cast<int32_t>(range.vertex_offset);
+				lods_dirty_ = true;
+			}
+		}
+
+		// Previous frames may still read the buffers updated below
+		vkCmdPipelineBarrier(cmd,
+		                     VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT |
+		                         VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | draw_stages_,
+		                     VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 0,
+		                     nullptr);
+
+		// Only modified objects cross the bus
+		for (uint32_t object : dirty_objects_)
+			vkCmdUpdateBuffer(cmd, objects_buf_.buffer, sizeof(object_data) * object,
+			                  sizeof(object_data), &objects_[object]);
+		dirty_objects_.clear();
+
+		if (lods_dirty_)
+		{
+			vkCmdUpdateBuffer(cmd, lods_buf_.buffer, 0, sizeof(lod_data) * lods_.size(),
+			                  lods_.data());
+			lods_dirty_ = false;
+		}
+
+		VkDispatchIndirectCommand const no_batches {0, 1, 1};
+		vkCmdUpdateBuffer(cmd, batch_args_[img_idx].buffer, 0, sizeof(no_batches),
+		                  &no_batches);
+		vkCmdFillBuffer(cmd, draw_count_[img_idx].buffer, 0, sizeof(uint32_t), 0);
+
+		VkMemoryBarrier barrier {};
+		barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+		barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT |
+		                        VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+		vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT,
+		                     VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT |
+		                         VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | draw_stages_,
+		                     0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+		cam_uniform cam_data {cam.view_mat(), proj};
+		inst.update_dynamic_buffer(cmd, uniforms_[img_idx], &cam_data, sizeof(cam_data),
+		                           draw_stages_, VK_ACCESS_UNIFORM_READ_BIT);
+
+		// Pixels per unit at distance 1, from the vertical scale of the projection
+		float const  proj_scale = proj[2][1] * viewport_height / 2.f;
+		mat4 const   inv_view = cam.view_mat().inverse();
+		cull_uniform cull_data {cam.view_mat(),
+		                        cam.view_mat() * proj,
+		                        {inv_view[3][0], inv_view[3][1], inv_view[3][2], 1.f},
+		                        static_cast<uint32_t>(objects_.size()),
+		                        proj_scale / max_lod_error_px_,
+		                        max_batches,
+		                        max_draws};
+		inst.update_dynamic_buffer(cmd, cull_uniforms_[img_idx], &cull_data,
+		                           sizeof(cull_data),
+		                           VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | draw_stages_,
+		                           VK_ACCESS_UNIFORM_READ_BIT);
+
+		// The buffers are not movable by defragmentation, only replaced by the arena.
+		// Updating the uniforms waited for the frame which last used this set.
+		if (mesh_shading_ && mesh_generations_[img_idx] != arena_.get_generation())
+		{
+			mesh_generations_[img_idx] = arena_.get_generation();
+			write_buffer(mesh_sets_[img_idx], 4, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+			             arena_.get_vertex_buffer(), VK_WHOLE_SIZE);
+		}
+
+		if (objects_.empty())
+			return;
+
+		VkBindDescriptorSetsInfo set_info {};
+		set_info.sType = VK_STRUCTURE_TYPE_BIND_DESCRIPTOR_SETS_INFO;
+		set_info.descriptorSetCount = 1;
+		set_info.pDescriptorSets = &cull_sets_[img_idx];
+		set_info.layout = cull_pipe_layout_;
+		set_info.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+		vkCmdBindDescriptorSets2(cmd, &set_info);
+
+		// Objects, into batches of meshlets
+		vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, cull_pipe_);
+		vkCmdDispatch(cmd, (objects_.size() + group_size - 1) / group_size, 1, 1);
+
+		barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+		barrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT |
+		                        VK_ACCESS_SHADER_READ_BIT;
+		vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+		                     VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT |
+		                         VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | draw_stages_,
+		                     0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+		// Task shaders cull the meshlets of the batches while drawing
+		if (mesh_shading_)
+			return;
+
+		// Meshlets, into indexed draws
+		vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, cluster_pipe_);
+		vkCmdDispatchIndirect(cmd, batch_args_[img_idx].buffer, 0);
+
+		barrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+		vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+		                     VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, 0, 1, &barrier, 0,
+		                     nullptr, 0, nullptr);
+	}
+
+	void gpu_driven::draw(VkCommandBuffer cmd, uint32_t const img_idx)
+	{
+		if (objects_.empty())
+			return;
+
+		vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipe_);
+
+		VkBindDescriptorSetsInfo set_info {};
+		set_info.sType = VK_STRUCTURE_TYPE_BIND_DESCRIPTOR_SETS_INFO;
+		set_info.layout = pipe_layout_;
+
+		if (mesh_shading_)
+		{
+			VkDescriptorSet sets[3] {static_set_, cull_sets_[img_idx],
+			                         mesh_sets_[img_idx]};
+			set_info.descriptorSetCount = 3;
+			set_info.pDescriptorSets = sets;
+			set_info.stageFlags = VK_SHADER_STAGE_TASK_BIT_EXT |
+			                      VK_SHADER_STAGE_MESH_BIT_EXT |
+			                      VK_SHADER_STAGE_FRAGMENT_BIT;
+			vkCmdBindDescriptorSets2(cmd, &set_info);
+
+			// A task workgroup per batch, the arguments are a dispatch of the batches
+			vkCmdDrawMeshTasksIndirectEXT(cmd, batch_args_[img_idx].buffer, 0, 1,
+			                              sizeof(VkDrawMeshTasksIndirectCommandEXT));
+			return;
+		}
+
+		arena_.bind(cmd);
+
+		VkDescriptorSet sets[2] {static_set_, dynamic_sets_[img_idx]};
+		set_info.descriptorSetCount = 2;
+		set_info.pDescriptorSets = sets;
+		set_info.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+		vkCmdBindDescriptorSets2(cmd, &set_info);
+
+		vkCmdDrawIndexedIndirectCount(cmd, draws_[img_idx].buffer, 0,
+		                              draw_count_[img_idx].buffer, 0, max_draws,
+		                              sizeof(VkDrawIndexedIndirectCommand));
+	}
+
+	void gpu_driven::create_descriptors(texture const& tex)
+	{
+		instance& inst = instance::get();
+		VkResult  res = VK_SUCCESS;
+
+		VkDescriptorType const   ubo = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+		VkDescriptorType const   ssbo = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		VkShaderStageFlags const vertex = VK_SHADER_STAGE_VERTEX_BIT;
+		VkShaderStageFlags const fragment = VK_SHADER_STAGE_FRAGMENT_BIT;
+		VkShaderStageFlags const mesh = VK_SHADER_STAGE_MESH_BIT_EXT;
+		// Task and mesh shaders read the meshlets and the batches
+		VkShaderStageFlags compute = VK_SHADER_STAGE_COMPUTE_BIT;
+		if (mesh_shading_)
+			compute |= VK_SHADER_STAGE_TASK_BIT_EXT | mesh;
+
+		VkDescriptorSetLayoutBinding cull_bindings[] {
+			make_binding(0, ubo, compute),  make_binding(1, ssbo, compute),
+			make_binding(2, ssbo, compute), make_binding(3, ssbo, compute),
+			make_binding(4, ssbo, compute), make_binding(5, ssbo, compute),
+			make_binding(6, ssbo, compute), make_binding(7, ssbo, compute),
+		};
+
+		VkDescriptorSetLayoutCreateInfo layout_info {};
+		layout_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+		layout_info.bindingCount = 8;
+		layout_info.pBindings = cull_bindings;
+
+		res = vkCreateDescriptorSetLayout(inst.get_device(), &layout_info, nullptr,
+		                                  &cull_set_layout_);
+		log::assert(res == VK_SUCCESS, "Failed to create descriptor set layout (%s)",
+		            string_VkResult(res));
+
+		VkDescriptorSetLayoutBinding static_bindings[] {
+			make_binding(0, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, fragment),
+			make_binding(1, VK_DESCRIPTOR_TYPE_SAMPLER, fragment),
+		};
+
+		layout_info.bindingCount = 2;
+		layout_info.pBindings = static_bindings;
+
+		res = vkCreateDescriptorSetLayout(inst.get_device(), &layout_info, nullptr,
+		                                  &static_set_layout_);
+		log::assert(res == VK_SUCCESS, "Failed to create descriptor set layout (%s)",
+		            string_VkResult(res));
+
+		VkDescriptorSetLayoutBinding dynamic_bindings[] {
+			make_binding(0, ubo, vertex),
+			make_binding(1, ssbo, vertex),
+		};
+
+		layout_info.bindingCount = 2;
+		layout_info.pBindings = dynamic_bindings;
+
+		res = vkCreateDescriptorSetLayout(inst.get_device(), &layout_info, nullptr,
+		                                  &dynamic_set_layout_);
+		log::assert(res == VK_SUCCESS, "Failed to create descriptor set layout (%s)",
+		            string_VkResult(res));
+
+		uint32_t set_count {7};
+		if (mesh_shading_)
+		{
+			VkDescriptorSetLayoutBinding mesh_bindings[] {
+				make_binding(0, ubo, mesh),  make_binding(1, ssbo, mesh),
+				make_binding(2, ssbo, mesh), make_binding(3, ssbo, mesh),
+				make_binding(4, ssbo, mesh),
+			};
+
+			layout_info.bindingCount = 5;
+			layout_info.pBindings = mesh_bindings;
+
+			res = vkCreateDescriptorSetLayout(inst.get_device(), &layout_info, nullptr,
+			                                  &mesh_set_layout_);
+			log::assert(res == VK_SUCCESS, "Failed to create descriptor set layout (%s)",
+			            string_VkResult(res));
+
+			set_count = 10;
+		}
+
+		VkDescriptorPoolSize pool_sizes[] = {
+			{VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 9 },
+			{VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 36},
+			{VK_DESCRIPTOR_TYPE_SAMPLER,        1 },
+			{VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,  1 },
+		};
+
+		VkDescriptorPoolCreateInfo pool_info {};
+		pool_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+		pool_info.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+		pool_info.maxSets = 10;
+		pool_info.pPoolSizes = pool_sizes;
+		pool_info.poolSizeCount = 4;
+		res = vkCreateDescriptorPool(inst.get_device(), &pool_info, nullptr, &desc_pool_);
+		log::assert(res == VK_SUCCESS, "Failed to create descriptor pool (%s)",
+		            string_VkResult(res));
+
+		VkDescriptorSetLayout layouts[10] {
+			cull_set_layout_,    cull_set_layout_,    cull_set_layout_,
+			dynamic_set_layout_, dynamic_set_layout_, dynamic_set_layout_,
+			static_set_layout_,  mesh_set_layout_,    mesh_set_layout_,
+			mesh_set_layout_,
+		};
+		VkDescriptorSetAllocateInfo alloc_info {};
+		alloc_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		alloc_info.descriptorPool = desc_pool_;
+		alloc_info.descriptorSetCount = set_count;
+		alloc_info.pSetLayouts = layouts;
+		VkDescriptorSet sets[10];
+		res = vkAllocateDescriptorSets(inst.get_device(), &alloc_info, sets);
+		log::assert(res == VK_SUCCESS, "Failed to create descriptor sets (%s)",
+		            string_VkResult(res));
+
+		VkDeviceSize const objects_size = sizeof(object_data) * max_objects_;
+
+		for (uint32_t i {0}; i < 3; ++i)
+		{
+			cull_sets_[i] = sets[i];
+			write_buffer(cull_sets_[i], 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+			             cull_uniforms_[i].device.buffer, sizeof(cull_uniform));
+			write_buffer(cull_sets_[i], 1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+			             objects_buf_.buffer, objects_size);
+			write_buffer(cull_sets_[i], 2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+			             lods_buf_.buffer, sizeof(lod_data) * max_lods);
+			write_buffer(cull_sets_[i], 3, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+			             meshlets_buf_.buffer, sizeof(meshlet_data) * max_meshlets);
+			write_buffer(cull_sets_[i], 4, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+			             batches_[i].buffer, sizeof(cluster_batch) * max_batches);
+			write_buffer(cull_sets_[i], 5, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+			             batch_args_[i].buffer, sizeof(VkDispatchIndirectCommand));
+			write_buffer(cull_sets_[i], 6, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+			             draws_[i].buffer,
+			             sizeof(VkDrawIndexedIndirectCommand) * max_draws);
+			write_buffer(cull_sets_[i], 7, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+			             draw_count_[i].buffer, sizeof(uint32_t));
+
+			dynamic_sets_[i] = sets[3 + i];
+			write_buffer(dynamic_sets_[i], 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+			             uniforms_[i].device.buffer, sizeof(cam_uniform));
+			write_buffer(dynamic_sets_[i], 1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+			             objects_buf_.buffer, objects_size);
+
+			if (!mesh_shading_)
+				continue;
+
+			// The arena vertex buffer (binding 4) is written by cull
+			mesh_sets_[i] = sets[7 + i];
+			write_buffer(mesh_sets_[i], 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+			             uniforms_[i].device.buffer, sizeof(cam_uniform));
+			write_buffer(mesh_sets_[i], 1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+			             objects_buf_.buffer, objects_size);
+			write_buffer(mesh_sets_[i], 2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+			             meshlet_verts_buf_.buffer, VK_WHOLE_SIZE);
+			write_buffer(mesh_sets_[i], 3, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+			             meshlet_tris_buf_.buffer, VK_WHOLE_SIZE);
+		}
+
+		static_set_ = sets[6];
+
+		VkDescriptorImageInfo img_info {};
+		img_info.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+		img_info.imageView = tex.img_view;
+		img_info.sampler = tex.sampler;
+
+		VkWriteDescriptorSet write_img {};
+		write_img.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		write_img.dstSet = static_set_;
+		write_img.dstBinding = 0;
+		write_img.dstArrayElement = 0;
+		write_img.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+		write_img.descriptorCount = 1;
+		write_img.pImageInfo = &img_info;
+
+		VkWriteDescriptorSet write_sampler {};
+		write_sampler.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		write_sampler.dstSet = static_set_;
+		write_sampler.dstBinding = 1;
+		write_sampler.dstArrayElement = 0;
+		write_sampler.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER;
+		write_sampler.descriptorCount = 1;
+		write_sampler.pImageInfo = &img_info;
+
+		VkWriteDescriptorSet writes[] {write_img, write_sampler};
+		vkUpdateDescriptorSets(inst.get_device(), 2, writes, 0, nullptr);
+	}
+
+	void gpu_driven::create_cull_pipeline()
+	{
+		instance& inst = instance::get();
+
+		VkPipelineLayoutCreateInfo pipe_layout_info {};
+		pipe_layout_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+		pipe_layout_info.setLayoutCount = 1;
+		pipe_layout_info.pSetLayouts = &cull_set_layout_;
+
+		VkResult res = vkCreatePipelineLayout(inst.get_device(), &pipe_layout_info,
+		                                      nullptr, &cull_pipe_layout_);
+		log::assert(res == VK_SUCCESS, "Failed to create pipeline layout (%s)",
+		            string_VkResult(res));
+
+		VkShaderModule shader = load_shader("res/shaders/cull.spv");
+
+		VkComputePipelineCreateInfo create_info {};
+		create_info.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+		create_info.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+		create_info.stage.module = shader;
+		create_info.stage.pName = "c_main";
+		create_info.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+		create_info.layout = cull_pipe_layout_;
+
+		res = vkCreateComputePipelines(inst.get_device(), nullptr, 1, &create_info,
+		                               nullptr, &cull_pipe_);
+		log::assert(res == VK_SUCCESS, "Failed to create compute pipeline (%s)",
+		            string_VkResult(res));
+
+		create_info.stage.pName = "c_clusters";
+		res = vkCreateComputePipelines(inst.get_device(), nullptr, 1, &create_info,
+		                               nullptr, &cluster_pipe_);
+		log::assert(res == VK_SUCCESS, "Failed to create compute pipeline (%s)",
+		            string_VkResult(res));
+
+		vkDestroyShaderModule(inst.get_device(), shader, nullptr);
+	}
+
+	void gpu_driven::create_draw_pipeline()
+	{
+		instance& inst = instance::get();
+
+		// Sets in the order of the shader parameter blocks
+		VkDescriptorSetLayout layouts[3] {static_set_layout_, dynamic_set_layout_};
+		if (mesh_shading_)
+		{
+			layouts[1] = cull_set_layout_;
+			layouts[2] = mesh_set_layout_;
+		}
+
+		VkPipelineLayoutCreateInfo pipe_layout_info {};
+		pipe_layout_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+		pipe_layout_info.setLayoutCount = mesh_shading_ ? 3 : 2;
+		pipe_layout_info.pSetLayouts = layouts;
+
+		VkResult res = vkCreatePipelineLayout(inst.get_device(), &pipe_layout_info,
+		                                      nullptr, &pipe_layout_);
+		log::assert(res == VK_SUCCESS, "Failed to create pipeline layout (%s)",
+		            string_VkResult(res));
+
+		VkShaderModule shader = load_shader(mesh_shading_
+		                                        ? "res/shaders/gpu_driven_mesh.spv"
+		                                        : "res/shaders/gpu_driven.spv");
+
+		VkPipelineShaderStageCreateInfo stages_info[3] {};
+		memset(stages_info, 0, sizeof(stages_info));
+
+		uint32_t stage_count {0};
+		auto     add_stage = [&](char const* name, VkShaderStageFlagBits stage)
+		{
+			VkPipelineShaderStageCreateInfo& info = stages_info[stage_count++];
+			info.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+			info.module = shader;
+			info.pName = name;
+			info.stage = stage;
+		};
+
+		if (mesh_shading_)
+		{
+			add_stage("t_main", VK_SHADER_STAGE_TASK_BIT_EXT);
+			add_stage("m_main", VK_SHADER_STAGE_MESH_BIT_EXT);
+		}
+		else
+			add_stage("v_main", VK_SHADER_STAGE_VERTEX_BIT);
+		add_stage("f_main", VK_SHADER_STAGE_FRAGMENT_BIT);
+
+		VkVertexInputBindingDescription input_binding = model::binding_desc();
+		mc::array<VkVertexInputAttributeDescription, model::attribute_count>
+			input_attributes = model::attribute_descs();
+
+		VkPipelineVertexInputStateCreateInfo vert_input_info {};
+		vert_input_info.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+		vert_input_info.vertexBindingDescriptionCount = 1;
+		vert_input_info.pVertexBindingDescriptions = &input_binding;
+		vert_input_info.vertexAttributeDescriptionCount = input_attributes.size();
+		vert_input_info.pVertexAttributeDescriptions = input_attributes.data();
+
+		VkPipelineInputAssemblyStateCreateInfo input_assembly {};
+		input_assembly.sType =
+			VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+		input_assembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+		VkDynamicState dynamic_states[] {VK_DYNAMIC_STATE_VIEWPORT_WITH_COUNT,
+		                                 VK_DYNAMIC_STATE_SCISSOR_WITH_COUNT};
+		VkPipelineDynamicStateCreateInfo dynamic_state_info {};
+		dynamic_state_info.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+		dynamic_state_info.dynamicStateCount = 2;
+		dynamic_state_info.pDynamicStates = dynamic_states;
+
+		VkPipelineViewportStateCreateInfo viewport_state {};
+		viewport_state.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+
+		VkPipelineRasterizationStateCreateInfo rasterizer {};
+		rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+		rasterizer.depthClampEnable = VK_FALSE;
+		rasterizer.rasterizerDiscardEnable = VK_FALSE;
+		rasterizer.polygonMode = VK_POLYGON_MODE_FILL;
+		rasterizer.lineWidth = 1.f;
+		rasterizer.cullMode = VK_CULL_MODE_BACK_BIT;
+		rasterizer.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+
+		VkPipelineMultisampleStateCreateInfo msaa {};
+		msaa.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+		msaa.sampleShadingEnable = VK_FALSE;
+		msaa.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+		msaa.minSampleShading = 1.f;
+
+		VkPipelineColorBlendAttachmentState color_attachment {};
+		color_attachment.colorWriteMask =
+			VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT |
+			VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+		color_attachment.blendEnable = VK_FALSE;
+
+		VkPipelineColorBlendStateCreateInfo color_blend {};
+		color_blend.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+		color_blend.logicOpEnable = VK_FALSE;
+		color_blend.logicOp = VK_LOGIC_OP_COPY;
+		color_blend.attachmentCount = 1;
+		color_blend.pAttachments = &color_attachment;
+
+		VkPipelineDepthStencilStateCreateInfo depth_stencil {};
+		depth_stencil.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+		depth_stencil.depthTestEnable = VK_TRUE;
+		depth_stencil.depthWriteEnable = VK_TRUE;
+		depth_stencil.depthCompareOp = VK_COMPARE_OP_LESS;
+		depth_stencil.stencilTestEnable = VK_FALSE;
+
+		VkGraphicsPipelineCreateInfo create_info {};
+		create_info.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+		create_info.stageCount = stage_count;
+		create_info.pStages = stages_info;
+		// Mesh shaders generate their primitives
+		if (!mesh_shading_)
+		{
+			create_info.pVertexInputState = &vert_input_info;
+			create_info.pInputAssemblyState = &input_assembly;
+		}
+		create_info.pViewportState = &viewport_state;
+		create_info.pRasterizationState = &rasterizer;
+		create_info.pMultisampleState = &msaa;
+		create_info.pColorBlendState = &color_blend;
+		create_info.pDepthStencilState = &depth_stencil;
+		create_info.pDynamicState = &dynamic_state_info;
+		create_info.layout = pipe_layout_;
+
+		VkPipelineRenderingCreateInfo rendering_info {};
+		rendering_info.sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO;
+		rendering_info.colorAttachmentCount = 1;
+		// TODO use global hardcoded formats
+		VkFormat format = VK_FORMAT_B8G8R8A8_UNORM;
+		rendering_info.pColorAttachmentFormats = &format;
+		rendering_info.depthAttachmentFormat = VK_FORMAT_D32_SFLOAT;
+
+		create_info.pNext = &rendering_info;
+
+		res = vkCreateGraphicsPipelines(inst.get_device(), nullptr, 1, &create_info,
+		                                nullptr, &pipe_);
+		log::assert(res == VK_SUCCESS, "Failed to create graphics pipeline (%s)",
+		            string_VkResult(res));
+
+		vkDestroyShaderModule(inst.get_device(), shader, nullptr);
+	}
+}
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <vector.hh>
+#include <volk/volk.h>
+
+#include "../buffer.hh"
+
+#include "../../math/mat4.hh"
+#include "../../math/vec4.hh"
+#include "../../math/xform.hh"
+#include "../../mesh/quantize.hh"
+
+namespace vkb
+{
+	namespace cam
+	{
+		class base;
+	}
+
+	namespace vk
+	{
+		struct texture;
+		struct model;
+		class geometry_arena;
+	}
+}
+
+namespace vkb::vk
+{
+	// GPU driven counterpart of module. Objects, mesh LODs and their meshlets are stored
+	// in device buffers. A compute pass culls objects against the frustum, selects their
+	// LOD from its projected error and splits its meshlets in batches, whose meshlets
+	// are then culled against the frustum and their normal cone:
+	// - with VK_EXT_mesh_shader, by task shaders launching a mesh workgroup per visible
+	//   meshlet
+	// - otherwise, by a second compute pass writing the index range of each visible
+	//   meshlet as an indirect draw, consumed by a single vkCmdDrawIndexedIndirectCount
+	// CPU cost per frame only depends on the number of modified objects.
+	class gpu_driven
+	{
+	public:
+		gpu_driven(texture const& tex, geometry_arena const& arena, uint32_t max_objects);
+		gpu_driven(gpu_driven const&) = delete;
+		gpu_driven(gpu_driven&&) = delete;
+		~gpu_driven();
+
+		gpu_driven& operator=(gpu_driven const&) = delete;
+		gpu_driven& operator=(gpu_driven&&) = delete;
+
+		// LOD of a mesh of the arena, with the error, meshlets and bounds of the model
+		// (see context::init_model_lods). Waits for the meshlets upload.
+		uint32_t add_lod(model const& mdl);
+		// LODs [first_lod, first_lod + lod_count) are ordered from the most detailed,
+		// the coarsest one whose error projects under the threshold is drawn.
+		// `sphere` is the model space bounding sphere, with its radius in w.
+		uint32_t add_object(xform const& transform, vec4 sphere, uint32_t first_lod,
+		                    uint32_t lod_count);
+		void     set_transform(uint32_t object, xform const& transform);
+		// Screen space error allowed for LODs, 1 pixel by default
+		void     set_max_lod_error(float pixels);
+
+		// Records pending object updates and the culling pass, outside of rendering
+		void cull(VkCommandBuffer cmd, uint32_t const img_idx, cam::base const& cam,
+		          mat4 const& proj, uint32_t viewport_height);
+		void draw(VkCommandBuffer cmd, uint32_t const img_idx);
+
+	private:
+		constexpr static uint32_t max_lods {256};
+		constexpr static uint32_t max_meshlets {1 << 15};
+		// Per frame, batches of up to 64 meshlets of visible objects and draws of visible
+		// meshlets. Culling drops what does not fit.
+		constexpr static uint32_t max_batches {1 << 14};
+		constexpr static uint32_t max_draws {1 << 17};
+		constexpr static uint32_t group_size {64};
+
+		// Layouts match cull.slang
+		struct object_data
+		{
+			xform    transform;
+			vec4     sphere;
+			// Position dequantization, see model::packed_vert
+			vec4     bounds_center;
+			vec4     bounds_extent;
+			uint32_t first_lod {0};
+			uint32_t lod_count {0};
+			uint32_t pad[2] {0};
+		};
+
+		struct lod_data
+		{
+			uint32_t index_count {0};
+			uint32_t first_index {0};
+			int32_t  vertex_offset {0};
+			float    error {0.f};
+			uint32_t first_meshlet {0};
+			uint32_t meshlet_count {0};
+			uint32_t meshlet_vert_base {0};
+			uint32_t meshlet_tri_base {0};
+		};
+
+		struct meshlet_data
+		{
+			uint32_t first_vert {0};
+			uint32_t vert_count {0};
+			uint32_t first_tri {0};
+			uint32_t tri_count {0};
+			vec4     sphere;
+			vec4     cone;
+		};
+
+		struct cluster_batch
+		{
+			uint32_t object {0};
+			uint32_t lod {0};
+			uint32_t first_meshlet {0};
+			uint32_t meshlet_count {0};
+		};
+
+		void create_descriptors(texture const& tex);
+		void create_cull_pipeline();
+		void create_draw_pipeline();
+
+		geometry_arena const& arena_;
+		uint32_t              max_objects_ {0};
+		bool                  mesh_shading_ {false};
+		// Stages reading the buffers updated by cull
+		VkPipelineStageFlags  draw_stages_ {VK_PIPELINE_STAGE_VERTEX_SHADER_BIT};
+
+		mc::vector<object_data> objects_;
+		mc::vector<uint32_t>    dirty_objects_;
+		mc::vector<lod_data>    lods_;
+		mc::vector<uint32_t>    lod_meshes_;
+		// Of the model of each LOD, which the LODs of an object share
+		mc::vector<mesh::quant_bounds> lod_bounds_;
+		bool                           lods_dirty_ {false};
+		float                          max_lod_error_px_ {1.f};
+		uint32_t                       meshlet_count_ {0};
+		uint32_t                       meshlet_vert_count_ {0};
+		uint32_t                       meshlet_tri_count_ {0};
+
+		buffer objects_buf_;
+		buffer lods_buf_;
+		buffer meshlets_buf_;
+		// Only with mesh shading
+		buffer meshlet_verts_buf_;
+		buffer meshlet_tris_buf_;
+		buffer batches_[3];
+		buffer batch_args_[3];
+		buffer draws_[3];
+		buffer draw_count_[3];
+
+		VkDescriptorSetLayout cull_set_layout_ {nullptr};
+		VkDescriptorSetLayout static_set_layout_ {nullptr};
+		VkDescriptorSetLayout dynamic_set_layout_ {nullptr};
+		VkDescriptorSetLayout mesh_set_layout_ {nullptr};
+
+		VkDescriptorPool desc_pool_ {nullptr};
+
+		VkDescriptorSet cull_sets_[3] {nullptr};
+		VkDescriptorSet static_set_ {nullptr};
+		VkDescriptorSet dynamic_sets_[3] {nullptr};
+		VkDescriptorSet mesh_sets_[3] {nullptr};
+		// Arena generation whose vertex buffer is written in mesh_sets_, 0 for none
+		uint32_t        mesh_generations_[3] {0};
+		dynamic_buffer  cull_uniforms_[3];
+		dynamic_buffer  uniforms_[3];
+
+		VkPipelineLayout cull_pipe_layout_ {nullptr};
+		VkPipeline       cull_pipe_ {nullptr};
+		VkPipeline       cluster_pipe_ {nullptr};
+		VkPipelineLayout pipe_layout_ {nullptr};
+		VkPipeline       pipe_ {nullptr};
+	};
+}
@@ -3,10 +3,10 @@
 #include "../../cam/base.hh"
 #include "../../log.hh"
 #include "../../math/mat4.hh"
-#include "../../math/math.hh"
 #include "../assets/model.hh"
 #include "../assets/texture.hh"
 #include "../enum_string_helper.hh"
+#include "../geometry_arena.hh"
 #include "../instance.hh"
 
 #include <stdio.h>
@@ -15,6 +15,16 @@
 
 namespace vkb::vk
 {
+	namespace
+	{
+		// Dequantization of the drawn model's positions, quant_bounds in module.slang
+		struct bounds_constants
+		{
+			vec4 center;
+			vec4 extent;
+		};
+	}
+
 	module::module(texture const& tex)
 	{
 		instance& inst = instance::get();
@@ -47,14 +57,23 @@ namespace vkb::vk
 			log::assert(res == VK_SUCCESS, "Failed to create descriptor set layout (%s)",
 			            string_VkResult(res));
 
-			VkDescriptorSetLayoutBinding dynamic_binding {};
-			dynamic_binding.binding = 0;
-			dynamic_binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-			dynamic_binding.descriptorCount = 1;
-			dynamic_binding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+			VkDescriptorSetLayoutBinding dynamic_cam_binding {};
+			dynamic_cam_binding.binding = 0;
+			dynamic_cam_binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+			dynamic_cam_binding.descriptorCount = 1;
+			dynamic_cam_binding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
 
-			layout_info.bindingCount = 1;
-			layout_info.pBindings = &dynamic_binding;
+			VkDescriptorSetLayoutBinding dynamic_instances_binding {};
+			dynamic_instances_binding.binding = 1;
+			dynamic_instances_binding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+			dynamic_instances_binding.descriptorCount = 1;
+			dynamic_instances_binding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+
+			VkDescriptorSetLayoutBinding dynamic_bindings[] {dynamic_cam_binding,
+			                                                 dynamic_instances_binding};
+
+			layout_info.bindingCount = 2;
+			layout_info.pBindings = dynamic_bindings;
 
 			res = vkCreateDescriptorSetLayout(inst.get_device(), &layout_info, nullptr,
 			                                  &dynamic_set_layout_);
@@ -63,6 +82,7 @@ namespace vkb::vk
 
 			VkDescriptorPoolSize pool_sizes[] = {
 				{VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 3},
+				{VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 3},
 				{VK_DESCRIPTOR_TYPE_SAMPLER,        1},
 				{VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,  1},
 			};
@@ -72,7 +92,7 @@ namespace vkb::vk
 			pool_info.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
 			pool_info.maxSets = 4;
 			pool_info.pPoolSizes = pool_sizes;
-			pool_info.poolSizeCount = 3;
+			pool_info.poolSizeCount = 4;
 			res = vkCreateDescriptorPool(instance::get().get_device(), &pool_info,
 			                             nullptr, &desc_pool_);
 			log::assert(res == VK_SUCCESS, "Failed to create descriptor pool (%s)",
@@ -93,18 +113,11 @@ namespace vkb::vk
 			for (uint32_t i {0}; i < 3; ++i)
 			{
 				dynamic_sets_[i] = sets[i];
-				staging_uniforms_[i] =
-					inst.create_buffer(sizeof(mat4) * 2, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-				                       VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-				                           VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-
-				uniforms_[i] = inst.create_buffer(sizeof(mat4) * 2,
-				                                  VK_BUFFER_USAGE_TRANSFER_DST_BIT |
-				                                      VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-				                                  VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+				uniforms_[i] = inst.create_dynamic_buffer(
+					sizeof(mat4) * 2, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT);
 
 				VkDescriptorBufferInfo buf_info {};
-				buf_info.buffer = uniforms_[i].buffer;
+				buf_info.buffer = uniforms_[i].device.buffer;
 				buf_info.offset = 0;
 				buf_info.range = sizeof(mat4) * 2;
 
@@ -117,6 +130,8 @@ namespace vkb::vk
 				write.descriptorCount = 1;
 				write.pBufferInfo = &buf_info;
 				vkUpdateDescriptorSets(inst.get_device(), 1, &write, 0, nullptr);
+
+				resize_instances(i, initial_instance_capacity);
 			}
 
 			static_set_ = sets[3];
@@ -150,11 +165,12 @@ namespace vkb::vk
 
 		// Pipeline
 		{
+			VkDescriptorSetLayout layouts[] {static_set_layout_, dynamic_set_layout_};
+
 			VkPushConstantRange cst_range {};
-			cst_range.size = sizeof(mat4);
+			cst_range.size = sizeof(bounds_constants);
 			cst_range.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
 
-			VkDescriptorSetLayout layouts[] {static_set_layout_, dynamic_set_layout_};
 			VkPipelineLayoutCreateInfo pipe_layout_info {};
 			pipe_layout_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
 			pipe_layout_info.setLayoutCount = 2;
@@ -206,26 +222,9 @@ namespace vkb::vk
 			stages_info[1].pName = "f_main";
 			stages_info[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
 
-			VkVertexInputBindingDescription input_binding {};
-			input_binding.binding = 0;
-			input_binding.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
-			input_binding.stride = sizeof(model::vert);
-
-			mc::array<VkVertexInputAttributeDescription, 3> input_attributes;
-			input_attributes[0].binding = 0;
-			input_attributes[0].location = 0;
-			input_attributes[0].format = VK_FORMAT_R32G32B32A32_SFLOAT;
-			input_attributes[0].offset = offsetof(model::vert, pos);
-
-			input_attributes[1].binding = 0;
-			input_attributes[1].location = 1;
-			input_attributes[1].format = VK_FORMAT_R32G32B32A32_SFLOAT;
-			input_attributes[1].offset = offsetof(model::vert, col);
-
-			input_attributes[2].binding = 0;
-			input_attributes[2].location = 2;
-			input_attributes[2].format = VK_FORMAT_R32G32_SFLOAT;
-			input_attributes[2].offset = offsetof(model::vert, uv);
+			VkVertexInputBindingDescription input_binding = model::binding_desc();
+			mc::array<VkVertexInputAttributeDescription, model::attribute_count>
+				input_attributes = model::attribute_descs();
 
 			VkPipelineVertexInputStateCreateInfo vert_input_info {};
 			vert_input_info.sType =
@@ -328,24 +327,25 @@ namespace vkb::vk
 
 	module::~module()
 	{
-		instance& inst = instance::get();
+		deletion_queue& deletion = instance::get().get_deletion_queue();
 
-		vkDestroyPipeline(inst.get_device(), pipe_, nullptr);
-		vkDestroyPipelineLayout(inst.get_device(), pipe_layout_, nullptr);
+		deletion.push(pipe_);
+		deletion.push(pipe_layout_);
 
 		for (uint32_t i {0}; i < 3; ++i)
 		{
-			inst.destroy_buffer(staging_uniforms_[i]);
-			inst.destroy_buffer(uniforms_[i]);
+			deletion.push(uniforms_[i]);
+			deletion.push(instances_[i]);
 		}
 
-		vkDestroyDescriptorPool(inst.get_device(), desc_pool_, nullptr);
-		vkDestroyDescriptorSetLayout(inst.get_device(), dynamic_set_layout_, nullptr);
-		vkDestroyDescriptorSetLayout(inst.get_device(), static_set_layout_, nullptr);
+		deletion.push(desc_pool_);
+		deletion.push(dynamic_set_layout_);
+		deletion.push(static_set_layout_);
 	}
 
 	void module::prepare_draw(VkCommandBuffer cmd, uint32_t const img_idx,
-	                          cam::base const& cam, mat4 const& proj)
+	                          cam::base const& cam, mat4 const& proj,
+	                          mc::array_view<xform> models)
 	{
 		instance& inst = instance::get();
 
@@ -357,40 +357,37 @@ namespace vkb::vk
 
 		cam_data data {cam.view_mat(), proj};
 
-		void* buf_mem;
-		vmaMapMemory(inst.get_allocator(), staging_uniforms_[img_idx].memory, &buf_mem);
-		memcpy(buf_mem, &data, sizeof(cam_data));
-		vmaUnmapMemory(inst.get_allocator(), staging_uniforms_[img_idx].memory);
-
-		VkBufferCopy2 region {};
-		region.sType = VK_STRUCTURE_TYPE_BUFFER_COPY_2;
-		region.size = sizeof(cam_data);
-		VkCopyBufferInfo2 copy {};
-		copy.sType = VK_STRUCTURE_TYPE_COPY_BUFFER_INFO_2;
-		copy.srcBuffer = staging_uniforms_[img_idx].buffer;
-		copy.dstBuffer = uniforms_[img_idx].buffer;
-		copy.regionCount = 1;
-		copy.pRegions = &region;
-		vkCmdCopyBuffer2(cmd, &copy);
-
-		VkBufferMemoryBarrier barrier {};
-		barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
-		barrier.buffer = uniforms_[img_idx].buffer;
-		barrier.size = sizeof(cam_data);
-		barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-		barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-		vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT,
-		                     VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, 0, 0, nullptr, 1,
-		                     &barrier, 0, nullptr);
+		inst.update_dynamic_buffer(cmd, uniforms_[img_idx], &data, sizeof(cam_data),
+		                           VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
+		                           VK_ACCESS_UNIFORM_READ_BIT);
+
+		instance_cnt_[img_idx] = models.size();
+		if (models.empty())
+			return;
+
+		if (models.size() > instance_capacity_[img_idx])
+		{
+			uint32_t capacity = instance_capacity_[img_idx] * 2;
+			if (capacity < models.size())
+				capacity = models.size();
+			resize_instances(img_idx, capacity);
+		}
+
+		inst.update_dynamic_buffer(cmd, instances_[img_idx], models.data(),
+		                           sizeof(xform) * models.size(),
+		                           VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
+		                           VK_ACCESS_SHADER_READ_BIT);
 	}
 
-	void module::draw(VkCommandBuffer cmd, uint32_t const img_idx, model const& cube,
-	                  mc::vector<mat4> models)
+	void module::draw(VkCommandBuffer cmd, uint32_t const img_idx, model const& cube)
 	{
+		if (!instance_cnt_[img_idx])
+			return;
+
 		vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipe_);
-		VkDeviceSize offset {0};
-		vkCmdBindVertexBuffers(cmd, 0, 1, &cube.vertex_.buffer, &offset);
-		vkCmdBindIndexBuffer(cmd, cube.index_.buffer, 0, VK_INDEX_TYPE_UINT16);
+		cube.arena_->bind(cmd);
+
+		geometry_arena::mesh_range const& range = cube.arena_->get_range(cube.mesh_);
 
 		VkDescriptorSet sets[2] {static_set_, dynamic_sets_[img_idx]};
 
@@ -402,11 +399,49 @@ namespace vkb::vk
 		set_info.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
 		vkCmdBindDescriptorSets2(cmd, &set_info);
 
-		for (uint32_t i {0}; i < models.size(); ++i)
-		{
-			vkCmdPushConstants(cmd, pipe_layout_, VK_SHADER_STAGE_VERTEX_BIT, 0,
-			                   sizeof(mat4), &models[i]);
-			vkCmdDrawIndexed(cmd, cube.idcs_size_, 1, 0, 0, 0);
-		}
+		mesh::quant_bounds const& b = cube.bounds_;
+		bounds_constants const    bounds {
+			{b.center[0], b.center[1], b.center[2], 0.f},
+			{b.extent[0], b.extent[1], b.extent[2], 0.f},
+		};
+
+		VkPushConstantsInfo cst_info {};
+		cst_info.sType = VK_STRUCTURE_TYPE_PUSH_CONSTANTS_INFO;
+		cst_info.layout = pipe_layout_;
+		cst_info.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+		cst_info.offset = 0;
+		cst_info.size = sizeof(bounds);
+		cst_info.pValues = &bounds;
+		vkCmdPushConstants2(cmd, &cst_info);
+
+		vkCmdDrawIndexed(cmd, range.index_count, instance_cnt_[img_idx],
+		                 range.first_index, static_cast<int32_t>(range.vertex_offset), 0);
+	}
+
+	void module::resize_instances(uint32_t img_idx, uint32_t capacity)
+	{
+		instance& inst = instance::get();
+
+		inst.get_deletion_queue().push(instances_[img_idx]);
+
+		instances_[img_idx] =
+			inst.create_dynamic_buffer(sizeof(xform) * capacity,
+		                               VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+		instance_capacity_[img_idx] = capacity;
+
+		VkDescriptorBufferInfo buf_info {};
+		buf_info.buffer = instances_[img_idx].device.buffer;
+		buf_info.offset = 0;
+		buf_info.range = sizeof(xform) * capacity;
+
+		VkWriteDescriptorSet write {};
+		write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		write.dstSet = dynamic_sets_[img_idx];
+		write.dstBinding = 1;
+		write.dstArrayElement = 0;
+		write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		write.descriptorCount = 1;
+		write.pBufferInfo = &buf_info;
+		vkUpdateDescriptorSets(inst.get_device(), 1, &write, 0, nullptr);
 	}
 } // namespace vkb::vk
\ No newline at end of file
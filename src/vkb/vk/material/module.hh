@@ -1,12 +1,13 @@
 #pragma once
 
-#include <vector.hh>
+#include <array_view.hh>
 #include <volk/volk.h>
 
 #include "../buffer.hh"
 
 #include "../../math/mat4.hh"
 #include "../../math/vec4.hh"
+#include "../../math/xform.hh"
 
 namespace vkb
 {
@@ -35,12 +36,18 @@ namespace vkb::vk
 		module& operator=(module const&) = delete;
 		module& operator=(module&&) = delete;
 
+		// Uploads the transform of every instance drawn this frame
 		void prepare_draw(VkCommandBuffer cmd, uint32_t const img_idx,
-		                  cam::base const& cam, mat4 const& proj);
-		void draw(VkCommandBuffer cmd, uint32_t const img_idx, model const& cube,
-		          mc::vector<mat4> models);
+		                  cam::base const& cam, mat4 const& proj,
+		                  mc::array_view<xform> models);
+		// Draws all instances with a single call
+		void draw(VkCommandBuffer cmd, uint32_t const img_idx, model const& cube);
 
 	private:
+		constexpr static uint32_t initial_instance_capacity {64};
+
+		void resize_instances(uint32_t img_idx, uint32_t capacity);
+
 		VkDescriptorSetLayout static_set_layout_ {nullptr};
 		VkDescriptorSetLayout dynamic_set_layout_ {nullptr};
 
@@ -48,8 +55,10 @@ namespace vkb::vk
 
 		VkDescriptorSet static_set_ {nullptr};
 		VkDescriptorSet dynamic_sets_[3] {nullptr};
-		buffer          staging_uniforms_[3];
-		buffer          uniforms_[3];
+		dynamic_buffer  uniforms_[3];
+		dynamic_buffer  instances_[3];
+		uint32_t        instance_capacity_[3] {0};
+		uint32_t        instance_cnt_[3] {0};
 
 		VkPipelineLayout pipe_layout_ {nullptr};
 		VkPipeline       pipe_ {nullptr};
@@ -3,10 +3,12 @@
 #include "../../cam/base.hh"
 #include "../../log.hh"
 #include "../../math/mat4.hh"
-#include "../../math/math.hh"
-#include "../../sphere.hh"
+#include "../../math/random.hh"
 #include "../enum_string_helper.hh"
 #include "../instance.hh"
+#include "../staging_ring.hh"
+
+#include <vector.hh>
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -14,52 +16,111 @@
 
 namespace vkb::vk
 {
-	sky_sphere::sky_sphere()
+	namespace
 	{
-		instance& inst = instance::get();
-		VkResult  res = VK_SUCCESS;
+		VkShaderModule load_shader(char const* path)
+		{
+			uint32_t* shader_buf {nullptr};
+			uint32_t  shader_size {0};
+			FILE*     shader_file {fopen(path, "rb")};
+
+			log::assert(shader_file, "Failed to open %s", path);
+
+			fseek(shader_file, 0, SEEK_END);
+			shader_size = ftell(shader_file);
 
-		// Descriptor Set
+			fseek(shader_file, 0, SEEK_SET);
+			shader_buf = new uint32_t[shader_size / 4];
+			fread(shader_buf, shader_size, 1, shader_file);
+			fclose(shader_file);
+
+			VkShaderModule           shader;
+			VkShaderModuleCreateInfo shader_create_info {};
+			shader_create_info.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+			shader_create_info.codeSize = shader_size;
+			shader_create_info.pCode = shader_buf;
+			VkResult res = vkCreateShaderModule(instance::get().get_device(),
+			                                    &shader_create_info, nullptr, &shader);
+
+			delete[] shader_buf;
+			log::assert(res == VK_SUCCESS, "Failed to create shader module (%s)",
+			            string_VkResult(res));
+
+			return shader;
+		}
+
+		VkDescriptorSetLayoutBinding make_binding(uint32_t binding, VkDescriptorType type,
+		                                          VkShaderStageFlags stages)
 		{
-			VkDescriptorSetLayoutBinding binding {};
-			binding.binding = 0;
-			binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-			binding.descriptorCount = 1;
-			binding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+			VkDescriptorSetLayoutBinding layout_binding {};
+			layout_binding.binding = binding;
+			layout_binding.descriptorType = type;
+			layout_binding.descriptorCount = 1;
+			layout_binding.stageFlags = stages;
+			return layout_binding;
+		}
 
+		VkDescriptorSetLayout create_set_layout(
+			mc::array_view<VkDescriptorSetLayoutBinding> bindings)
+		{
 			VkDescriptorSetLayoutCreateInfo layout_info {};
 			layout_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-			layout_info.bindingCount = 1;
-			layout_info.pBindings = &binding;
+			layout_info.bindingCount = bindings.size();
+			layout_info.pBindings = bindings.data();
 
-			res = vkCreateDescriptorSetLayout(inst.get_device(), &layout_info, nullptr,
-			                                  &desc_set_layout_);
+			VkDescriptorSetLayout layout {nullptr};
+			VkResult res = vkCreateDescriptorSetLayout(instance::get().get_device(),
+			                                           &layout_info, nullptr, &layout);
 			log::assert(res == VK_SUCCESS, "Failed to create descriptor set layout (%s)",
 			            string_VkResult(res));
 
-			binding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
-			res = vkCreateDescriptorSetLayout(inst.get_device(), &layout_info, nullptr,
-			                                  &star_positions_layout_);
-			log::assert(res == VK_SUCCESS, "Failed to create descriptor set layout (%s)",
-			            string_VkResult(res));
+			return layout;
+		}
+	}
 
+	sky_sphere::sky_sphere()
+	{
+		instance& inst = instance::get();
+		VkResult  res = VK_SUCCESS;
+
+		// Descriptor sets
+		{
+			VkShaderStageFlags const vertex = VK_SHADER_STAGE_VERTEX_BIT;
+			VkShaderStageFlags const fragment = VK_SHADER_STAGE_FRAGMENT_BIT;
+
+			VkDescriptorSetLayoutBinding dynamic_bindings[] {
+				make_binding(0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, vertex),
+			};
+			dynamic_set_layout_ = create_set_layout(dynamic_bindings);
+
+			VkDescriptorSetLayoutBinding static_bindings[] {
+				make_binding(0, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, fragment),
+				make_binding(1, VK_DESCRIPTOR_TYPE_SAMPLER, fragment),
+			};
+			static_set_layout_ = create_set_layout(static_bindings);
+
+			// The bake set is freed once the cubemap is baked
 			VkDescriptorPoolSize pool_sizes[] = {
-				{VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 4}
-            };
+				{VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 3},
+				{VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,  1},
+				{VK_DESCRIPTOR_TYPE_SAMPLER,        1},
+				{VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1},
+				{VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,  1},
+			};
 
 			VkDescriptorPoolCreateInfo pool_info {};
 			pool_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
 			pool_info.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
-			pool_info.maxSets = 4;
+			pool_info.maxSets = 5;
 			pool_info.pPoolSizes = pool_sizes;
-			pool_info.poolSizeCount = 1;
-			res = vkCreateDescriptorPool(instance::get().get_device(), &pool_info,
-			                             nullptr, &desc_pool_);
+			pool_info.poolSizeCount = 5;
+			res = vkCreateDescriptorPool(inst.get_device(), &pool_info, nullptr,
+			                             &desc_pool_);
 			log::assert(res == VK_SUCCESS, "Failed to create descriptor pool (%s)",
 			            string_VkResult(res));
 
-			VkDescriptorSetLayout       layouts[4] {desc_set_layout_, desc_set_layout_,
-			                                        desc_set_layout_, star_positions_layout_};
+			VkDescriptorSetLayout layouts[4] {dynamic_set_layout_, dynamic_set_layout_,
+			                                  dynamic_set_layout_, static_set_layout_};
 			VkDescriptorSetAllocateInfo alloc_info {};
 			alloc_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
 			alloc_info.descriptorPool = desc_pool_;
@@ -72,25 +133,18 @@ namespace vkb::vk
 
 			for (uint32_t i {0}; i < 3; ++i)
 			{
-				desc_sets_[i] = sets[i];
-				staging_uniforms_[i] =
-					inst.create_buffer(sizeof(mat4), VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-				                       VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-				                           VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-
-				uniforms_[i] = inst.create_buffer(sizeof(mat4),
-				                                  VK_BUFFER_USAGE_TRANSFER_DST_BIT |
-				                                      VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-				                                  VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+				dynamic_sets_[i] = sets[i];
+				uniforms_[i] = inst.create_dynamic_buffer(
+					sizeof(mat4), VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT);
 
 				VkDescriptorBufferInfo buf_info {};
-				buf_info.buffer = uniforms_[i].buffer;
+				buf_info.buffer = uniforms_[i].device.buffer;
 				buf_info.offset = 0;
 				buf_info.range = sizeof(mat4);
 
 				VkWriteDescriptorSet write {};
 				write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-				write.dstSet = desc_sets_[i];
+				write.dstSet = dynamic_sets_[i];
 				write.dstBinding = 0;
 				write.dstArrayElement = 0;
 				write.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
@@ -99,345 +153,101 @@ namespace vkb::vk
 				vkUpdateDescriptorSets(inst.get_device(), 1, &write, 0, nullptr);
 			}
 
-			star_positions_set_ = sets[3];
-			constexpr uint32_t star_count = 1000;
-
-			buffer staging = inst.create_buffer(sizeof(star) * star_count,
-			                                    VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-			                                    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-			                                        VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-
-			star_positions_uniform_ = inst.create_buffer(
-				sizeof(star) * star_count,
-				VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-				VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-
-			VkDescriptorBufferInfo buf_info {};
-			buf_info.buffer = star_positions_uniform_.buffer;
-			buf_info.offset = 0;
-			buf_info.range = sizeof(star) * star_count;
-
-			VkWriteDescriptorSet write {};
-			write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-			write.dstSet = star_positions_set_;
-			write.dstBinding = 0;
-			write.dstArrayElement = 0;
-			write.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-			write.descriptorCount = 1;
-			write.pBufferInfo = &buf_info;
-			vkUpdateDescriptorSets(inst.get_device(), 1, &write, 0, nullptr);
-
-			star stars[star_count];
-			for (uint32_t i {0}; i < star_count; ++i)
-			{
-				stars[i].pos = math::generate_sphere_point();
-
-				stars[i].intensity = math::rand() * 0.8 + 0.2;
-			}
-
-			void* buf_mem;
-			vmaMapMemory(inst.get_allocator(), staging.memory, &buf_mem);
-			memcpy(buf_mem, stars, sizeof(stars));
-			vmaUnmapMemory(inst.get_allocator(), staging.memory);
-
-			VkCommandBuffer cmd = inst.begin_commands();
-
-			VkBufferCopy2 region {};
-			region.sType = VK_STRUCTURE_TYPE_BUFFER_COPY_2;
-			region.size = sizeof(stars);
-			VkCopyBufferInfo2 copy {};
-			copy.sType = VK_STRUCTURE_TYPE_COPY_BUFFER_INFO_2;
-			copy.srcBuffer = staging.buffer;
-			copy.dstBuffer = star_positions_uniform_.buffer;
-			copy.regionCount = 1;
-			copy.pRegions = &region;
-			vkCmdCopyBuffer2(cmd, &copy);
-
-			inst.end_commands(cmd);
-
-			inst.destroy_buffer(staging);
+			static_set_ = sets[3];
 		}
 
-		// Pipeline
+		// Cubemap
 		{
-			VkDescriptorSetLayout layouts[] {desc_set_layout_, star_positions_layout_};
-			VkPipelineLayoutCreateInfo pipe_layout_info {};
-			pipe_layout_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-			pipe_layout_info.setLayoutCount = 2;
-			pipe_layout_info.pSetLayouts = layouts;
-
-			res = vkCreatePipelineLayout(inst.get_device(), &pipe_layout_info, nullptr,
-			                             &pipe_layout_);
-			log::assert(res == VK_SUCCESS, "Failed to create pipeline layout (%s)",
+			cubemap_ = inst.create_image(
+				face_size, face_size, 1, VK_FORMAT_R8G8B8A8_UNORM,
+				VK_IMAGE_TILING_OPTIMAL,
+				VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+				VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, 6,
+				VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT);
+
+			cubemap_view_ = inst.create_image_view(
+				cubemap_.image, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_ASPECT_COLOR_BIT, 1,
+				VK_IMAGE_VIEW_TYPE_CUBE, 6);
+
+			VkSamplerCreateInfo sampler {};
+			sampler.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+			sampler.magFilter = VK_FILTER_LINEAR;
+			sampler.minFilter = VK_FILTER_LINEAR;
+			sampler.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+			sampler.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+			sampler.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+			sampler.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+			sampler.minLod = 0.f;
+			sampler.maxLod = 0.f;
+			sampler.borderColor = VK_BORDER_COLOR_FLOAT_OPAQUE_BLACK;
+			sampler.unnormalizedCoordinates = VK_FALSE;
+			sampler.compareEnable = VK_FALSE;
+			sampler.compareOp = VK_COMPARE_OP_ALWAYS;
+
+			res = vkCreateSampler(inst.get_device(), &sampler, nullptr, &sampler_);
+			log::assert(res == VK_SUCCESS, "Failed to create sampler (%s)",
 			            string_VkResult(res));
 
-			VkShaderModule shader;
-			uint32_t*      shader_buf {nullptr};
-			uint32_t       shader_size {0};
-			FILE*          shader_file {fopen("res/shaders/sky_sphere.spv", "rb")};
-
-			log::assert(shader_file, "Failed to open sky_sphere.spv");
-
-			fseek(shader_file, 0, SEEK_END);
-			shader_size = ftell(shader_file);
-
-			fseek(shader_file, 0, SEEK_SET);
-			shader_buf = new uint32_t[shader_size / 4];
-			fread(shader_buf, 1, shader_size, shader_file);
-			fclose(shader_file);
-
-			VkShaderModuleCreateInfo shader_create_info {};
-			shader_create_info.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-			shader_create_info.codeSize = shader_size;
-			shader_create_info.pCode = shader_buf;
-			res = vkCreateShaderModule(instance::get().get_device(), &shader_create_info,
-			                           nullptr, &shader);
-
-			delete[] shader_buf;
-			log::assert(res == VK_SUCCESS, "Failed to create shader module (%s)",
-			            string_VkResult(res));
-
-			VkPipelineShaderStageCreateInfo stages_info[2] {};
-			memset(stages_info, 0, sizeof(stages_info));
-
-			stages_info[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-			stages_info[0].module = shader;
-			stages_info[0].pName = "v_main";
-			stages_info[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
-
-			stages_info[1].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-			stages_info[1].module = shader;
-			stages_info[1].pName = "f_main";
-			stages_info[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
-
-			VkVertexInputBindingDescription input_binding {};
-			input_binding.binding = 0;
-			input_binding.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
-			input_binding.stride = sizeof(vec4);
-
-			VkVertexInputAttributeDescription input_attribute;
-			input_attribute.binding = 0;
-			input_attribute.location = 0;
-			input_attribute.format = VK_FORMAT_R32G32B32A32_SFLOAT;
-			input_attribute.offset = 0;
-
-			VkPipelineVertexInputStateCreateInfo vert_input_info {};
-			vert_input_info.sType =
-				VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-			vert_input_info.vertexBindingDescriptionCount = 1;
-			vert_input_info.pVertexBindingDescriptions = &input_binding;
-			vert_input_info.vertexAttributeDescriptionCount = 1;
-			vert_input_info.pVertexAttributeDescriptions = &input_attribute;
-
-			VkPipelineInputAssemblyStateCreateInfo input_assembly {};
-			input_assembly.sType =
-				VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
-			input_assembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
-
-			// TODO explore more dynamic states to limit PSOs
-			VkDynamicState dynamic_states[] {VK_DYNAMIC_STATE_VIEWPORT_WITH_COUNT,
-			                                 VK_DYNAMIC_STATE_SCISSOR_WITH_COUNT};
-			VkPipelineDynamicStateCreateInfo dynamic_state_info {};
-			dynamic_state_info.sType =
-				VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
-			dynamic_state_info.dynamicStateCount = 2;
-			dynamic_state_info.pDynamicStates = dynamic_states;
-
-			VkPipelineViewportStateCreateInfo viewport_state {};
-			viewport_state.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
-
-			VkPipelineRasterizationStateCreateInfo rasterizer {};
-			rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
-			rasterizer.depthClampEnable = VK_FALSE;
-			rasterizer.rasterizerDiscardEnable = VK_FALSE;
-			rasterizer.polygonMode = VK_POLYGON_MODE_FILL;
-			rasterizer.lineWidth = 1.f;
-			rasterizer.cullMode = VK_CULL_MODE_FRONT_BIT;
-			rasterizer.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
-
-			VkPipelineMultisampleStateCreateInfo msaa {};
-			msaa.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
-			msaa.sampleShadingEnable = VK_FALSE;
-			msaa.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
-			msaa.minSampleShading = 1.f;
-			msaa.pSampleMask = nullptr;
-			msaa.alphaToCoverageEnable = VK_FALSE;
-			msaa.alphaToOneEnable = VK_FALSE;
-
-			VkPipelineColorBlendAttachmentState color_attachment {};
-			color_attachment.colorWriteMask =
-				VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT |
-				VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
-			color_attachment.blendEnable = VK_FALSE;
-
-			VkPipelineColorBlendStateCreateInfo color_blend {};
-			color_blend.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
-			color_blend.logicOpEnable = VK_FALSE;
-			color_blend.logicOp = VK_LOGIC_OP_COPY;
-			color_blend.attachmentCount = 1;
-			color_blend.pAttachments = &color_attachment;
-
-			VkPipelineDepthStencilStateCreateInfo depth_stencil {};
-			depth_stencil.sType =
-				VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
-			depth_stencil.depthTestEnable = VK_FALSE;
-			depth_stencil.depthWriteEnable = VK_FALSE;
-			depth_stencil.depthCompareOp = VK_COMPARE_OP_LESS;
-			depth_stencil.stencilTestEnable = VK_FALSE;
-
-			VkGraphicsPipelineCreateInfo create_info {};
-			create_info.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
-			create_info.stageCount = 2;
-			create_info.pStages = stages_info;
-			create_info.pVertexInputState = &vert_input_info;
-			create_info.pInputAssemblyState = &input_assembly;
-			create_info.pViewportState = &viewport_state;
-			create_info.pRasterizationState = &rasterizer;
-			create_info.pMultisampleState = &msaa;
-			create_info.pColorBlendState = &color_blend;
-			create_info.pDepthStencilState = &depth_stencil;
-			create_info.pDynamicState = &dynamic_state_info;
-			create_info.layout = pipe_layout_;
-			create_info.renderPass = nullptr;
-			create_info.subpass = 0;
-
-			VkPipelineRenderingCreateInfo rendering_info {};
-			rendering_info.sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO;
-			rendering_info.colorAttachmentCount = 1;
-			// TODO use global hardcoded formats
-			VkFormat format = VK_FORMAT_B8G8R8A8_UNORM;
-			rendering_info.pColorAttachmentFormats = &format;
-			rendering_info.depthAttachmentFormat = VK_FORMAT_D32_SFLOAT;
-
-			create_info.pNext = &rendering_info;
-
-			res = vkCreateGraphicsPipelines(inst.get_device(), nullptr, 1, &create_info,
-			                                nullptr, &pipe_);
-			log::assert(res == VK_SUCCESS, "Failed to create graphics pipeline (%s)",
-			            string_VkResult(res));
-
-			vkDestroyShaderModule(inst.get_device(), shader, nullptr);
+			VkDescriptorImageInfo img_info {};
+			img_info.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+			img_info.imageView = cubemap_view_;
+			img_info.sampler = sampler_;
+
+			VkWriteDescriptorSet writes[2] {};
+			writes[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+			writes[0].dstSet = static_set_;
+			writes[0].dstBinding = 0;
+			writes[0].dstArrayElement = 0;
+			writes[0].descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+			writes[0].descriptorCount = 1;
+			writes[0].pImageInfo = &img_info;
+
+			writes[1] = writes[0];
+			writes[1].dstBinding = 1;
+			writes[1].descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER;
+			vkUpdateDescriptorSets(inst.get_device(), 2, writes, 0, nullptr);
 		}
 
-		// Model
-		{
-			buffer vertices_staging = inst.create_buffer(
-				sizeof(sphere_vertices), VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-				VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-					VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-			buffer indices_staging = inst.create_buffer(
-				sizeof(sphere_indices), VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-				VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-					VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-
-			void* buf_mem;
-			vmaMapMemory(inst.get_allocator(), vertices_staging.memory, &buf_mem);
-			memcpy(buf_mem, &sphere_vertices, sizeof(sphere_vertices));
-			vmaUnmapMemory(inst.get_allocator(), vertices_staging.memory);
-
-			vmaMapMemory(inst.get_allocator(), indices_staging.memory, &buf_mem);
-			memcpy(buf_mem, &sphere_indices, sizeof(sphere_indices));
-			vmaUnmapMemory(inst.get_allocator(), indices_staging.memory);
-
-			vertices_ = inst.create_buffer(sizeof(sphere_vertices),
-			                               VK_BUFFER_USAGE_TRANSFER_DST_BIT |
-			                                   VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
-			                               VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-
-			indices_ = inst.create_buffer(sizeof(sphere_indices),
-			                              VK_BUFFER_USAGE_TRANSFER_DST_BIT |
-			                                  VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
-			                              VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-
-			VkCommandBuffer cmd = inst.begin_commands();
-
-			VkBufferCopy2 region {};
-			region.sType = VK_STRUCTURE_TYPE_BUFFER_COPY_2;
-			region.size = sizeof(sphere_vertices);
-			VkCopyBufferInfo2 copy {};
-			copy.sType = VK_STRUCTURE_TYPE_COPY_BUFFER_INFO_2;
-			copy.srcBuffer = vertices_staging.buffer;
-			copy.dstBuffer = vertices_.buffer;
-			copy.regionCount = 1;
-			copy.pRegions = &region;
-			vkCmdCopyBuffer2(cmd, &copy);
-
-			region.size = sizeof(sphere_indices);
-			copy.srcBuffer = indices_staging.buffer;
-			copy.dstBuffer = indices_.buffer;
-			vkCmdCopyBuffer2(cmd, &copy);
-
-			inst.end_commands(cmd);
-
-			inst.destroy_buffer(vertices_staging);
-			inst.destroy_buffer(indices_staging);
-		}
+		bake_stars();
+		create_pipeline();
 	}
 
 	sky_sphere::~sky_sphere()
 	{
-		instance& inst = instance::get();
-
-		inst.destroy_buffer(indices_);
-		inst.destroy_buffer(vertices_);
+		deletion_queue& deletion = instance::get().get_deletion_queue();
 
-		vkDestroyPipeline(inst.get_device(), pipe_, nullptr);
-		vkDestroyPipelineLayout(inst.get_device(), pipe_layout_, nullptr);
+		deletion.push(pipe_);
+		deletion.push(pipe_layout_);
 
-		inst.destroy_buffer(star_positions_uniform_);
+		deletion.push(sampler_);
+		deletion.push(cubemap_view_);
+		deletion.push(cubemap_);
 
 		for (uint32_t i {0}; i < 3; ++i)
-		{
-			inst.destroy_buffer(staging_uniforms_[i]);
-			inst.destroy_buffer(uniforms_[i]);
-		}
+			deletion.push(uniforms_[i]);
 
-		vkDestroyDescriptorPool(inst.get_device(), desc_pool_, nullptr);
-		vkDestroyDescriptorSetLayout(inst.get_device(), star_positions_layout_, nullptr);
-		vkDestroyDescriptorSetLayout(inst.get_device(), desc_set_layout_, nullptr);
+		deletion.push(desc_pool_);
+		deletion.push(static_set_layout_);
+		deletion.push(dynamic_set_layout_);
 	}
 
 	void sky_sphere::prepare_draw(VkCommandBuffer cmd, uint32_t const img_idx,
 	                              cam::base const& cam, mat4 const& proj)
 	{
 		instance& inst = instance::get();
-		mat4      transform = cam.rot_mat() * proj;
-
-		void* buf_mem;
-		vmaMapMemory(inst.get_allocator(), staging_uniforms_[img_idx].memory, &buf_mem);
-		memcpy(buf_mem, &transform, sizeof(mat4));
-		vmaUnmapMemory(inst.get_allocator(), staging_uniforms_[img_idx].memory);
-
-		VkBufferCopy2 region {};
-		region.sType = VK_STRUCTURE_TYPE_BUFFER_COPY_2;
-		region.size = sizeof(mat4);
-		VkCopyBufferInfo2 copy {};
-		copy.sType = VK_STRUCTURE_TYPE_COPY_BUFFER_INFO_2;
-		copy.srcBuffer = staging_uniforms_[img_idx].buffer;
-		copy.dstBuffer = uniforms_[img_idx].buffer;
-		copy.regionCount = 1;
-		copy.pRegions = &region;
-		vkCmdCopyBuffer2(cmd, &copy);
-
-		VkBufferMemoryBarrier barrier {};
-		barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
-		barrier.buffer = uniforms_[img_idx].buffer;
-		barrier.size = sizeof(mat4);
-		barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-		barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-		vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT,
-		                     VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, 0, 0, nullptr, 1,
-		                     &barrier, 0, nullptr);
+		// Unprojects the far plane to view directions
+		mat4 inv_transform = (cam.rot_mat() * proj).inverse();
+
+		inst.update_dynamic_buffer(cmd, uniforms_[img_idx], &inv_transform, sizeof(mat4),
+		                           VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
+		                           VK_ACCESS_UNIFORM_READ_BIT);
 	}
 
 	void sky_sphere::draw(VkCommandBuffer cmd, uint32_t const img_idx)
 	{
 		vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipe_);
-		VkDeviceSize offset {0};
-		vkCmdBindVertexBuffers(cmd, 0, 1, &vertices_.buffer, &offset);
-		vkCmdBindIndexBuffer(cmd, indices_.buffer, 0, VK_INDEX_TYPE_UINT16);
 
-		VkDescriptorSet sets[2] {desc_sets_[img_idx], star_positions_set_};
+		VkDescriptorSet sets[2] {dynamic_sets_[img_idx], static_set_};
 
 		VkBindDescriptorSetsInfo set_info {};
 		set_info.sType = VK_STRUCTURE_TYPE_BIND_DESCRIPTOR_SETS_INFO;
@@ -447,14 +257,279 @@ namespace vkb::vk
 		set_info.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
 		vkCmdBindDescriptorSets2(cmd, &set_info);
 
-		// VkBindDescriptorSetsInfo star_info {};
-		// star_info.sType = VK_STRUCTURE_TYPE_BIND_DESCRIPTOR_SETS_INFO;
-		// star_info.descriptorSetCount = 1;
-		// star_info.pDescriptorSets = &star_positions_set_;
-		// star_info.layout = pipe_layout_;
-		// star_info.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
-		// vkCmdBindDescriptorSets2(cmd, &star_info);
+		// Fullscreen triangle
+		vkCmdDraw(cmd, 3, 1, 0, 0);
+	}
+
+	void sky_sphere::bake_stars()
+	{
+		instance& inst = instance::get();
+		VkResult  res = VK_SUCCESS;
+
+		math::rng&       gen = math::thread_rng();
+		mc::vector<star> stars;
+		stars.reserve(star_count);
+		for (uint32_t i {0}; i < star_count; ++i)
+		{
+			star& s = stars.emplace_back();
+			s.pos = gen.sphere_point();
+			s.intensity = gen.next_float(0.2f, 1.f);
+		}
+
+		buffer star_buf = inst.create_buffer(
+			sizeof(star) * star_count,
+			VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+		staging_ring& staging = inst.get_staging();
+		staging.upload_buffer(star_buf, 0, stars.data(), sizeof(star) * star_count);
+
+		// Storage images can't be cube views, the faces are written as an array
+		VkImageView storage_view = inst.create_image_view(
+			cubemap_.image, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_ASPECT_COLOR_BIT, 1,
+			VK_IMAGE_VIEW_TYPE_2D_ARRAY, 6);
+
+		VkShaderStageFlags const     compute = VK_SHADER_STAGE_COMPUTE_BIT;
+		VkDescriptorSetLayoutBinding bake_bindings[] {
+			make_binding(0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, compute),
+			make_binding(1, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, compute),
+		};
+		VkDescriptorSetLayout bake_set_layout = create_set_layout(bake_bindings);
+
+		VkDescriptorSetAllocateInfo alloc_info {};
+		alloc_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		alloc_info.descriptorPool = desc_pool_;
+		alloc_info.descriptorSetCount = 1;
+		alloc_info.pSetLayouts = &bake_set_layout;
+		VkDescriptorSet bake_set;
+		res = vkAllocateDescriptorSets(inst.get_device(), &alloc_info, &bake_set);
+		log::assert(res == VK_SUCCESS, "Failed to create descriptor sets (%s)",
+		            string_VkResult(res));
+
+		VkDescriptorBufferInfo buf_info {};
+		buf_info.buffer = star_buf.buffer;
+		buf_info.offset = 0;
+		buf_info.range = sizeof(star) * star_count;
+
+		VkDescriptorImageInfo img_info {};
+		img_info.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+		img_info.imageView = storage_view;
+
+		VkWriteDescriptorSet writes[2] {};
+		writes[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		writes[0].dstSet = bake_set;
+		writes[0].dstBinding = 0;
+		writes[0].dstArrayElement = 0;
+		writes[0].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		writes[0].descriptorCount = 1;
+		writes[0].pBufferInfo = &buf_info;
+
+		writes[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		writes[1].dstSet = bake_set;
+		writes[1].dstBinding = 1;
+		writes[1].dstArrayElement = 0;
+		writes[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+		writes[1].descriptorCount = 1;
+		writes[1].pImageInfo = &img_info;
+		vkUpdateDescriptorSets(inst.get_device(), 2, writes, 0, nullptr);
+
+		VkPipelineLayoutCreateInfo pipe_layout_info {};
+		pipe_layout_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+		pipe_layout_info.setLayoutCount = 1;
+		pipe_layout_info.pSetLayouts = &bake_set_layout;
+
+		VkPipelineLayout bake_pipe_layout;
+		res = vkCreatePipelineLayout(inst.get_device(), &pipe_layout_info, nullptr,
+		                             &bake_pipe_layout);
+		log::assert(res == VK_SUCCESS, "Failed to create pipeline layout (%s)",
+		            string_VkResult(res));
+
+		VkShaderModule shader = load_shader("res/shaders/sky_bake.spv");
+
+		VkComputePipelineCreateInfo create_info {};
+		create_info.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+		create_info.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+		create_info.stage.module = shader;
+		create_info.stage.pName = "c_main";
+		create_info.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+		create_info.layout = bake_pipe_layout;
+
+		VkPipeline bake_pipe;
+		res = vkCreateComputePipelines(inst.get_device(), nullptr, 1, &create_info,
+		                               nullptr, &bake_pipe);
+		log::assert(res == VK_SUCCESS, "Failed to create compute pipeline (%s)",
+		            string_VkResult(res));
+
+		vkDestroyShaderModule(inst.get_device(), shader, nullptr);
+
+		// Recorded after the upload, so that the stars are copied before the dispatch
+		VkCommandBuffer cmd = staging.commands();
+
+		VkMemoryBarrier barrier {};
+		barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+		barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+		vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT,
+		                     VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &barrier, 0,
+		                     nullptr, 0, nullptr);
+
+		inst.transition_image_layout(
+			cmd, cubemap_.image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL, 0,
+			VK_ACCESS_SHADER_WRITE_BIT, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+			VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_IMAGE_ASPECT_COLOR_BIT, 1, 6);
+
+		vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, bake_pipe);
+
+		VkBindDescriptorSetsInfo set_info {};
+		set_info.sType = VK_STRUCTURE_TYPE_BIND_DESCRIPTOR_SETS_INFO;
+		set_info.descriptorSetCount = 1;
+		set_info.pDescriptorSets = &bake_set;
+		set_info.layout = bake_pipe_layout;
+		set_info.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+		vkCmdBindDescriptorSets2(cmd, &set_info);
+
+		// One group per tile of each face
+		vkCmdDispatch(cmd, face_size / bake_tile_size, face_size / bake_tile_size, 6);
+
+		inst.transition_image_layout(
+			cmd, cubemap_.image, VK_IMAGE_LAYOUT_GENERAL,
+			VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_ACCESS_SHADER_WRITE_BIT,
+			VK_ACCESS_SHADER_READ_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+			VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_IMAGE_ASPECT_COLOR_BIT, 1, 6);
+
+		staging.flush();
+
+		vkFreeDescriptorSets(inst.get_device(), desc_pool_, 1, &bake_set);
+
+		deletion_queue& deletion = inst.get_deletion_queue();
+		deletion.push(bake_pipe);
+		deletion.push(bake_pipe_layout);
+		deletion.push(bake_set_layout);
+		deletion.push(storage_view);
+		deletion.push(star_buf);
+	}
+
+	void sky_sphere::create_pipeline()
+	{
+		instance& inst = instance::get();
 
-		vkCmdDrawIndexed(cmd, sizeof(sphere_indices) / sizeof(uint16_t), 1, 0, 0, 0);
+		VkDescriptorSetLayout layouts[] {dynamic_set_layout_, static_set_layout_};
+		VkPipelineLayoutCreateInfo pipe_layout_info {};
+		pipe_layout_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+		pipe_layout_info.setLayoutCount = 2;
+		pipe_layout_info.pSetLayouts = layouts;
+
+		VkResult res = vkCreatePipelineLayout(inst.get_device(), &pipe_layout_info,
+		                                      nullptr, &pipe_layout_);
+		log::assert(res == VK_SUCCESS, "Failed to create pipeline layout (%s)",
+		            string_VkResult(res));
+
+		VkShaderModule shader = load_shader("res/shaders/sky_sphere.spv");
+
+		VkPipelineShaderStageCreateInfo stages_info[2] {};
+		memset(stages_info, 0, sizeof(stages_info));
+
+		stages_info[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+		stages_info[0].module = shader;
+		stages_info[0].pName = "v_main";
+		stages_info[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
+
+		stages_info[1].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+		stages_info[1].module = shader;
+		stages_info[1].pName = "f_main";
+		stages_info[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+
+		// Vertices are generated from their index
+		VkPipelineVertexInputStateCreateInfo vert_input_info {};
+		vert_input_info.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+
+		VkPipelineInputAssemblyStateCreateInfo input_assembly {};
+		input_assembly.sType =
+			VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+		input_assembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+		// TODO explore more dynamic states to limit PSOs
+		VkDynamicState dynamic_states[] {VK_DYNAMIC_STATE_VIEWPORT_WITH_COUNT,
+		                                 VK_DYNAMIC_STATE_SCISSOR_WITH_COUNT};
+		VkPipelineDynamicStateCreateInfo dynamic_state_info {};
+		dynamic_state_info.sType =
+			VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+		dynamic_state_info.dynamicStateCount = 2;
+		dynamic_state_info.pDynamicStates = dynamic_states;
+
+		VkPipelineViewportStateCreateInfo viewport_state {};
+		viewport_state.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+
+		VkPipelineRasterizationStateCreateInfo rasterizer {};
+		rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+		rasterizer.depthClampEnable = VK_FALSE;
+		rasterizer.rasterizerDiscardEnable = VK_FALSE;
+		rasterizer.polygonMode = VK_POLYGON_MODE_FILL;
+		rasterizer.lineWidth = 1.f;
+		rasterizer.cullMode = VK_CULL_MODE_NONE;
+		rasterizer.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+
+		VkPipelineMultisampleStateCreateInfo msaa {};
+		msaa.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+		msaa.sampleShadingEnable = VK_FALSE;
+		msaa.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+		msaa.minSampleShading = 1.f;
+		msaa.pSampleMask = nullptr;
+		msaa.alphaToCoverageEnable = VK_FALSE;
+		msaa.alphaToOneEnable = VK_FALSE;
+
+		VkPipelineColorBlendAttachmentState color_attachment {};
+		color_attachment.colorWriteMask =
+			VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT |
+			VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+		color_attachment.blendEnable = VK_FALSE;
+
+		VkPipelineColorBlendStateCreateInfo color_blend {};
+		color_blend.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+		color_blend.logicOpEnable = VK_FALSE;
+		color_blend.logicOp = VK_LOGIC_OP_COPY;
+		color_blend.attachmentCount = 1;
+		color_blend.pAttachments = &color_attachment;
+
+		VkPipelineDepthStencilStateCreateInfo depth_stencil {};
+		depth_stencil.sType =
+			VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+		depth_stencil.depthTestEnable = VK_FALSE;
+		depth_stencil.depthWriteEnable = VK_FALSE;
+		depth_stencil.depthCompareOp = VK_COMPARE_OP_LESS;
+		depth_stencil.stencilTestEnable = VK_FALSE;
+
+		VkGraphicsPipelineCreateInfo create_info {};
+		create_info.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+		create_info.stageCount = 2;
+		create_info.pStages = stages_info;
+		create_info.pVertexInputState = &vert_input_info;
+		create_info.pInputAssemblyState = &input_assembly;
+		create_info.pViewportState = &viewport_state;
+		create_info.pRasterizationState = &rasterizer;
+		create_info.pMultisampleState = &msaa;
+		create_info.pColorBlendState = &color_blend;
+		create_info.pDepthStencilState = &depth_stencil;
+		create_info.pDynamicState = &dynamic_state_info;
+		create_info.layout = pipe_layout_;
+		create_info.renderPass = nullptr;
+		create_info.subpass = 0;
+
+		VkPipelineRenderingCreateInfo rendering_info {};
+		rendering_info.sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO;
+		rendering_info.colorAttachmentCount = 1;
+		// TODO use global hardcoded formats
+		VkFormat format = VK_FORMAT_B8G8R8A8_UNORM;
+		rendering_info.pColorAttachmentFormats = &format;
+		rendering_info.depthAttachmentFormat = VK_FORMAT_D32_SFLOAT;
+
+		create_info.pNext = &rendering_info;
+
+		res = vkCreateGraphicsPipelines(inst.get_device(), nullptr, 1, &create_info,
+		                                nullptr, &pipe_);
+		log::assert(res == VK_SUCCESS, "Failed to create graphics pipeline (%s)",
+		            string_VkResult(res));
+
+		vkDestroyShaderModule(inst.get_device(), shader, nullptr);
 	}
-} // namespace vkb::vk
\ No newline at end of file
+}
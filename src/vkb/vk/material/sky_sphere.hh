@@ -3,6 +3,7 @@
 #include <volk/volk.h>
 
 #include "../buffer.hh"
+#include "../image.hh"
 
 #include "../../math/vec4.hh"
 
@@ -18,6 +19,9 @@ namespace vkb
 
 namespace vkb::vk
 {
+	// Star field around the camera. Stars are baked once into a cubemap by a compute
+	// pass, the sky is then a single cubemap fetch per pixel on a fullscreen triangle,
+	// whatever the number of stars.
 	class sky_sphere
 	{
 	public:
@@ -34,27 +38,33 @@ namespace vkb::vk
 		void draw(VkCommandBuffer cmd, uint32_t const img_idx);
 
 	private:
+		constexpr static uint32_t star_count {4096};
+		constexpr static uint32_t face_size {1024};
+		// Group size of sky_bake.slang
+		constexpr static uint32_t bake_tile_size {8};
+
 		struct alignas(16) star
 		{
 			vec4  pos;
 			float intensity {0};
 		};
 
-		VkDescriptorSetLayout desc_set_layout_ {nullptr};
+		void bake_stars();
+		void create_pipeline();
+
+		VkDescriptorSetLayout dynamic_set_layout_ {nullptr};
+		VkDescriptorSetLayout static_set_layout_ {nullptr};
 
 		VkDescriptorPool desc_pool_ {nullptr};
-		VkDescriptorSet  desc_sets_[3] {nullptr};
-		buffer           staging_uniforms_[3];
-		buffer           uniforms_[3];
+		VkDescriptorSet  dynamic_sets_[3] {nullptr};
+		VkDescriptorSet  static_set_ {nullptr};
+		dynamic_buffer   uniforms_[3];
 
-		VkDescriptorSetLayout star_positions_layout_ {nullptr};
-		VkDescriptorSet       star_positions_set_ {nullptr};
-		buffer                star_positions_uniform_;
+		image       cubemap_;
+		VkImageView cubemap_view_ {nullptr};
+		VkSampler   sampler_ {nullptr};
 
 		VkPipelineLayout pipe_layout_ {nullptr};
 		VkPipeline       pipe_ {nullptr};
-
-		buffer vertices_;
-		buffer indices_;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,260 @@
+#include "staging_ring.hh"
+
+#include "../log.hh"
+#include "enum_string_helper.hh"
+#include "instance.hh"
+
+#include <string.h>
+
+namespace vkb::vk
+{
+	staging_ring::staging_ring(VkDeviceSize size)
+	: size_ {size}
+	, max_chunk_ {(size / 2) & ~(alignment - 1)}
+	{
+		log::assert(max_chunk_ > 0, "Staging ring too small (%llu bytes)",
+		            static_cast<unsigned long long>(size));
+
+		instance& inst = instance::get();
+		ring_ = inst.create_staging_buffer(size_);
+
+		mc::vector<VkCommandBuffer> cmds = inst.allocate_commands(max_batches);
+
+		VkFenceCreateInfo fence_info {};
+		fence_info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+		for (uint32_t i {0}; i < max_batches; ++i)
+		{
+			batches_[i].cmd = cmds[i];
+			VkResult res = vkCreateFence(inst.get_device(), &fence_info, nullptr,
+			                             &batches_[i].fence);
+			log::assert(res == VK_SUCCESS, "Failed to create staging fence (%s)",
+			            string_VkResult(res));
+		}
+	}
+
+	staging_ring::~staging_ring()
+	{
+		flush();
+
+		instance&       inst = instance::get();
+		VkCommandBuffer cmds[max_batches];
+		for (uint32_t i {0}; i < max_batches; ++i)
+		{
+			vkDestroyFence(inst.get_device(), batches_[i].fence, nullptr);
+			cmds[i] = batches_[i].cmd;
+		}
+		inst.free_commands(cmds);
+
+		inst.destroy_buffer(ring_);
+	}
+
+	VkCommandBuffer staging_ring::commands()
+	{
+		instance::get().assert_owner_thread();
+
+		if (!recording_)
+		{
+			// Reclaims the region of asynchronously submitted batches which completed
+			VkDevice device = instance::get().get_device();
+			while (in_flight_ &&
+			       vkGetFenceStatus(device, batches_[first_in_flight_].fence) ==
+			           VK_SUCCESS)
+				retire_oldest();
+
+			if (in_flight_ == max_batches)
+				retire_oldest();
+
+			VkCommandBufferBeginInfo begin {};
+			begin.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+			begin.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+			vkBeginCommandBuffer(
+				batches_[(first_in_flight_ + in_flight_) % max_batches].cmd, &begin);
+
+			recording_ = true;
+		}
+
+		return batches_[(first_in_flight_ + in_flight_) % max_batches].cmd;
+	}
+
+	void staging_ring::upload_buffer(buffer const& dst, VkDeviceSize dst_off,
+	                                 void const* data, VkDeviceSize size)
+	{
+		uint8_t const* src = static_cast<uint8_t const*>(data);
+		for (VkDeviceSize done {0}; done < size;)
+		{
+			VkDeviceSize chunk = size - done < max_chunk_ ? size - done : max_chunk_;
+			VkDeviceSize off = reserve(chunk);
+			memcpy(static_cast<uint8_t*>(ring_.mapped) + off, src + done, chunk);
+
+			VkBufferCopy2 region {};
+			region.sType = VK_STRUCTURE_TYPE_BUFFER_COPY_2;
+			region.srcOffset = off;
+			region.dstOffset = dst_off + done;
+			region.size = chunk;
+			VkCopyBufferInfo2 copy {};
+			copy.sType = VK_STRUCTURE_TYPE_COPY_BUFFER_INFO_2;
+			copy.srcBuffer = ring_.buffer;
+			copy.dstBuffer = dst.buffer;
+			copy.regionCount = 1;
+			copy.pRegions = &region;
+			vkCmdCopyBuffer2(commands(), &copy);
+
+			done += chunk;
+		}
+	}
+
+	void staging_ring::upload_image(image const& dst, uint32_t w, uint32_t h,
+	                                uint32_t texel_size, void const* data)
+	{
+		uint8_t const* src = static_cast<uint8_t const*>(data);
+		VkDeviceSize   row_size = static_cast<VkDeviceSize>(w) * texel_size;
+
+		// Whole rows are streamed when they fit in a chunk, otherwise rows are split
+		uint32_t span = row_size <= max_chunk_ ? w : max_chunk_ / texel_size;
+		uint32_t rows = row_size <= max_chunk_ ? max_chunk_ / row_size : 1;
+
+		for (uint32_t y {0}; y < h; y += rows)
+		{
+			uint32_t row_cnt = h - y < rows ? h - y : rows;
+			for (uint32_t x {0}; x < w; x += span)
+			{
+				uint32_t     texel_cnt = w - x < span ? w - x : span;
+				VkDeviceSize span_size =
+					static_cast<VkDeviceSize>(texel_cnt) * texel_size;
+				VkDeviceSize off = reserve(span_size * row_cnt);
+
+				uint8_t* ring_mem = static_cast<uint8_t*>(ring_.mapped) + off;
+				for (uint32_t r {0}; r < row_cnt; ++r)
+				{
+					memcpy(ring_mem + r * span_size,
+					       src + ((y + r) * row_size) + x * texel_size, span_size);
+				}
+
+				VkBufferImageCopy2 region {};
+				region.sType = VK_STRUCTURE_TYPE_BUFFER_IMAGE_COPY_2;
+				region.bufferOffset = off;
+				region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+				region.imageSubresource.layerCount = 1;
+				region.imageOffset = {static_cast<int32_t>(x), static_cast<int32_t>(y),
+				                      0};
+				region.imageExtent = {texel_cnt, row_cnt, 1};
+
+				VkCopyBufferToImageInfo2 info {};
+				info.sType = VK_STRUCTURE_TYPE_COPY_BUFFER_TO_IMAGE_INFO_2;
+				info.srcBuffer = ring_.buffer;
+				info.dstImage = dst.image;
+				info.dstImageLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+				info.regionCount = 1;
+				info.pRegions = &region;
+				vkCmdCopyBufferToImage2(commands(), &info);
+			}
+		}
+	}
+
+	void staging_ring::flush()
+	{
+		if (recording_)
+			submit();
+
+		while (in_flight_)
+			retire_oldest();
+
+		live_ = false;
+	}
+
+	uint64_t staging_ring::submit_async()
+	{
+		instance::get().assert_owner_thread();
+
+		if (recording_)
+			submit();
+
+		return submitted_value_;
+	}
+
+	VkDeviceSize staging_ring::reserve(VkDeviceSize size)
+	{
+		log::assert(size <= max_chunk_, "Staging chunk too big");
+
+		while (true)
+		{
+			if (!live_)
+				head_ = tail_ = 0;
+
+			VkDeviceSize off = (head_ + alignment - 1) & ~(alignment - 1);
+			if (!live_ || head_ > tail_)
+			{
+				// Free space is [head, end) and [0, tail)
+				if (off + size <= size_)
+				{
+					head_ = off + size;
+					live_ = true;
+					return off;
+				}
+				else if (size <= tail_)
+				{
+					head_ = size;
+					return 0;
+				}
+			}
+			else if (head_ < tail_ && off + size <= tail_)
+			{
+				head_ = off + size;
+				return off;
+			}
+
+			// Not enough space left, reuse the region of the oldest chunks
+			if (recording_)
+				submit();
+			retire_oldest();
+		}
+	}
+
+	void staging_ring::submit()
+	{
+		instance& inst = instance::get();
+		batch&    b = batches_[(first_in_flight_ + in_flight_) % max_batches];
+
+		vkEndCommandBuffer(b.cmd);
+
+		// Also signals the timeline, which uploads awaited asynchronously poll
+		submitted_value_ = inst.next_timeline_value();
+		VkSemaphore timeline = inst.get_timeline();
+
+		VkTimelineSemaphoreSubmitInfo timeline_info {};
+		timeline_info.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+		timeline_info.signalSemaphoreValueCount = 1;
+		timeline_info.pSignalSemaphoreValues = &submitted_value_;
+
+		VkSubmitInfo submit {};
+		submit.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		submit.pNext = &timeline_info;
+		submit.commandBufferCount = 1;
+		submit.pCommandBuffers = &b.cmd;
+		submit.signalSemaphoreCount = 1;
+		submit.pSignalSemaphores = &timeline;
+		vkQueueSubmit(inst.get_graphics_queue(), 1, &submit, b.fence);
+
+		b.end = head_;
+		++in_flight_;
+		recording_ = false;
+	}
+
+	void staging_ring::retire_oldest()
+	{
+		log::assert(in_flight_ > 0, "No staging batch to retire");
+
+		VkDevice device = instance::get().get_device();
+		batch&   b = batches_[first_in_flight_];
+
+		vkWaitForFences(device, 1, &b.fence, VK_TRUE, UINT64_MAX);
+		vkResetFences(device, 1, &b.fence);
+
+		tail_ = b.end;
+		first_in_flight_ = (first_in_flight_ + 1) % max_batches;
+		--in_flight_;
+
+		if (!in_flight_ && !recording_)
+			live_ = false;
+	}
+}
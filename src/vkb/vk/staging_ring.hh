@@ -0,0 +1,77 @@
+#pragma once
+
+#include "buffer.hh"
+#include "image.hh"
+
+#include "vma/vma.hh"
+#include <volk/volk.h>
+
+#include <stdint.h>
+
+namespace vkb::vk
+{
+	// Fixed size, persistently mapped staging buffer used as a ring for every upload.
+	// Data bigger than the ring is streamed in chunks: when no space is left, the
+	// pending copies are submitted and the oldest submitted chunks are waited on to
+	// reuse their region. Memory used by uploads is then bounded by the ring size, and
+	// no staging allocation happens after creation.
+	class staging_ring
+	{
+	public:
+		staging_ring(VkDeviceSize size);
+		staging_ring(staging_ring const&) = delete;
+		staging_ring(staging_ring&&) = delete;
+		~staging_ring();
+
+		staging_ring& operator=(staging_ring const&) = delete;
+		staging_ring& operator=(staging_ring&&) = delete;
+
+		// Command buffer recording the pending copies. Can be used to record commands
+		// which need to be ordered with uploads (layout transitions, mips generation).
+		// It may change after each upload, as full batches are submitted.
+		VkCommandBuffer commands();
+
+		void upload_buffer(buffer const& dst, VkDeviceSize dst_off, void const* data,
+		                   VkDeviceSize size);
+		// Uploads the first mip of dst, which must be in TRANSFER_DST_OPTIMAL layout.
+		void upload_image(image const& dst, uint32_t w, uint32_t h, uint32_t texel_size,
+		                  void const* data);
+
+		// Submits pending copies, and waits for all uploads to complete.
+		void     flush();
+		// Submits pending copies without waiting. Returns the instance timeline value
+		// signaled once all uploads submitted so far completed.
+		uint64_t submit_async();
+
+	private:
+		constexpr static uint32_t     max_batches {4};
+		constexpr static VkDeviceSize alignment {16};
+
+		struct batch
+		{
+			VkCommandBuffer cmd {nullptr};
+			VkFence         fence {nullptr};
+			// Ring position after the last chunk of the batch
+			VkDeviceSize end {0};
+		};
+
+		VkDeviceSize reserve(VkDeviceSize size);
+		void         submit();
+		void         retire_oldest();
+
+		buffer       ring_;
+		VkDeviceSize size_ {0};
+		VkDeviceSize max_chunk_ {0};
+
+		VkDeviceSize head_ {0};
+		VkDeviceSize tail_ {0};
+		bool         live_ {false};
+
+		batch    batches_[max_batches];
+		uint32_t first_in_flight_ {0};
+		uint32_t in_flight_ {0};
+		// Batch recording, always the one after the last in flight
+		bool     recording_ {false};
+		uint64_t submitted_value_ {0};
+	};
+}
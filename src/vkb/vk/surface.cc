@@ -87,11 +87,13 @@ namespace vkb::vk
 		create_info.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
 		create_info.presentMode = present_mode;
 		create_info.clipped = VK_TRUE;
-		create_info.oldSwapchain = nullptr;
+		create_info.oldSwapchain = swapchain_;
 
-		VkResult res =
+		VkSwapchainKHR old_swapchain = swapchain_;
+		VkResult       res =
 			vkCreateSwapchainKHR(inst.get_device(), &create_info, nullptr, &swapchain_);
 		log::assert(res == VK_SUCCESS, "Cannot create swapchain");
+		inst.get_deletion_queue().push(old_swapchain);
 
 		swapchain_format_ = format;
 		swapchain_extent_ = extent;
@@ -143,6 +145,24 @@ namespace vkb::vk
 
 		if (swapchain_)
 			vkDestroySwapchainKHR(inst.get_device(), swapchain_, nullptr);
+
+		depth_stencil_view_ = nullptr;
+		depth_stencil_ = {};
+		swapchain_image_views_.clear();
+		swapchain_ = nullptr;
+	}
+
+	void surface::recreate_swapchain()
+	{
+		deletion_queue& deletion = instance::get().get_deletion_queue();
+
+		deletion.push(depth_stencil_view_);
+		deletion.push(depth_stencil_);
+		for (uint32_t i {0}; i < swapchain_image_views_.size(); ++i)
+			deletion.push(swapchain_image_views_[i]);
+
+		// Current swapchain is retired by create_swapchain
+		create_swapchain();
 	}
 
 	surface::swapchain_support
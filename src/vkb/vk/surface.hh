@@ -39,6 +39,8 @@ namespace vkb::vk
 		bool need_swapchain_update();
 		void create_swapchain();
 		void destroy_swapchain();
+		// Old swapchain resources are released once the frames using them completed
+		void recreate_swapchain();
 
 		swapchain_support query_swapchain_support(VkPhysicalDevice device) const;
 		bool check_present_queue(VkPhysicalDevice device, uint32_t queue_idx) const;
@@ -64,7 +66,7 @@ namespace vkb::vk
 
 		VkSurfaceKHR surface_ {nullptr};
 
-		VkSwapchainKHR          swapchain_;
+		VkSwapchainKHR          swapchain_ {nullptr};
 		swapchain_support       swapchain_support_;
 		VkSurfaceFormatKHR      swapchain_format_;
 		VkExtent2D              swapchain_extent_;
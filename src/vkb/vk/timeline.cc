@@ -0,0 +1,17 @@
+#include "timeline.hh"
+
+#include "instance.hh"
+
+namespace vkb::vk
+{
+	timeline_wait::timeline_wait(uint64_t value)
+	: async::until {reached, &value_, async::render_loop()}
+	, value_ {value}
+	{}
+
+	bool timeline_wait::reached(void* data)
+	{
+		uint64_t const value = *static_cast<uint64_t*>(data);
+		return instance::get().get_completed_timeline_value() >= value;
+	}
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "../core/async.hh"
+
+#include <stdint.h>
+
+namespace vkb::vk
+{
+	// Suspends the awaiting coroutine until the GPU reached a value of the instance
+	// timeline, such as the one returned by staging_ring::submit_async. Resumes on the
+	// render thread, which owns the GPU objects.
+	class timeline_wait : public async::until
+	{
+	public:
+		timeline_wait(uint64_t value);
+		timeline_wait(timeline_wait const&) = delete;
+		timeline_wait(timeline_wait&&) = delete;
+
+		timeline_wait& operator=(timeline_wait const&) = delete;
+		timeline_wait& operator=(timeline_wait&&) = delete;
+
+	private:
+		static bool reached(void* data);
+
+		uint64_t value_ {0};
+	};
+}